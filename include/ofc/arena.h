@@ -0,0 +1,60 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_arena_h__
+#define __ofc_arena_h__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* A region allocator, memory is carved from large chunks and only released
+   in bulk by rewinding to an earlier position or deleting the arena. */
+typedef struct ofc_arena_s ofc_arena_t;
+
+ofc_arena_t* ofc_arena_create(void);
+void         ofc_arena_delete(ofc_arena_t* arena);
+
+void* ofc_arena_alloc(ofc_arena_t* arena, size_t size);
+
+/* Grows in place when ptr is the most recent allocation,
+   otherwise this allocates and copies. */
+void* ofc_arena_resize(
+	ofc_arena_t* arena, void* ptr,
+	size_t old_size, size_t size);
+
+size_t ofc_arena_position(const ofc_arena_t* arena);
+void   ofc_arena_rewind(ofc_arena_t* arena, size_t position);
+
+/* The cleanup is run when the arena is deleted, or when it's rewound
+   to a position before the point at which the cleanup was added. */
+bool ofc_arena_cleanup(
+	ofc_arena_t* arena,
+	void (*func)(void*), void* data);
+
+
+/* Blocks come from the arena when one is given and from malloc otherwise,
+   each is tagged so that one set of delete functions works on either.
+   Building with OFC_ARENA_MALLOC makes every block a heap block, so that
+   valgrind can track objects individually. */
+void* ofc_arena_block_alloc(ofc_arena_t* arena, size_t size);
+void* ofc_arena_block_realloc(
+	ofc_arena_t* arena, void* ptr, size_t size);
+void  ofc_arena_block_free(void* ptr);
+
+/* Arena owned blocks are released with their arena,
+   so deleting them is a no-op. */
+bool ofc_arena_block_owned(const void* ptr);
+
+#endif
@@ -0,0 +1,40 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_atom_h__
+#define __ofc_atom_h__
+
+#include <stdbool.h>
+
+/* Identifiers are interned as atoms so that they can be compared and
+   hashed without touching their characters. Each distinct spelling gets
+   an ID, and every spelling which differs only in case shares a folded
+   ID, so both case sensitive and insensitive lookups are integer compares.
+   Zero is never a valid atom. Interning and lookups are thread-safe. */
+typedef unsigned ofc_atom_t;
+
+#define OFC_ATOM_NONE 0
+
+ofc_atom_t ofc_atom(const char* base, unsigned size);
+
+/* These match ofc_str_ref_hash and ofc_str_ref_hash_ci on the spelling,
+   so atoms and plain references can share a hashmap. */
+unsigned ofc_atom_hash(ofc_atom_t atom);
+unsigned ofc_atom_hash_ci(ofc_atom_t atom);
+
+/* The atom of the upper case spelling. */
+ofc_atom_t ofc_atom_fold(ofc_atom_t atom);
+
+#endif
@@ -22,6 +22,10 @@ typedef struct ofc_colstr_s ofc_colstr_t;
 
 ofc_colstr_t* ofc_colstr_create(
 	unsigned cols, unsigned ext);
+/* Writes completed lines to fd as it goes,
+   ofc_colstr_fdprint writes whatever remains. */
+ofc_colstr_t* ofc_colstr_create_stream(
+	unsigned cols, unsigned ext, int fd);
 void ofc_colstr_delete(ofc_colstr_t* cstr);
 
 bool ofc_colstr_newline(
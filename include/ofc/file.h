@@ -17,6 +17,7 @@
 #define __ofc_file_h__
 
 #include <stdbool.h>
+#include <stdio.h>
 #include "lang_opts.h"
 
 typedef struct ofc_file_s ofc_file_t;
@@ -30,6 +31,7 @@ void        ofc_file_delete(ofc_file_t* file);
 const char*     ofc_file_get_path(const ofc_file_t* file);
 const char*     ofc_file_get_include(const ofc_file_t* file);
 const char*     ofc_file_get_strz(const ofc_file_t* file);
+unsigned        ofc_file_get_size(const ofc_file_t* file);
 ofc_lang_opts_t ofc_file_get_lang_opts(const ofc_file_t* file);
 
 char* ofc_file_include_path(
@@ -60,4 +62,12 @@ void ofc_file_warning_va(
 	const char* sol, const char* ptr,
 	const char* format, va_list args);
 
+/* The number of errors and warnings reported so far. */
+unsigned ofc_file_diagnostic_count(void);
+
+/* Diagnostics go to stderr unless redirected for the calling thread,
+   this sets the stream, NULL for stderr, and returns the previous one. */
+FILE* ofc_file_diagnostics_swap(FILE* stream);
+FILE* ofc_file_diagnostics(void);
+
 #endif
@@ -19,11 +19,14 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-typedef uint8_t     (*ofc_hashmap_hash_f       )(const void* key);
+typedef unsigned    (*ofc_hashmap_hash_f       )(const void* key);
 typedef bool        (*ofc_hashmap_key_compare_f)(const void* a, const void* b);
 typedef const void* (*ofc_hashmap_item_key_f   )(const void* item);
 typedef void        (*ofc_hashmap_item_delete_f)(void* item);
 
+/* Open addressing hash table with linear probing, items are stored inline
+   alongside their full-width hash and the table doubles in size whenever
+   the load factor would exceed 3/4. */
 typedef struct ofc_hashmap_s ofc_hashmap_t;
 
 ofc_hashmap_t* ofc_hashmap_create(
@@ -33,6 +36,8 @@ ofc_hashmap_t* ofc_hashmap_create(
 	ofc_hashmap_item_delete_f item_delete);
 void ofc_hashmap_delete(ofc_hashmap_t* map);
 
+/* Items with equal keys may be added, the latest one added is the one
+   found and the rest stay in the map until it's deleted. */
 bool ofc_hashmap_add(ofc_hashmap_t* map, void* item);
 
 const void* ofc_hashmap_find(const ofc_hashmap_t* map, const void* key);
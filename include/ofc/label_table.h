@@ -17,6 +17,7 @@
 #define __ofc_label_table_h__
 
 #include <stdbool.h>
+#include <ofc/serial.h>
 
 typedef struct ofc_label_table_s ofc_label_table_t;
 
@@ -28,4 +29,10 @@ bool ofc_label_table_add(
 bool ofc_label_table_find(
 	const ofc_label_table_t* table, unsigned offset, unsigned* number);
 
+bool ofc_label_table_serialize(
+	ofc_serial_t* serial, const ofc_label_table_t* table);
+/* Adds the labels that were written to table. */
+bool ofc_label_table_deserialize(
+	ofc_serial_t* serial, ofc_label_table_t* table);
+
 #endif
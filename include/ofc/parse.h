@@ -17,12 +17,15 @@
 #define __ofc_parse_h__
 
 #include <ofc/sparse.h>
+#include <ofc/serial.h>
 #include <ofc/str_ref.h>
 #include <ofc/fctype.h>
 
 #include <stdio.h>
 
 #include <ofc/parse/debug.h>
+#include <ofc/parse/arena.h>
+#include <ofc/parse/memo.h>
 
 typedef struct ofc_parse_lhs_s ofc_parse_lhs_t;
 typedef struct ofc_parse_expr_s ofc_parse_expr_t;
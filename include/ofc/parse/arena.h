@@ -0,0 +1,54 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_parse_arena_h__
+#define __ofc_parse_arena_h__
+
+#include <ofc/arena.h>
+#include <ofc/string.h>
+#include <ofc/serial.h>
+
+/* While a sparse is being parsed every parse node is allocated from that
+   parse's arena, which is owned by the root statement list and released
+   with it. Nodes allocated with no arena active (e.g. copies made by sema)
+   come from malloc, so the delete functions work on either. */
+
+/* Makes arena the current parse arena, returning the previous one. */
+ofc_arena_t* ofc_parse_arena_swap(ofc_arena_t* arena);
+
+/* These mirror ofc_parse_debug_position/rewind, anything allocated
+   from the current arena after the position is released by rewind. */
+size_t ofc_parse_arena_position(void);
+void   ofc_parse_arena_rewind(size_t position);
+
+/* Runs func on data when the current arena is rewound or deleted. */
+bool ofc_parse_arena_cleanup(void (*func)(void*), void* data);
+
+void* ofc_parse_alloc(size_t size);
+void* ofc_parse_realloc(void* ptr, size_t size);
+void  ofc_parse_free(void* ptr);
+
+/* Arena owned nodes are released with their arena,
+   so deleting them is a no-op. */
+bool ofc_parse_arena_owned(const void* ptr);
+
+ofc_string_t* ofc_parse_string_create(const char* base, unsigned size);
+ofc_string_t* ofc_parse_string_copy(const ofc_string_t* src);
+void          ofc_parse_string_delete(ofc_string_t* string);
+
+bool ofc_parse_string_deserialize(
+	ofc_serial_t* serial, ofc_string_t** string);
+
+#endif
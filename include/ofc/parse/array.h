@@ -48,5 +48,10 @@ bool ofc_parse_array_index_print(
 	ofc_colstr_t* cs, const ofc_parse_array_index_t* index,
 	bool is_decl);
 
+bool ofc_parse_array_index_serialize(
+	ofc_serial_t* serial, const ofc_parse_array_index_t* index);
+bool ofc_parse_array_index_deserialize(
+	ofc_serial_t* serial, ofc_parse_array_index_t** index);
+
 
 #endif
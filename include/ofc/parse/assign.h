@@ -50,6 +50,11 @@ void ofc_parse_assign_delete(
 bool ofc_parse_assign_print(
 	ofc_colstr_t* cs, const ofc_parse_assign_t* assign);
 
+bool ofc_parse_assign_serialize(
+	ofc_serial_t* serial, const ofc_parse_assign_t* assign);
+bool ofc_parse_assign_deserialize(
+	ofc_serial_t* serial, ofc_parse_assign_t** assign);
+
 
 ofc_parse_assign_list_t* ofc_parse_assign_list(
 	const ofc_sparse_t* src, const char* ptr,
@@ -65,5 +70,10 @@ void ofc_parse_assign_list_delete(
 bool ofc_parse_assign_list_print(
 ofc_colstr_t* cs, const ofc_parse_assign_list_t* list);
 
+bool ofc_parse_assign_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_assign_list_t* list);
+bool ofc_parse_assign_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_assign_list_t** list);
+
 
 #endif
@@ -56,6 +56,11 @@ void ofc_parse_call_arg_delete(
 bool ofc_parse_call_arg_print(
 	ofc_colstr_t* cs, const ofc_parse_call_arg_t* call_arg);
 
+bool ofc_parse_call_arg_serialize(
+	ofc_serial_t* serial, const ofc_parse_call_arg_t* call_arg);
+bool ofc_parse_call_arg_deserialize(
+	ofc_serial_t* serial, ofc_parse_call_arg_t** call_arg);
+
 ofc_parse_call_arg_list_t* ofc_parse_call_arg_list_force_named(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -75,4 +80,9 @@ void ofc_parse_call_arg_list_delete(
 bool ofc_parse_call_arg_list_print(
 	ofc_colstr_t* cs, const ofc_parse_call_arg_list_t* call_arg);
 
+bool ofc_parse_call_arg_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_call_arg_list_t* list);
+bool ofc_parse_call_arg_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_call_arg_list_t** list);
+
 #endif
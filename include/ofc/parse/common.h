@@ -37,6 +37,11 @@ void ofc_parse_common_group_delete(
 bool ofc_parse_common_group_print(
 	ofc_colstr_t* cs, const ofc_parse_common_group_t* group);
 
+bool ofc_parse_common_group_serialize(
+	ofc_serial_t* serial, const ofc_parse_common_group_t* group);
+bool ofc_parse_common_group_deserialize(
+	ofc_serial_t* serial, ofc_parse_common_group_t** group);
+
 ofc_parse_common_group_list_t* ofc_parse_common_group_list(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -46,4 +51,9 @@ void ofc_parse_common_group_list_delete(
 bool ofc_parse_common_group_list_print(
 	ofc_colstr_t* cs, const ofc_parse_common_group_list_t* list);
 
+bool ofc_parse_common_group_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_common_group_list_t* list);
+bool ofc_parse_common_group_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_common_group_list_t** list);
+
 #endif
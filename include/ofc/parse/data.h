@@ -49,6 +49,11 @@ void ofc_parse_clist_delete(
 bool ofc_parse_clist_print(
 	ofc_colstr_t* cs, const ofc_parse_clist_t* list);
 
+bool ofc_parse_clist_serialize(
+	ofc_serial_t* serial, const ofc_parse_clist_t* list);
+bool ofc_parse_clist_deserialize(
+	ofc_serial_t* serial, ofc_parse_clist_t** list);
+
 ofc_parse_data_list_t* ofc_parse_data_list(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -58,4 +63,9 @@ void ofc_parse_data_list_delete(
 bool ofc_parse_data_list_print(
 	ofc_colstr_t* cs, const ofc_parse_data_list_t* list);
 
+bool ofc_parse_data_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_data_list_t* list);
+bool ofc_parse_data_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_data_list_t** list);
+
 #endif
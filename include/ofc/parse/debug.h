@@ -30,6 +30,10 @@ void ofc_parse_debug_print(const ofc_parse_debug_t* stack);
 
 #include <stdarg.h>
 
+/* Messages are only formatted when printed, so the format and every
+   pointer argument (%s or %p) must outlive the stack, pass a copy
+   if the string may be freed or rewritten first. A format with a
+   conversion that can't be captured is printed as is. */
 void ofc_parse_debug_warning(
 	ofc_parse_debug_t* stack,
 	ofc_sparse_ref_t ref,
@@ -40,6 +40,11 @@ void ofc_parse_decl_delete(
 bool ofc_parse_decl_print(
 	ofc_colstr_t* cs, const ofc_parse_decl_t* decl);
 
+bool ofc_parse_decl_serialize(
+	ofc_serial_t* serial, const ofc_parse_decl_t* decl);
+bool ofc_parse_decl_deserialize(
+	ofc_serial_t* serial, ofc_parse_decl_t** decl);
+
 ofc_parse_decl_list_t* ofc_parse_decl_list(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -49,4 +54,9 @@ void ofc_parse_decl_list_delete(
 bool ofc_parse_decl_list_print(
 	ofc_colstr_t* cs, const ofc_parse_decl_list_t* list);
 
+bool ofc_parse_decl_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_decl_list_t* list);
+bool ofc_parse_decl_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_decl_list_t** list);
+
 #endif
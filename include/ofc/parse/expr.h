@@ -28,6 +28,9 @@ typedef enum
 
 typedef struct ofc_parse_expr_list_s ofc_parse_expr_list_t;
 
+/* WARNING: Nodes are only allocated as large as the union member their
+   type uses. Never copy an allocated node by value or read a member
+   other than the one its type uses, use ofc_parse_expr_copy instead. */
 struct ofc_parse_expr_s
 {
 	ofc_parse_expr_e type;
@@ -92,6 +95,11 @@ ofc_parse_expr_t* ofc_parse_expr_copy(
 bool ofc_parse_expr_print(
 	ofc_colstr_t* cs, const ofc_parse_expr_t* expr);
 
+bool ofc_parse_expr_serialize(
+	ofc_serial_t* serial, const ofc_parse_expr_t* expr);
+bool ofc_parse_expr_deserialize(
+	ofc_serial_t* serial, ofc_parse_expr_t** expr);
+
 ofc_parse_expr_list_t* ofc_parse_expr_list(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -102,4 +110,9 @@ void ofc_parse_expr_list_delete(
 bool ofc_parse_expr_list_print(
 	ofc_colstr_t* cs, const ofc_parse_expr_list_t* expr);
 
+bool ofc_parse_expr_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_expr_list_t* list);
+bool ofc_parse_expr_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_expr_list_t** list);
+
 #endif
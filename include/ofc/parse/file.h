@@ -18,8 +18,46 @@
 
 #include <ofc/parse.h>
 
+/* Large files may have their program units parsed on a pool of threads,
+   see ofc_parse_file_threads, diagnostics are still reported in the
+   order of a serial parse. */
 ofc_parse_stmt_list_t* ofc_parse_file(const ofc_sparse_t* src);
 
+/* Sets how many threads ofc_parse_file uses, this defaults to 1,
+   0 means one per processor. */
+void ofc_parse_file_threads(unsigned threads);
+
+/* Parses only the statement at index in the statement index of src,
+   see ofc_sparse_stmt, a block statement takes its body with it.
+   The returned list holds that statement and *count is set to the
+   number of indexed statements it covers. */
+ofc_parse_stmt_list_t* ofc_parse_file_stmt(
+	const ofc_sparse_t* src, unsigned index, unsigned* count);
+
+/* Preps and parses an included file, the result is shared by every
+   include of the same file with the same options until it changes.
+   *file is set to NULL if the file can't be opened, otherwise the
+   caller holds a reference to it, as well as to *src and the returned
+   list on success. */
+ofc_parse_stmt_list_t* ofc_parse_file_include(
+	const char* path, ofc_lang_opts_t opts, const char* include,
+	ofc_file_t** file, ofc_sparse_t** src);
+
+/* Releases the cache's references to included files. */
+void ofc_parse_file_include_cache_clear(void);
+
+/* Loads a tree stored for the same source, path and options from the
+   cache directory dir. On a miss NULL is returned and the file should
+   be prepped and parsed as usual, otherwise *src is set to the condensed
+   source the tree refers to, which the caller must delete. */
+ofc_parse_stmt_list_t* ofc_parse_file_cache_load(
+	const char* dir, ofc_file_t* file, ofc_sparse_t** src);
+
+/* Stores a tree parsed from file, creating dir if it doesn't exist. */
+bool ofc_parse_file_cache_store(
+	const char* dir, const ofc_file_t* file,
+	const ofc_sparse_t* src, const ofc_parse_stmt_list_t* list);
+
 bool ofc_parse_file_print(
 	ofc_colstr_t* cs,
 	const ofc_parse_stmt_list_t* list);
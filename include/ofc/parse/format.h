@@ -88,6 +88,11 @@ void ofc_parse_format_desc_delete(
 bool ofc_parse_format_desc_print(
 	ofc_colstr_t* cs, const ofc_parse_format_desc_t* desc);
 
+bool ofc_parse_format_desc_serialize(
+	ofc_serial_t* serial, const ofc_parse_format_desc_t* desc);
+bool ofc_parse_format_desc_deserialize(
+	ofc_serial_t* serial, ofc_parse_format_desc_t** desc);
+
 bool ofc_parse_format_is_data_desc(
 	ofc_parse_format_desc_t* desc);
 
@@ -100,6 +105,11 @@ void ofc_parse_format_desc_list_delete(
 bool ofc_parse_format_desc_list_print(
 	ofc_colstr_t* cs, const ofc_parse_format_desc_list_t* list);
 
+bool ofc_parse_format_desc_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_format_desc_list_t* list);
+bool ofc_parse_format_desc_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_format_desc_list_t** list);
+
 ofc_parse_format_desc_t* ofc_parse_format_desc_copy(
 	const ofc_parse_format_desc_t* desc);
 ofc_parse_format_desc_list_t* ofc_parse_format_desc_list_copy(
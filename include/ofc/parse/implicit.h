@@ -38,6 +38,11 @@ void ofc_parse_implicit_delete(
 bool ofc_parse_implicit_print(
 	ofc_colstr_t* cs, const ofc_parse_implicit_t* implicit);
 
+bool ofc_parse_implicit_serialize(
+	ofc_serial_t* serial, const ofc_parse_implicit_t* implicit);
+bool ofc_parse_implicit_deserialize(
+	ofc_serial_t* serial, ofc_parse_implicit_t** implicit);
+
 ofc_parse_implicit_list_t* ofc_parse_implicit_list(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -47,4 +52,9 @@ void ofc_parse_implicit_list_delete(
 bool ofc_parse_implicit_list_print(
 	ofc_colstr_t* cs, const ofc_parse_implicit_list_t* list);
 
+bool ofc_parse_implicit_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_implicit_list_t* list);
+bool ofc_parse_implicit_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_implicit_list_t** list);
+
 #endif
@@ -41,4 +41,9 @@ void ofc_parse_implicit_do_delete(
 bool ofc_parse_implicit_do_print(
 	ofc_colstr_t* cs, const ofc_parse_implicit_do_t* id);
 
+bool ofc_parse_implicit_do_serialize(
+	ofc_serial_t* serial, const ofc_parse_implicit_do_t* id);
+bool ofc_parse_implicit_do_deserialize(
+	ofc_serial_t* serial, ofc_parse_implicit_do_t** id);
+
 #endif
@@ -122,6 +122,12 @@ ofc_str_ref_t* ofc_parse_name_alloc(
 const char* ofc_parse_keyword_name(
 	ofc_parse_keyword_e keyword);
 
+/* Finds every keyword which ptr starts with in a single scan, shortest
+   first, storing up to max of them and returning how many there are. */
+unsigned ofc_parse_keyword_match(
+	const char* ptr,
+	ofc_parse_keyword_e* keyword, unsigned max);
+
 unsigned ofc_parse_keyword(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -96,6 +96,11 @@ bool ofc_parse_lhs_print(
 	ofc_colstr_t* cs, const ofc_parse_lhs_t* lhs,
 	bool is_decl);
 
+bool ofc_parse_lhs_serialize(
+	ofc_serial_t* serial, const ofc_parse_lhs_t* lhs);
+bool ofc_parse_lhs_deserialize(
+	ofc_serial_t* serial, ofc_parse_lhs_t** lhs);
+
 bool ofc_parse_lhs_base_name(
 	const ofc_parse_lhs_t lhs,
 	ofc_str_ref_t* name);
@@ -120,4 +125,9 @@ bool ofc_parse_lhs_list_bracketed_print(
 	ofc_colstr_t* cs, const ofc_parse_lhs_list_t* list,
 	bool is_decl);
 
+bool ofc_parse_lhs_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_lhs_list_t* list);
+bool ofc_parse_lhs_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_lhs_list_t** list);
+
 #endif
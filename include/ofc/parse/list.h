@@ -47,4 +47,14 @@ bool ofc_parse_list_print(
 	unsigned elem_count, const void** elem,
 	bool (*elem_print)(ofc_colstr_t*, const void*));
 
+bool ofc_parse_list_serialize(
+	ofc_serial_t* serial,
+	unsigned elem_count, const void** elem,
+	bool (*elem_serialize)(ofc_serial_t*, const void*));
+bool ofc_parse_list_deserialize(
+	ofc_serial_t* serial,
+	unsigned* elem_count, void*** elem,
+	bool (*elem_deserialize)(ofc_serial_t*, void**),
+	void (*elem_delete)(void*));
+
 #endif
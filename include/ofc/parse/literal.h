@@ -86,6 +86,11 @@ bool ofc_parse_literal_clone(
 bool ofc_parse_literal_print(
 	ofc_colstr_t* cs, const ofc_parse_literal_t literal);
 
+bool ofc_parse_literal_serialize(
+	ofc_serial_t* serial, const ofc_parse_literal_t* literal);
+bool ofc_parse_literal_deserialize(
+	ofc_serial_t* serial, ofc_parse_literal_t* literal);
+
 unsigned ofc_parse_unsigned(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -0,0 +1,68 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_parse_memo_h__
+#define __ofc_parse_memo_h__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Statement parsers often retry the same sub-parser at the same position,
+   so results are remembered by kind and position and handed out again.
+   Only arena owned nodes that raised no debug messages are kept, they're
+   never modified once parsed so they're shared rather than copied.
+   Entries are dropped when the arena is rewound past them, so the memo
+   must be swapped along with the parse arena. */
+
+typedef enum
+{
+	OFC_PARSE_MEMO_EXPR = 0,
+	OFC_PARSE_MEMO_EXPR_INTEGER,
+	OFC_PARSE_MEMO_EXPR_INTEGER_VARIABLE,
+	OFC_PARSE_MEMO_LHS,
+	OFC_PARSE_MEMO_LHS_VARIABLE,
+	OFC_PARSE_MEMO_LHS_STAR_LEN,
+	OFC_PARSE_MEMO_ARRAY_INDEX,
+
+	OFC_PARSE_MEMO_COUNT
+} ofc_parse_memo_e;
+
+typedef struct ofc_parse_memo_s ofc_parse_memo_t;
+
+ofc_parse_memo_t* ofc_parse_memo_create(void);
+void ofc_parse_memo_delete(ofc_parse_memo_t* memo);
+
+/* Makes memo the current memo, returning the previous one.
+   Nothing is remembered while there's no current memo. */
+ofc_parse_memo_t* ofc_parse_memo_swap(ofc_parse_memo_t* memo);
+
+/* Scopes entries to a statement, everything added
+   after the position is forgotten by rewind. */
+unsigned ofc_parse_memo_position(void);
+void     ofc_parse_memo_rewind(unsigned position);
+
+/* Forgets anything which references arena memory after position. */
+void ofc_parse_memo_release(size_t position);
+
+/* Returns true if kind was already parsed at ptr, node is NULL
+   if that parse failed. */
+bool ofc_parse_memo_find(
+	ofc_parse_memo_e kind, const char* ptr,
+	void** node, unsigned* len);
+void ofc_parse_memo_add(
+	ofc_parse_memo_e kind, const char* ptr,
+	void* node, unsigned len);
+
+#endif
@@ -37,4 +37,9 @@ void ofc_parse_pointer_list_delete(
 bool ofc_parse_pointer_list_print(
 	ofc_colstr_t* cs, const ofc_parse_pointer_list_t* list);
 
+bool ofc_parse_pointer_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_pointer_list_t* list);
+bool ofc_parse_pointer_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_pointer_list_t** list);
+
 #endif
@@ -42,6 +42,11 @@ void ofc_parse_save_delete(
 bool ofc_parse_save_print(
 	ofc_colstr_t* cs, const ofc_parse_save_t* save);
 
+bool ofc_parse_save_serialize(
+	ofc_serial_t* serial, const ofc_parse_save_t* save);
+bool ofc_parse_save_deserialize(
+	ofc_serial_t* serial, ofc_parse_save_t** save);
+
 ofc_parse_save_list_t* ofc_parse_save_list(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -51,4 +56,9 @@ void ofc_parse_save_list_delete(
 bool ofc_parse_save_list_print(
 	ofc_colstr_t* cs, const ofc_parse_save_list_t* list);
 
+bool ofc_parse_save_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_save_list_t* list);
+bool ofc_parse_save_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_save_list_t** list);
+
 #endif
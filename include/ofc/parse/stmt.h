@@ -21,6 +21,11 @@ typedef struct
 {
 	unsigned           count;
 	ofc_parse_stmt_t** stmt;
+
+	/* Only set on the root list of a parse, which owns the whole tree
+	   and can be shared by taking a reference. */
+	ofc_arena_t*       arena;
+	unsigned           ref;
 } ofc_parse_stmt_list_t;
 
 typedef enum
@@ -90,6 +95,9 @@ typedef enum
 	OFC_PARSE_STMT_ASSIGN,
 } ofc_parse_stmt_e;
 
+/* WARNING: Common statements are allocated without the unused tail of
+   the union. Always access them through a pointer, never copy one by
+   value or read a member other than the one its type uses. */
 struct ofc_parse_stmt_s
 {
 	ofc_parse_stmt_e type;
@@ -275,11 +283,21 @@ bool ofc_parse_stmt_print(
 	ofc_colstr_t* cs, unsigned indent,
 	const ofc_parse_stmt_t* stmt);
 
+/* Included files are written along with their sources,
+   so a tree can be rebuilt without prepping or parsing them again. */
+bool ofc_parse_stmt_serialize(
+	ofc_serial_t* serial, const ofc_parse_stmt_t* stmt);
+bool ofc_parse_stmt_deserialize(
+	ofc_serial_t* serial, ofc_parse_stmt_t** stmt);
+
 ofc_parse_stmt_list_t* ofc_parse_stmt_list(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
 	unsigned* len);
 
+/* Only a root list can be referenced. */
+bool ofc_parse_stmt_list_reference(
+	ofc_parse_stmt_list_t* list);
 void ofc_parse_stmt_list_delete(
 	ofc_parse_stmt_list_t* list);
 
@@ -290,4 +308,9 @@ bool ofc_parse_stmt_list_print(
 bool ofc_parse_stmt_list_contains_error(
 	const ofc_parse_stmt_list_t* list);
 
+bool ofc_parse_stmt_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_stmt_list_t* list);
+bool ofc_parse_stmt_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_stmt_list_t** list);
+
 #endif
@@ -68,4 +68,9 @@ bool ofc_parse_type_print(
 bool ofc_parse_type_print_f77(
 	ofc_colstr_t* cs, const ofc_parse_type_t* type);
 
+bool ofc_parse_type_serialize(
+	ofc_serial_t* serial, const ofc_parse_type_t* type);
+bool ofc_parse_type_deserialize(
+	ofc_serial_t* serial, ofc_parse_type_t** type);
+
 #endif
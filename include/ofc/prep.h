@@ -19,8 +19,38 @@
 #include "file.h"
 #include "sparse.h"
 
-ofc_sparse_t* ofc_prep_unformat(ofc_file_t* file);
+/* Runs of non-whitespace as offsets into unformatted text, runs which
+   touch are merged so that each maps to a single condensed entry. */
+typedef struct
+{
+	unsigned off, len;
+} ofc_prep_run_t;
+
+typedef struct
+{
+	unsigned        count, max;
+	ofc_prep_run_t* run;
+} ofc_prep_runs_t;
+
+void ofc_prep_runs_init(ofc_prep_runs_t* runs, unsigned hint);
+void ofc_prep_runs_cleanup(ofc_prep_runs_t* runs);
+bool ofc_prep_runs_scan(ofc_prep_runs_t* runs,
+	const char* src, unsigned len, unsigned off);
+
+/* If runs is non-NULL, the runs of the unformatted text are collected
+   as it is built, so that condensing needs no second scan. */
+ofc_sparse_t* ofc_prep_unformat(
+	ofc_file_t* file, ofc_prep_runs_t* runs);
+
+/* Whether a condensed statement ends a program unit, spaces are skipped.
+   Anything unusual is treated as not an END, so it's only a guess for
+   where to split a file into program units. */
+bool ofc_prep_unit_end(const char* src, unsigned len);
+
 ofc_sparse_t* ofc_prep_condense(ofc_sparse_t* unformat);
+ofc_sparse_t* ofc_prep_condense_runs(
+	ofc_sparse_t* unformat, const ofc_prep_runs_t* runs);
+
 ofc_sparse_t* ofc_prep(ofc_file_t* file);
 
 #endif
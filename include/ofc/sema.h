@@ -18,6 +18,7 @@
 
 #include <ofc/parse.h>
 #include <ofc/hashmap.h>
+#include <ofc/sema/arena.h>
 
 typedef struct ofc_sema_stmt_s      ofc_sema_stmt_t;
 typedef struct ofc_sema_stmt_list_s ofc_sema_stmt_list_t;
@@ -0,0 +1,40 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_sema_arena_h__
+#define __ofc_sema_arena_h__
+
+#include <ofc/arena.h>
+
+/* Every object built while analysing a scope tree is allocated from the
+   arena owned by its global scope, so deleting the tree is a single arena
+   delete and deleting anything within it is a no-op. Types and intrinsics
+   are shared between trees and stay on the heap. */
+
+/* Makes arena the current sema arena, returning the previous one. */
+ofc_arena_t* ofc_sema_arena_swap(ofc_arena_t* arena);
+
+void* ofc_sema_alloc(size_t size);
+void* ofc_sema_realloc(void* ptr, size_t size);
+void  ofc_sema_free(void* ptr);
+
+bool ofc_sema_arena_owned(const void* ptr);
+
+/* Hashmaps live on the heap, so one held by an arena owned object
+   is deleted along with the arena instead of its owner. */
+bool ofc_sema_arena_hashmap(
+	const void* owner, ofc_hashmap_t* map);
+
+#endif
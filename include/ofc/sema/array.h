@@ -38,7 +38,7 @@ ofc_sema_array_t* ofc_sema_array_copy(
 
 void ofc_sema_array_delete(ofc_sema_array_t* array);
 
-uint8_t ofc_sema_array_hash(
+unsigned ofc_sema_array_hash(
 	const ofc_sema_array_t* array);
 bool ofc_sema_array_compare(
 	const ofc_sema_array_t* a,
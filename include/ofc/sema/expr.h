@@ -59,6 +59,9 @@ struct ofc_sema_expr_s
 
 	union
 	{
+		/* Set for a constant taken straight from a literal. */
+		const ofc_parse_literal_t* literal;
+
 		ofc_sema_lhs_t* lhs;
 
 		struct
@@ -106,6 +109,10 @@ ofc_sema_expr_t* ofc_sema_expr_cast(
 	const ofc_sema_scope_t* scope,
 	ofc_sema_expr_t* expr,
 	const ofc_sema_type_t* type);
+ofc_sema_typeval_t* ofc_sema_expr_cast_constant(
+	const ofc_sema_scope_t* scope,
+	const ofc_sema_expr_t* expr,
+	const ofc_sema_type_t* type);
 ofc_sema_expr_t* ofc_sema_expr_alt_return(
 	ofc_sema_expr_t* expr);
 void ofc_sema_expr_delete(
@@ -115,7 +122,7 @@ bool ofc_sema_expr_compare(
 	const ofc_sema_expr_t* a,
 	const ofc_sema_expr_t* b);
 
-uint8_t ofc_sema_expr_hash(
+unsigned ofc_sema_expr_hash(
 	const ofc_sema_expr_t* expr);
 
 const ofc_sema_type_t* ofc_sema_expr_type(
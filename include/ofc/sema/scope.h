@@ -42,6 +42,9 @@ struct ofc_sema_scope_s
 	ofc_sema_scope_t* parent;
 	ofc_sema_scope_list_t*    child;
 
+	/* Only set on the global scope, which owns the whole tree. */
+	ofc_arena_t* arena;
+
 	const ofc_lang_opts_t* lang_opts;
 
 	const ofc_sparse_t* src;
@@ -40,7 +40,7 @@ bool ofc_sema_structure_append(
 
 void ofc_sema_structure_delete(ofc_sema_structure_t* structure);
 
-uint8_t ofc_sema_structure_hash(
+unsigned ofc_sema_structure_hash(
 	const ofc_sema_structure_t* structure);
 
 bool ofc_sema_structure_compare(
@@ -86,7 +86,7 @@ const ofc_sema_type_t* ofc_sema_type_complex_default(void);
 const ofc_sema_type_t* ofc_sema_type_byte_default(void);
 const ofc_sema_type_t* ofc_sema_type_subroutine(void);
 
-uint8_t ofc_sema_type_hash(
+unsigned ofc_sema_type_hash(
 	const ofc_sema_type_t* type);
 
 bool ofc_sema_type_compare(
@@ -0,0 +1,78 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ofc_serial_h__
+#define __ofc_serial_h__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <ofc/str_ref.h>
+#include <ofc/string.h>
+#include <ofc/lang_opts.h>
+
+/* A compact binary encoding, integers are variable length and string
+   references are stored as offsets into the sparse they point into,
+   so data can only be read back against an identical sparse. */
+typedef struct ofc_serial_s ofc_serial_t;
+
+typedef struct ofc_sparse_s ofc_sparse_t;
+
+ofc_serial_t* ofc_serial_create(void);
+/* The data must outlive the serial. */
+ofc_serial_t* ofc_serial_create_read(const void* data, size_t size);
+void ofc_serial_delete(ofc_serial_t* serial);
+
+/* Returns everything written so far, which is owned by serial. */
+const void* ofc_serial_data(const ofc_serial_t* serial, size_t* size);
+/* Whether everything has been read. */
+bool ofc_serial_end(const ofc_serial_t* serial);
+
+/* String references are relative to the current sparse,
+   this sets it and returns the previous one. */
+const ofc_sparse_t* ofc_serial_sparse_swap(
+	ofc_serial_t* serial, const ofc_sparse_t* sparse);
+const ofc_sparse_t* ofc_serial_sparse(const ofc_serial_t* serial);
+
+/* Objects that are shared by more than one node are written once,
+   these return their index or add them to the table. */
+bool ofc_serial_object_find(
+	const ofc_serial_t* serial, const void* object, unsigned* index);
+bool ofc_serial_object_add(ofc_serial_t* serial, void* object);
+void* ofc_serial_object(const ofc_serial_t* serial, unsigned index);
+
+bool ofc_serial_write_uint(ofc_serial_t* serial, uintmax_t value);
+bool ofc_serial_write_bool(ofc_serial_t* serial, bool value);
+bool ofc_serial_write_data(
+	ofc_serial_t* serial, const void* data, size_t size);
+bool ofc_serial_write_str_ref(ofc_serial_t* serial, ofc_str_ref_t ref);
+bool ofc_serial_write_string(
+	ofc_serial_t* serial, const ofc_string_t* string);
+bool ofc_serial_write_lang_opts(
+	ofc_serial_t* serial, ofc_lang_opts_t opts);
+
+bool ofc_serial_read_uint(ofc_serial_t* serial, uintmax_t* value);
+bool ofc_serial_read_unsigned(ofc_serial_t* serial, unsigned* value);
+bool ofc_serial_read_bool(ofc_serial_t* serial, bool* value);
+const void* ofc_serial_read_data(ofc_serial_t* serial, size_t size);
+bool ofc_serial_read_str_ref(ofc_serial_t* serial, ofc_str_ref_t* ref);
+bool ofc_serial_read_lang_opts(
+	ofc_serial_t* serial, ofc_lang_opts_t* opts);
+
+/* The string data is returned in place, *base is NULL for a NULL string. */
+bool ofc_serial_read_string(
+	ofc_serial_t* serial, const char** base, unsigned* size);
+
+#endif
@@ -31,6 +31,9 @@ unsigned ofc_sparse_len(const ofc_sparse_t* sparse);
 
 bool ofc_sparse_append_strn(ofc_sparse_t* sparse, const char* src, unsigned len);
 
+/* Makes room for count entries, so that appends don't reallocate. */
+bool ofc_sparse_reserve(ofc_sparse_t* sparse, unsigned count);
+
 /* No modifications are allowed after this call. */
 void ofc_sparse_lock(ofc_sparse_t* sparse);
 
@@ -42,8 +45,27 @@ bool ofc_sparse_label_add(
 bool ofc_sparse_label_find(
 	const ofc_sparse_t* sparse, const char* ptr, unsigned* number);
 
+/* Prep marks the offset at which each statement starts in the root,
+   offsets must not decrease. Once locked, every sparse has an index of
+   the non-empty statements in it, giving the offset and length of each
+   without its terminator. */
+bool ofc_sparse_stmt_add(
+	ofc_sparse_t* sparse, unsigned offset);
+unsigned ofc_sparse_stmt_count(const ofc_sparse_t* sparse);
+bool ofc_sparse_stmt(
+	const ofc_sparse_t* sparse, unsigned index,
+	unsigned* offset, unsigned* len);
+/* Finds the first statement which ends after ptr, which is
+   the statement count if there are none. */
+bool ofc_sparse_stmt_find(
+	const ofc_sparse_t* sparse, const char* ptr, unsigned* index);
+
 bool ofc_sparse_sequential(
 	const ofc_sparse_t* sparse, const char* ptr, unsigned size);
+/* Returns how many characters from ptr are sequential in the source,
+   so that several ranges can be checked with a single lookup. */
+unsigned ofc_sparse_sequential_len(
+	const ofc_sparse_t* sparse, const char* ptr);
 
 const char* ofc_sparse_parent_pointer(
 	const ofc_sparse_t* sparse, const char* ptr);
@@ -52,6 +74,15 @@ ofc_lang_opts_t ofc_sparse_lang_opts(const ofc_sparse_t* sparse);
 
 const char* ofc_sparse_get_include(
 	const ofc_sparse_t* sparse);
+ofc_file_t* ofc_sparse_get_file(
+	const ofc_sparse_t* sparse);
+
+/* Writes how a locked sparse was built from its file, so that it can be
+   rebuilt against the same file without prepping it again. */
+bool ofc_sparse_serialize(
+	ofc_serial_t* serial, const ofc_sparse_t* sparse);
+ofc_sparse_t* ofc_sparse_deserialize(
+	ofc_serial_t* serial, ofc_file_t* file);
 char* ofc_sparse_include_path(
 	const ofc_sparse_t* sparse, const char* path);
 
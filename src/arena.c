@@ -0,0 +1,373 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ofc/arena.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+
+/* Allocations are aligned as malloc would align them. */
+#define OFC_ARENA__ALIGN      _Alignof(max_align_t)
+#define OFC_ARENA__CHUNK_MIN  4096
+#define OFC_ARENA__CHUNK_MAX  (1 << 20)
+
+typedef struct ofc_arena__chunk_s ofc_arena__chunk_t;
+
+struct ofc_arena__chunk_s
+{
+	ofc_arena__chunk_t* prev;
+
+	/* Position of the first byte of this chunk within the arena. */
+	size_t base;
+
+	size_t size, used;
+};
+
+typedef struct ofc_arena__cleanup_s ofc_arena__cleanup_t;
+
+struct ofc_arena__cleanup_s
+{
+	ofc_arena__cleanup_t* prev;
+	size_t                position;
+
+	void (*func)(void*);
+	void* data;
+};
+
+struct ofc_arena_s
+{
+	ofc_arena__chunk_t*   chunk;
+	ofc_arena__chunk_t*   spare;
+	ofc_arena__cleanup_t* cleanup;
+
+	/* Start of the most recent allocation, for in place resizing. */
+	void* last;
+};
+
+/* Padded so that the block following the header keeps its alignment. */
+typedef union
+{
+	struct
+	{
+		unsigned size;
+		bool     arena;
+	};
+
+	max_align_t align;
+} ofc_arena__block_t;
+
+
+static inline size_t ofc_arena__align(size_t size)
+{
+	return ((size + (OFC_ARENA__ALIGN - 1))
+		& ~(size_t)(OFC_ARENA__ALIGN - 1));
+}
+
+#define OFC_ARENA__CHUNK_HEADER \
+	ofc_arena__align(sizeof(ofc_arena__chunk_t))
+
+static inline char* ofc_arena__chunk_data(
+	ofc_arena__chunk_t* chunk)
+{
+	return ((char*)chunk + OFC_ARENA__CHUNK_HEADER);
+}
+
+
+ofc_arena_t* ofc_arena_create(void)
+{
+	ofc_arena_t* arena
+		= (ofc_arena_t*)malloc(
+			sizeof(ofc_arena_t));
+	if (!arena) return NULL;
+
+	arena->chunk   = NULL;
+	arena->spare   = NULL;
+	arena->cleanup = NULL;
+	arena->last    = NULL;
+	return arena;
+}
+
+void ofc_arena_delete(ofc_arena_t* arena)
+{
+	if (!arena)
+		return;
+
+	ofc_arena_rewind(arena, 0);
+
+	while (arena->chunk)
+	{
+		ofc_arena__chunk_t* prev
+			= arena->chunk->prev;
+		free(arena->chunk);
+		arena->chunk = prev;
+	}
+
+	free(arena->spare);
+	free(arena);
+}
+
+
+static bool ofc_arena__chunk_add(
+	ofc_arena_t* arena, size_t size)
+{
+	size_t csize = (arena->chunk
+		? (arena->chunk->size << 1) : OFC_ARENA__CHUNK_MIN);
+	if (csize > OFC_ARENA__CHUNK_MAX)
+		csize = OFC_ARENA__CHUNK_MAX;
+	if (csize < size)
+		csize = size;
+
+	ofc_arena__chunk_t* chunk = NULL;
+	if (arena->spare && (arena->spare->size >= size))
+	{
+		chunk = arena->spare;
+		arena->spare = NULL;
+	}
+	else
+	{
+		if (csize > (SIZE_MAX - OFC_ARENA__CHUNK_HEADER))
+			return false;
+
+		chunk = (ofc_arena__chunk_t*)malloc(
+			OFC_ARENA__CHUNK_HEADER + csize);
+		if (!chunk) return false;
+		chunk->size = csize;
+	}
+
+	chunk->prev = arena->chunk;
+	chunk->base = (arena->chunk
+		? (arena->chunk->base + arena->chunk->used) : 0);
+	chunk->used = 0;
+
+	arena->chunk = chunk;
+	return true;
+}
+
+void* ofc_arena_alloc(ofc_arena_t* arena, size_t size)
+{
+	if (!arena)
+		return NULL;
+
+	size_t asize = ofc_arena__align(size);
+	if (asize < size)
+		return NULL;
+
+	if (!arena->chunk
+		|| ((arena->chunk->size - arena->chunk->used) < asize))
+	{
+		if (!ofc_arena__chunk_add(arena, asize))
+			return NULL;
+	}
+
+	void* ptr = &ofc_arena__chunk_data(
+		arena->chunk)[arena->chunk->used];
+	arena->chunk->used += asize;
+	arena->last = ptr;
+	return ptr;
+}
+
+void* ofc_arena_resize(
+	ofc_arena_t* arena, void* ptr,
+	size_t old_size, size_t size)
+{
+	if (!arena)
+		return NULL;
+
+	if (!ptr)
+		return ofc_arena_alloc(arena, size);
+
+	size_t asize = ofc_arena__align(size);
+	if (asize < size)
+		return NULL;
+
+	if (ptr == arena->last)
+	{
+		size_t start = ((uintptr_t)ptr
+			- (uintptr_t)ofc_arena__chunk_data(arena->chunk));
+		if ((arena->chunk->size - start) >= asize)
+		{
+			arena->chunk->used = start + asize;
+			return ptr;
+		}
+	}
+
+	if (size <= old_size)
+		return ptr;
+
+	void* nptr = ofc_arena_alloc(arena, size);
+	if (!nptr) return NULL;
+	memcpy(nptr, ptr, old_size);
+	return nptr;
+}
+
+
+size_t ofc_arena_position(const ofc_arena_t* arena)
+{
+	if (!arena || !arena->chunk)
+		return 0;
+	return (arena->chunk->base + arena->chunk->used);
+}
+
+void ofc_arena_rewind(ofc_arena_t* arena, size_t position)
+{
+	if (!arena)
+		return;
+
+	/* Cleanups are run newest first, so that the objects they
+	   reference haven't already been released. */
+	while (arena->cleanup
+		&& (arena->cleanup->position >= position))
+	{
+		ofc_arena__cleanup_t* cleanup = arena->cleanup;
+		arena->cleanup = cleanup->prev;
+		cleanup->func(cleanup->data);
+	}
+
+	while (arena->chunk
+		&& (arena->chunk->base > position))
+	{
+		ofc_arena__chunk_t* chunk = arena->chunk;
+		arena->chunk = chunk->prev;
+
+		/* Keep the largest chunk around so that repeatedly allocating
+		   and rewinding across a chunk boundary doesn't thrash malloc. */
+		if (!arena->spare
+			|| (arena->spare->size < chunk->size))
+		{
+			free(arena->spare);
+			arena->spare = chunk;
+		}
+		else
+		{
+			free(chunk);
+		}
+	}
+
+	if (arena->chunk
+		&& (position < (arena->chunk->base + arena->chunk->used)))
+		arena->chunk->used = (position - arena->chunk->base);
+
+	arena->last = NULL;
+}
+
+
+bool ofc_arena_cleanup(
+	ofc_arena_t* arena,
+	void (*func)(void*), void* data)
+{
+	if (!arena || !func)
+		return false;
+
+	size_t position = ofc_arena_position(arena);
+
+	ofc_arena__cleanup_t* cleanup
+		= (ofc_arena__cleanup_t*)ofc_arena_alloc(
+			arena, sizeof(ofc_arena__cleanup_t));
+	if (!cleanup) return false;
+
+	cleanup->prev     = arena->cleanup;
+	cleanup->position = position;
+	cleanup->func     = func;
+	cleanup->data     = data;
+
+	arena->cleanup = cleanup;
+	return true;
+}
+
+
+static inline ofc_arena__block_t* ofc_arena__block(
+	const void* ptr)
+{
+	return &((ofc_arena__block_t*)ptr)[-1];
+}
+
+void* ofc_arena_block_alloc(ofc_arena_t* arena, size_t size)
+{
+	#ifdef OFC_ARENA_MALLOC
+	arena = NULL;
+	#endif
+
+	if (size > (UINT_MAX - sizeof(ofc_arena__block_t)))
+		return NULL;
+
+	size_t bsize = sizeof(ofc_arena__block_t) + size;
+
+	ofc_arena__block_t* block
+		= (arena ? ofc_arena_alloc(arena, bsize) : malloc(bsize));
+	if (!block) return NULL;
+
+	block->size  = size;
+	block->arena = (arena != NULL);
+	return &block[1];
+}
+
+void* ofc_arena_block_realloc(
+	ofc_arena_t* arena, void* ptr, size_t size)
+{
+	#ifdef OFC_ARENA_MALLOC
+	arena = NULL;
+	#endif
+
+	if (!ptr)
+		return ofc_arena_block_alloc(arena, size);
+
+	if (size > (UINT_MAX - sizeof(ofc_arena__block_t)))
+		return NULL;
+
+	size_t bsize = sizeof(ofc_arena__block_t) + size;
+	ofc_arena__block_t* block
+		= ofc_arena__block(ptr);
+
+	if (!block->arena)
+	{
+		block = (ofc_arena__block_t*)realloc(block, bsize);
+		if (!block) return NULL;
+	}
+	else if (arena)
+	{
+		block = (ofc_arena__block_t*)ofc_arena_resize(
+			arena, block, (sizeof(ofc_arena__block_t) + block->size), bsize);
+		if (!block) return NULL;
+	}
+	else
+	{
+		/* With no arena we move to the heap,
+		   the old copy is released along with its arena. */
+		void* nptr = ofc_arena_block_alloc(NULL, size);
+		if (!nptr) return NULL;
+		memcpy(nptr, ptr, (block->size < size ? block->size : size));
+		return nptr;
+	}
+
+	block->size = size;
+	return &block[1];
+}
+
+void ofc_arena_block_free(void* ptr)
+{
+	if (!ptr)
+		return;
+
+	ofc_arena__block_t* block
+		= ofc_arena__block(ptr);
+	if (!block->arena)
+		free(block);
+}
+
+bool ofc_arena_block_owned(const void* ptr)
+{
+	return (ptr && ofc_arena__block(ptr)->arena);
+}
@@ -0,0 +1,266 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ofc/atom.h>
+#include <ofc/arena.h>
+#include <ofc/str_ref.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+
+
+typedef struct
+{
+	const char* base;
+	unsigned    size;
+
+	unsigned   hash, hash_ci;
+	ofc_atom_t fold;
+} ofc_atom__entry_t;
+
+/* Entries are indexed by atom and stored in chunks which never move,
+   chunk n holding (OFC_ATOM__CHUNK << n) entries. So once an atom is
+   published it can be read without the lock, which is only taken to
+   intern. The slots hold atoms in an open addressed table keyed on the
+   case sensitive hash. */
+#define OFC_ATOM__CHUNK       256
+#define OFC_ATOM__CHUNK_COUNT 24
+
+static struct
+{
+	ofc_arena_t* arena;
+
+	unsigned           count, capacity;
+	ofc_atom__entry_t* chunk[OFC_ATOM__CHUNK_COUNT];
+
+	unsigned    size;
+	ofc_atom_t* slot;
+} ofc_atom__table = { NULL, 0, 0, { NULL }, 0, NULL };
+
+static pthread_mutex_t ofc_atom__lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+static void ofc_atom__cleanup(void)
+{
+	free(ofc_atom__table.slot);
+
+	unsigned i;
+	for (i = 0; i < OFC_ATOM__CHUNK_COUNT; i++)
+		free(ofc_atom__table.chunk[i]);
+
+	ofc_arena_delete(ofc_atom__table.arena);
+}
+
+static inline ofc_atom__entry_t* ofc_atom__entry_index(unsigned index)
+{
+	unsigned q = ((index / OFC_ATOM__CHUNK) + 1);
+	unsigned c = ((sizeof(unsigned) * 8) - 1) - __builtin_clz(q);
+	return &ofc_atom__table.chunk[c][index - (OFC_ATOM__CHUNK * ((1U << c) - 1))];
+}
+
+static inline const ofc_atom__entry_t* ofc_atom__entry(ofc_atom_t atom)
+{
+	if ((atom == OFC_ATOM_NONE)
+		|| (atom > __atomic_load_n(&ofc_atom__table.count, __ATOMIC_ACQUIRE)))
+		return NULL;
+	return ofc_atom__entry_index(atom - 1);
+}
+
+static ofc_atom_t* ofc_atom__probe(
+	const char* base, unsigned size, unsigned hash)
+{
+	unsigned mask = (ofc_atom__table.size - 1);
+	unsigned i;
+	for (i = (hash & mask);
+		ofc_atom__table.slot[i] != OFC_ATOM_NONE;
+		i = ((i + 1) & mask))
+	{
+		const ofc_atom__entry_t* entry
+			= ofc_atom__entry(ofc_atom__table.slot[i]);
+		if ((entry->hash == hash)
+			&& (entry->size == size)
+			&& (memcmp(entry->base, base, size) == 0))
+			break;
+	}
+	return &ofc_atom__table.slot[i];
+}
+
+static bool ofc_atom__grow(void)
+{
+	unsigned size = (ofc_atom__table.size > 0
+		? (ofc_atom__table.size << 1) : 256);
+	if (size < ofc_atom__table.size)
+		return false;
+
+	ofc_atom_t* slot = (ofc_atom_t*)calloc(
+		size, sizeof(ofc_atom_t));
+	if (!slot) return false;
+
+	ofc_atom_t* old = ofc_atom__table.slot;
+	unsigned old_size = ofc_atom__table.size;
+
+	ofc_atom__table.slot = slot;
+	ofc_atom__table.size = size;
+
+	unsigned i;
+	for (i = 0; i < old_size; i++)
+	{
+		if (old[i] == OFC_ATOM_NONE)
+			continue;
+
+		const ofc_atom__entry_t* entry
+			= ofc_atom__entry(old[i]);
+		*ofc_atom__probe(entry->base, entry->size, entry->hash) = old[i];
+	}
+
+	free(old);
+	return true;
+}
+
+static ofc_atom_t ofc_atom__add(
+	const char* base, unsigned size,
+	unsigned hash, unsigned hash_ci)
+{
+	if (ofc_atom__table.count >= ofc_atom__table.capacity)
+	{
+		unsigned c;
+		for (c = 0; ofc_atom__table.chunk[c]; c++);
+		if (c >= OFC_ATOM__CHUNK_COUNT)
+			return OFC_ATOM_NONE;
+
+		unsigned size = (OFC_ATOM__CHUNK << c);
+		ofc_atom__entry_t* chunk = (ofc_atom__entry_t*)malloc(
+			sizeof(ofc_atom__entry_t) * size);
+		if (!chunk) return OFC_ATOM_NONE;
+
+		ofc_atom__table.chunk[c]  = chunk;
+		ofc_atom__table.capacity += size;
+	}
+
+	char* copy = (char*)ofc_arena_alloc(
+		ofc_atom__table.arena, (size > 0 ? size : 1));
+	if (!copy) return OFC_ATOM_NONE;
+	memcpy(copy, base, size);
+
+	ofc_atom__entry_t* entry
+		= ofc_atom__entry_index(ofc_atom__table.count);
+	entry->base    = copy;
+	entry->size    = size;
+	entry->hash    = hash;
+	entry->hash_ci = hash_ci;
+	entry->fold    = OFC_ATOM_NONE;
+
+	/* Publish the entry to readers which don't hold the lock. */
+	__atomic_store_n(&ofc_atom__table.count,
+		(ofc_atom__table.count + 1), __ATOMIC_RELEASE);
+	return ofc_atom__table.count;
+}
+
+static ofc_atom_t ofc_atom__intern(const char* base, unsigned size)
+{
+	if (!ofc_atom__table.arena)
+	{
+		ofc_atom__table.arena = ofc_arena_create();
+		if (!ofc_atom__table.arena)
+			return OFC_ATOM_NONE;
+		atexit(ofc_atom__cleanup);
+	}
+
+	/* Keep the load factor below 1/2 so that probes stay short. */
+	if (((ofc_atom__table.count + 2) * 2) > ofc_atom__table.size)
+	{
+		if (!ofc_atom__grow())
+			return OFC_ATOM_NONE;
+	}
+
+	ofc_str_ref_t ref = ofc_str_ref(base, size);
+	unsigned hash = ofc_str_ref_hash(ref);
+
+	ofc_atom_t* slot = ofc_atom__probe(base, size, hash);
+	if (*slot != OFC_ATOM_NONE)
+		return *slot;
+
+	unsigned hash_ci = ofc_str_ref_hash_ci(ref);
+	ofc_atom_t atom = ofc_atom__add(
+		base, size, hash, hash_ci);
+	if (atom == OFC_ATOM_NONE)
+		return OFC_ATOM_NONE;
+	*slot = atom;
+
+	char fold[size];
+	bool is_upper = true;
+	unsigned i;
+	for (i = 0; i < size; i++)
+	{
+		fold[i] = toupper(base[i]);
+		if (fold[i] != base[i])
+			is_upper = false;
+	}
+
+	if (is_upper)
+	{
+		ofc_atom__entry_index(atom - 1)->fold = atom;
+		return atom;
+	}
+
+	slot = ofc_atom__probe(fold, size, hash_ci);
+	ofc_atom_t fatom = *slot;
+	if (fatom == OFC_ATOM_NONE)
+	{
+		fatom = ofc_atom__add(
+			fold, size, hash_ci, hash_ci);
+		if (fatom == OFC_ATOM_NONE)
+			return OFC_ATOM_NONE;
+		ofc_atom__entry_index(fatom - 1)->fold = fatom;
+		*slot = fatom;
+	}
+
+	ofc_atom__entry_index(atom - 1)->fold = fatom;
+	return atom;
+}
+
+ofc_atom_t ofc_atom(const char* base, unsigned size)
+{
+	if (!base || (size == 0))
+		return OFC_ATOM_NONE;
+
+	pthread_mutex_lock(&ofc_atom__lock);
+	ofc_atom_t atom = ofc_atom__intern(base, size);
+	pthread_mutex_unlock(&ofc_atom__lock);
+	return atom;
+}
+
+
+unsigned ofc_atom_hash(ofc_atom_t atom)
+{
+	const ofc_atom__entry_t* entry
+		= ofc_atom__entry(atom);
+	return (entry ? entry->hash : 0);
+}
+
+unsigned ofc_atom_hash_ci(ofc_atom_t atom)
+{
+	const ofc_atom__entry_t* entry
+		= ofc_atom__entry(atom);
+	return (entry ? entry->hash_ci : 0);
+}
+
+ofc_atom_t ofc_atom_fold(ofc_atom_t atom)
+{
+	const ofc_atom__entry_t* entry
+		= ofc_atom__entry(atom);
+	return (entry ? entry->fold : OFC_ATOM_NONE);
+}
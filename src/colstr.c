@@ -17,8 +17,14 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
+#include <errno.h>
 
 
+/* When streaming, completed lines are written out once this much
+   output is buffered, so memory doesn't scale with the output. */
+#define OFC_COLSTR_FLUSH_SIZE 65536
+
 struct ofc_colstr_s
 {
 	unsigned size, max;
@@ -26,11 +32,14 @@ struct ofc_colstr_s
 	unsigned col, col_max, col_ext;
 	bool oversize;
 	unsigned oversize_off;
+
+	int  fd;
+	bool flushed;
 };
 
 
-ofc_colstr_t* ofc_colstr_create(
-	unsigned cols, unsigned ext)
+static ofc_colstr_t* ofc_colstr__create(
+	unsigned cols, unsigned ext, int fd)
 {
 	if (cols == 0)
 		cols = 72;
@@ -51,10 +60,26 @@ ofc_colstr_t* ofc_colstr_create(
 	cstr->col_max  = cols;
 	cstr->col_ext  = ext;
 	cstr->oversize = false;
+	cstr->fd       = fd;
+	cstr->flushed  = false;
 
 	return cstr;
 }
 
+ofc_colstr_t* ofc_colstr_create(
+	unsigned cols, unsigned ext)
+{
+	return ofc_colstr__create(cols, ext, -1);
+}
+
+ofc_colstr_t* ofc_colstr_create_stream(
+	unsigned cols, unsigned ext, int fd)
+{
+	if (fd < 0)
+		return NULL;
+	return ofc_colstr__create(cols, ext, fd);
+}
+
 void ofc_colstr_delete(ofc_colstr_t* cstr)
 {
 	if (!cstr)
@@ -65,6 +90,40 @@ void ofc_colstr_delete(ofc_colstr_t* cstr)
 }
 
 
+static bool ofc_colstr__write_fd(
+	int fd, const char* base, unsigned size)
+{
+	while (size > 0)
+	{
+		ssize_t len = write(fd, base, size);
+		if (len < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+
+		base += len;
+		size -= len;
+	}
+
+	return true;
+}
+
+static bool ofc_colstr__flush(ofc_colstr_t* cstr)
+{
+	if (cstr->size == 0)
+		return true;
+
+	if (!ofc_colstr__write_fd(
+		cstr->fd, cstr->base, cstr->size))
+		return false;
+
+	cstr->size    = 0;
+	cstr->flushed = true;
+	return true;
+}
+
 static bool ofc_colstr__enlarge(
 	ofc_colstr_t* cstr, unsigned size)
 {
@@ -97,7 +156,14 @@ bool ofc_colstr_newline(
 	ofc_colstr_t* cstr, unsigned indent,
 	unsigned* label)
 {
-	bool first = (cstr->size == 0);
+	/* An oversize write may still be patched with an ampersand,
+	   otherwise everything before a newline is final. */
+	if ((cstr->fd >= 0) && !cstr->oversize
+		&& (cstr->size >= OFC_COLSTR_FLUSH_SIZE)
+		&& !ofc_colstr__flush(cstr))
+		return false;
+
+	bool first = ((cstr->size == 0) && !cstr->flushed);
 
 	if (!ofc_colstr__enlarge(cstr, (first ? 6 : 7)))
 		return false;
@@ -292,33 +358,48 @@ bool ofc_colstr_write(
 	return true;
 }
 
-bool ofc_colstr_writef(
-	ofc_colstr_t* cstr,
-	const char* format, ...)
+/* Most fragments fit the stack buffer, so are only formatted once. */
+static bool ofc_colstr__vwritef(
+	ofc_colstr_t* cstr, bool atomic,
+	const char* format, va_list args)
 {
-	va_list args;
-	va_start(args, format);
+	char sbuff[256];
 
 	va_list largs;
 	va_copy(largs, args);
-	int len = vsnprintf(NULL, 0, format, largs);
+	int len = vsnprintf(sbuff, sizeof(sbuff), format, largs);
 	va_end(largs);
 
 	if (len <= 0)
-	{
-		va_end(args);
 		return false;
+
+	if ((unsigned)len < sizeof(sbuff))
+	{
+		return (atomic
+			? ofc_colstr_atomic_write(cstr, sbuff, len)
+			: ofc_colstr_write(cstr, sbuff, len));
 	}
 
 	char buff[len + 1];
 	int plen = vsnprintf(buff, (len + 1), format, args);
-	va_end(args);
-
 	if (len != plen)
 		return false;
 
-	return ofc_colstr_write(
-		cstr, buff, len);
+	return (atomic
+		? ofc_colstr_atomic_write(cstr, buff, len)
+		: ofc_colstr_write(cstr, buff, len));
+}
+
+bool ofc_colstr_writef(
+	ofc_colstr_t* cstr,
+	const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	bool success = ofc_colstr__vwritef(
+		cstr, false, format, args);
+	va_end(args);
+	return success;
 }
 
 static bool ofc_colstr_atomic_write__oversized(
@@ -504,34 +585,25 @@ bool ofc_colstr_atomic_writef(
 {
 	va_list args;
 	va_start(args, format);
-
-	va_list largs;
-	va_copy(largs, args);
-	int len = vsnprintf(NULL, 0, format, largs);
-	va_end(largs);
-
-	if (len <= 0)
-	{
-		va_end(args);
-		return false;
-	}
-
-	char buff[len + 1];
-	int plen = vsnprintf(buff, (len + 1), format, args);
+	bool success = ofc_colstr__vwritef(
+		cstr, true, format, args);
 	va_end(args);
-
-	if (len != plen)
-		return false;
-
-	return ofc_colstr_atomic_write(
-		cstr, buff, len);
+	return success;
 }
 
 bool ofc_colstr_fdprint(ofc_colstr_t* cstr, int fd)
 {
-	if (!cstr || !cstr->base)
+	if (!cstr)
 		return false;
 
-	return (dprintf(fd, "%.*s",
-		cstr->size, cstr->base) > 0);
+	if (cstr->size == 0)
+		return cstr->flushed;
+
+	if (!ofc_colstr__write_fd(
+		fd, cstr->base, cstr->size))
+		return false;
+
+	cstr->size    = 0;
+	cstr->flushed = true;
+	return true;
 }
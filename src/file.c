@@ -19,11 +19,20 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
+#include <limits.h>
+#include <errno.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 
 
+typedef struct
+{
+	unsigned count;
+	unsigned offset[];
+} ofc_file__lines_t;
+
 struct ofc_file_s
 {
 	char*           path;
@@ -32,10 +41,64 @@ struct ofc_file_s
 	ofc_lang_opts_t opts;
 	unsigned        size;
 	unsigned        ref;
+
+	/* When set strz is a mapping of the file rather than a heap copy. */
+	bool mapped;
+
+	/* Offset of the start of each line, built on first use
+	   by whichever thread first needs it. */
+	ofc_file__lines_t* line;
 };
 
 
-static char* ofc_file__read(const char* path, unsigned* size)
+/* Reads until EOF, for pipes and anything else whose size isn't known. */
+static char* ofc_file__read_stream(int fd, unsigned* size)
+{
+	char*  buff = NULL;
+	size_t bsize = 0, used = 0;
+
+	while (true)
+	{
+		if ((used + 1) >= bsize)
+		{
+			size_t nsize = (bsize > 0 ? (bsize << 1) : 4096);
+			if ((nsize <= bsize) || (nsize > UINT_MAX))
+			{
+				free(buff);
+				return NULL;
+			}
+
+			char* nbuff = (char*)realloc(buff, nsize);
+			if (!nbuff)
+			{
+				free(buff);
+				return NULL;
+			}
+			buff  = nbuff;
+			bsize = nsize;
+		}
+
+		ssize_t rsize = read(fd, &buff[used], (bsize - used - 1));
+		if (rsize < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			free(buff);
+			return NULL;
+		}
+		if (rsize == 0)
+			break;
+		used += rsize;
+	}
+
+	buff[used] = '\0';
+
+	if (size) *size = used;
+	return buff;
+}
+
+static char* ofc_file__read(
+	const char* path, unsigned* size, bool* mapped)
 {
 	int fd = open(path, O_RDONLY);
 	if (fd < 0 ) return NULL;
@@ -47,6 +110,37 @@ static char* ofc_file__read(const char* path, unsigned* size)
 		return NULL;
 	}
 
+	if (!S_ISREG(fs.st_mode))
+	{
+		char* buff = ofc_file__read_stream(fd, size);
+		close(fd);
+		if (mapped) *mapped = false;
+		return buff;
+	}
+
+	if ((uintmax_t)fs.st_size >= UINT_MAX)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	/* The rest of the last page of a mapping reads as zero, which gives
+	   us the terminator for free unless the file fills the page. */
+	long page = sysconf(_SC_PAGESIZE);
+	if ((fs.st_size > 0) && (page > 0)
+		&& ((fs.st_size % page) != 0))
+	{
+		void* map = mmap(NULL, fs.st_size,
+			PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map != MAP_FAILED)
+		{
+			close(fd);
+			if (size) *size = fs.st_size;
+			if (mapped) *mapped = true;
+			return (char*)map;
+		}
+	}
+
 	char* buff = (char*)malloc(fs.st_size + 1);
 	if (!buff)
 	{
@@ -66,6 +160,7 @@ static char* ofc_file__read(const char* path, unsigned* size)
 	buff[fs.st_size] = '\0';
 
 	if (size) *size = fs.st_size;
+	if (mapped) *mapped = false;
 	return buff;
 }
 
@@ -74,14 +169,19 @@ ofc_file_t* ofc_file_create(const char* path, ofc_lang_opts_t opts)
 	ofc_file_t* file = (ofc_file_t*)malloc(sizeof(ofc_file_t));
 	if (!file) return NULL;
 
+	file->mapped = false;
+
 	file->path = strdup(path);
-	file->strz = ofc_file__read(path, &file->size);
+	file->strz = ofc_file__read(
+		path, &file->size, &file->mapped);
 	file->opts = opts;
 
 	file->include = NULL;
 
 	file->ref = 0;
 
+	file->line = NULL;
+
 	if (!file->path || !file->strz)
 	{
 		ofc_file_delete(file);
@@ -113,10 +213,12 @@ bool ofc_file_reference(ofc_file_t* file)
 	if (!file)
 		return false;
 
-	unsigned nref = file->ref + 1;
-	if (nref == 0) return false;
-
-	file->ref += 1;
+	/* References may be taken and released from any thread. */
+	if (__atomic_add_fetch(&file->ref, 1, __ATOMIC_RELAXED) == 0)
+	{
+		__atomic_sub_fetch(&file->ref, 1, __ATOMIC_RELAXED);
+		return false;
+	}
 	return true;
 }
 
@@ -125,13 +227,15 @@ void ofc_file_delete(ofc_file_t* file)
 	if (!file)
 		return;
 
-	if (file->ref > 0)
-	{
-		file->ref -= 1;
+	/* Only the last release sees the count already at zero. */
+	if (__atomic_fetch_sub(&file->ref, 1, __ATOMIC_ACQ_REL) > 0)
 		return;
-	}
 
-	free(file->strz);
+	free(file->line);
+	if (file->mapped)
+		munmap(file->strz, file->size);
+	else
+		free(file->strz);
 	free(file->path);
 	free(file->include);
 	free(file);
@@ -156,6 +260,11 @@ const char* ofc_file_get_strz(const ofc_file_t* file)
 	return (file ? file->strz : NULL);
 }
 
+unsigned ofc_file_get_size(const ofc_file_t* file)
+{
+	return (file ? file->size : 0);
+}
+
 ofc_lang_opts_t ofc_file_get_lang_opts(const ofc_file_t* file)
 {
 	return (file ? file->opts : OFC_LANG_OPTS_F77);
@@ -207,6 +316,63 @@ char* ofc_file_include_path(
 
 
 
+static const ofc_file__lines_t* ofc_file__lines(const ofc_file_t* file)
+{
+	ofc_file__lines_t* lines
+		= __atomic_load_n(&file->line, __ATOMIC_ACQUIRE);
+	if (lines) return lines;
+
+	unsigned count = 1;
+	unsigned i;
+	for (i = 0; i < file->size; i++)
+	{
+		if (ofc_is_vspace(file->strz[i]))
+			count++;
+	}
+
+	lines = (ofc_file__lines_t*)malloc(
+		sizeof(ofc_file__lines_t) + (sizeof(unsigned) * count));
+	if (!lines) return NULL;
+
+	lines->count = count;
+	lines->offset[0] = 0;
+	unsigned l;
+	for (i = 0, l = 1; i < file->size; i++)
+	{
+		if (ofc_is_vspace(file->strz[i]))
+			lines->offset[l++] = (i + 1);
+	}
+
+	/* The index is a cache, so it's filled even for a const file,
+	   if another thread got there first we use theirs. */
+	ofc_file_t* mfile = (ofc_file_t*)file;
+	ofc_file__lines_t* expect = NULL;
+	if (!__atomic_compare_exchange_n(
+		&mfile->line, &expect, lines, false,
+		__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+	{
+		free(lines);
+		lines = expect;
+	}
+	return lines;
+}
+
+/* Each of CR and LF starts a new line, so CRLF counts twice. */
+static unsigned ofc_file__row(
+	const ofc_file__lines_t* lines, unsigned pos)
+{
+	unsigned lo = 0, hi = lines->count;
+	while ((hi - lo) > 1)
+	{
+		unsigned mid = lo + ((hi - lo) / 2);
+		if (lines->offset[mid] <= pos)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
 bool ofc_file_get_position(
 	const ofc_file_t* file, const char* ptr,
 	unsigned* row, unsigned* col)
@@ -218,25 +384,14 @@ bool ofc_file_get_position(
 	if (pos >= file->size)
 		return false;
 
-	/* TODO - Use binary tree of line positions to find faster. */
-	unsigned i, r, c;
-	for (i = 0, r = 0, c = 0; i < pos; i++)
-	{
-		switch (file->strz[i])
-		{
-			case '\r':
-			case '\n':
-				r += 1;
-				c = 0;
-				break;
-			default:
-				c++;
-				break;
-		}
-	}
+	const ofc_file__lines_t* lines
+		= ofc_file__lines(file);
+	if (!lines) return false;
+
+	unsigned r = ofc_file__row(lines, pos);
 
 	if (row) *row = r;
-	if (col) *col = c;
+	if (col) *col = (pos - lines->offset[r]);
 	return true;
 }
 
@@ -260,61 +415,82 @@ static bool line_empty(const char* ptr, unsigned len)
 	return true;
 }
 
+static unsigned ofc_file__diagnostics = 0;
+
+unsigned ofc_file_diagnostic_count(void)
+{
+	return __atomic_load_n(
+		&ofc_file__diagnostics, __ATOMIC_RELAXED);
+}
+
+static __thread FILE* ofc_file__diagnostics_stream = NULL;
+
+FILE* ofc_file_diagnostics_swap(FILE* stream)
+{
+	FILE* prev = ofc_file__diagnostics_stream;
+	ofc_file__diagnostics_stream = stream;
+	return prev;
+}
+
+FILE* ofc_file_diagnostics(void)
+{
+	return (ofc_file__diagnostics_stream
+		? ofc_file__diagnostics_stream : stderr);
+}
+
 static void ofc_file__debug_va(
 	const ofc_file_t* file,
 	const char* sol, const char* ptr,
 	const char* type, const char* format, va_list args)
 {
+	__atomic_add_fetch(
+		&ofc_file__diagnostics, 1, __ATOMIC_RELAXED);
+
+	FILE* out = ofc_file_diagnostics();
+
 	unsigned row, col;
 	bool positional = ofc_file_get_position(
 		file, ptr, &row, &col);
 
-	fprintf(stderr, "%s:", type);
+	fprintf(out, "%s:", type);
 
 	if (positional)
-		fprintf(stderr, "%s:%u,%u:",
+		fprintf(out, "%s:%u,%u:",
 			file->path, (row + 1), col);
 
-	fprintf(stderr, " ");
-	vfprintf(stderr, format, args);
-	fprintf(stderr, "\n");
+	fprintf(out, " ");
+	vfprintf(out, format, args);
+	fprintf(out, "\n");
 
 	if (positional)
 	{
-		if (!sol)
+		if (!sol || (sol > ptr)
+			|| (sol < file->strz))
 			sol = ptr;
 
-		const char* s = file->strz;
-		const char* p;
-		for (p = file->strz; p < sol; p++)
-		{
-			if (ofc_is_vspace(*p))
-				s = &p[1];
-		}
+		const ofc_file__lines_t* lines
+			= ofc_file__lines(file);
+		unsigned r = ofc_file__row(lines,
+			((uintptr_t)sol - (uintptr_t)file->strz));
+		const char* s = &file->strz[lines->offset[r]];
 
 		unsigned len = ((uintptr_t)ptr - (uintptr_t)s);
 		for (; !ofc_is_vspace(s[len]) && (s[len] != '\0'); len++);
 
 		/* Print line(s) above if line is empty. */
-		while (line_empty(s, len)
-			&& (s != file->strz))
+		while (line_empty(s, len) && (r > 0))
 		{
-			const char* ns = file->strz;
-			for (p = file->strz; p < s; p++)
-			{
-				if (ofc_is_vspace(*p))
-					ns = &p[1];
-			}
+			const char* ns = &file->strz[lines->offset[--r]];
 			len += ((uintptr_t)s - (uintptr_t)ns);
 			s = ns;
 		}
 
-		fprintf(stderr, "%.*s\n", len, s);
+		fprintf(out, "%.*s\n", len, s);
 
 		unsigned i;
 		for (i = 0; i < col; i++)
-			fprintf(stderr, " ");
-		fprintf(stderr, "^\n");
+			fprintf(out, " ");
+		fprintf(out, "^\n");
 	}
 }
 
@@ -17,13 +17,13 @@
 #include <stdlib.h>
 #include <string.h>
 
-typedef struct ofc_hashmap__entry_s ofc_hashmap__entry_t;
+#define OFC_HASHMAP__SIZE_MIN 16
 
-struct ofc_hashmap__entry_s
+typedef struct
 {
-	void             *item;
-	ofc_hashmap__entry_t *next;
-};
+	unsigned hash;
+	void*    item;
+} ofc_hashmap__slot_t;
 
 struct ofc_hashmap_s
 {
@@ -32,16 +32,22 @@ struct ofc_hashmap_s
 	ofc_hashmap_item_key_f    item_key;
 	ofc_hashmap_item_delete_f item_delete;
 
-	ofc_hashmap__entry_t* base[256];
+	unsigned             count;
+	unsigned             size;
+	ofc_hashmap__slot_t* slot;
 };
 
 
-static uint8_t ofc_hashmap__hash(const char* key)
+static unsigned ofc_hashmap__hash(const char* key)
 {
-	uint8_t h = 0;
+	/* FNV-1a */
+	unsigned h = 2166136261U;
 	unsigned i;
 	for (i = 0; key[i] != '\0'; i++)
-		h += key[i];
+	{
+		h ^= (unsigned char)key[i];
+		h *= 16777619U;
+	}
 	return h;
 }
 
@@ -75,40 +81,118 @@ ofc_hashmap_t* ofc_hashmap_create(
 		: (ofc_hashmap_item_key_f)ofc_hashmap__item_key);
 	map->item_delete = item_delete;
 
-	unsigned i;
-	for (i = 0; i < 256; i++)
-		map->base[i] = NULL;
+	/* Slots are allocated on first insert since many maps stay empty. */
+	map->count = 0;
+	map->size  = 0;
+	map->slot  = NULL;
 
 	return map;
 }
 
-static void ofc_hashmap__entry_delete(
-	ofc_hashmap__entry_t* entry,
-	ofc_hashmap_item_delete_f item_delete)
+void ofc_hashmap_delete(ofc_hashmap_t* map)
 {
-	if (!entry)
+	if (!map)
 		return;
 
-	ofc_hashmap__entry_delete(
-		entry->next, item_delete);
+	if (map->item_delete)
+	{
+		unsigned i;
+		for (i = 0; i < map->size; i++)
+		{
+			if (map->slot[i].item)
+				map->item_delete(map->slot[i].item);
+		}
+	}
 
-	if (item_delete)
-		item_delete(entry->item);
-	free(entry);
+	free(map->slot);
+	free(map);
 }
 
-void ofc_hashmap_delete(ofc_hashmap_t* map)
+
+/* Scramble the hash so that weak user hashes (sequential labels,
+   pointers, sums) still spread evenly over the low bits we index by. */
+static inline unsigned ofc_hashmap__index(
+	const ofc_hashmap_t* map, unsigned hash)
 {
-	if (!map)
-		return;
+	hash ^= (hash >> 16);
+	hash *= 0x45D9F3BU;
+	hash ^= (hash >> 16);
+	return (hash & (map->size - 1));
+}
 
-	unsigned i;
-	for (i = 0; i < 256; i++)
-		ofc_hashmap__entry_delete(
-			map->base[i], map->item_delete);
-	free(map);
+static bool ofc_hashmap__slot_match(
+	const ofc_hashmap_t* map, const ofc_hashmap__slot_t* slot,
+	unsigned hash, const void* key)
+{
+	if (slot->hash != hash)
+		return false;
+
+	const void* ikey = map->item_key(slot->item);
+	if (key == ikey)
+		return true;
+
+	return (map->key_compare
+		&& map->key_compare(key, ikey));
 }
 
+/* When shadow is set, an item whose key is already present takes the
+   place of the first match so it's found first, as in a chained map
+   where the latest insert shadows the rest, the older item moves on. */
+static void ofc_hashmap__insert(
+	ofc_hashmap_t* map, unsigned hash, void* item, bool shadow)
+{
+	const void* key = (shadow ? map->item_key(item) : NULL);
+
+	unsigned i = ofc_hashmap__index(map, hash);
+	for (; map->slot[i].item; i = ((i + 1) & (map->size - 1)))
+	{
+		if (shadow && ofc_hashmap__slot_match(
+			map, &map->slot[i], hash, key))
+		{
+			void* older = map->slot[i].item;
+			map->slot[i].item = item;
+			item   = older;
+			shadow = false;
+		}
+	}
+
+	map->slot[i].hash = hash;
+	map->slot[i].item = item;
+	map->count++;
+}
+
+static bool ofc_hashmap__resize(
+	ofc_hashmap_t* map, unsigned size)
+{
+	ofc_hashmap__slot_t* slot
+		= (ofc_hashmap__slot_t*)calloc(
+			size, sizeof(ofc_hashmap__slot_t));
+	if (!slot) return false;
+
+	ofc_hashmap__slot_t* old_slot = map->slot;
+	unsigned             old_size = map->size;
+
+	map->slot  = slot;
+	map->size  = size;
+	map->count = 0;
+
+	/* Start after an empty slot so that no run wraps around,
+	   then items with equal keys keep their order. */
+	unsigned start;
+	for (start = 0; (start < old_size) && old_slot[start].item; start++);
+
+	unsigned i;
+	for (i = 0; i < old_size; i++)
+	{
+		unsigned j = ((start + 1 + i) & (old_size - 1));
+		if (old_slot[j].item)
+			ofc_hashmap__insert(map,
+				old_slot[j].hash, old_slot[j].item, false);
+	}
+
+	free(old_slot);
+	return true;
+}
 
 
 bool ofc_hashmap_add(ofc_hashmap_t* map, void* item)
@@ -121,17 +205,18 @@ bool ofc_hashmap_add(ofc_hashmap_t* map, void* item)
 	const void* key = map->item_key(item);
 	if (!key) return false;
 
-	uint8_t hash = map->hash(key);
-
-	ofc_hashmap__entry_t* entry
-		= (ofc_hashmap__entry_t*)malloc(
-			sizeof(ofc_hashmap__entry_t));
-	if (!entry) return false;
-
-	entry->item = item;
-	entry->next = map->base[hash];
-	map->base[hash] = entry;
+	/* Keep the load factor at or below 3/4. */
+	if (((map->count + 1) * 4) > (map->size * 3))
+	{
+		unsigned size = (map->size > 0
+			? (map->size * 2) : OFC_HASHMAP__SIZE_MIN);
+		if ((size <= map->size)
+			|| !ofc_hashmap__resize(map, size))
+			return false;
+	}
 
+	ofc_hashmap__insert(map,
+		map->hash(key), item, true);
 	return true;
 }
 
@@ -139,22 +224,19 @@ bool ofc_hashmap_add(ofc_hashmap_t* map, void* item)
 void* ofc_hashmap_find_modify(ofc_hashmap_t* map, const void* key)
 {
 	if (!map || !key
-		|| !map->item_key)
+		|| !map->item_key
+		|| (map->count == 0))
 		return NULL;
 
-	uint8_t hash = map->hash(key);
+	unsigned hash = map->hash(key);
 
-	ofc_hashmap__entry_t* entry;
-	for (entry = map->base[hash]; entry; entry = entry->next)
+	unsigned i;
+	for (i = ofc_hashmap__index(map, hash); map->slot[i].item;
+		i = ((i + 1) & (map->size - 1)))
 	{
-		const void* ikey = map->item_key(entry->item);
-
-		if (key == ikey)
-			return entry->item;
-
-		if (map->key_compare
-			&& map->key_compare(key, ikey))
-			return entry->item;
+		if (ofc_hashmap__slot_match(
+			map, &map->slot[i], hash, key))
+			return map->slot[i].item;
 	}
 
 	return NULL;
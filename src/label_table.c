@@ -15,21 +15,21 @@
 
 #include <ofc/label_table.h>
 #include <stdlib.h>
-#include <stdint.h>
+#include <string.h>
+#include <limits.h>
 
-typedef struct label_s label_t;
-
-struct label_s
+typedef struct
 {
 	unsigned offset;
 	unsigned number;
+} ofc_label_table__entry_t;
 
-	label_t* next;
-};
-
+/* Labels are added in source order, so this is kept sorted by offset
+   and searched with a binary search. */
 struct ofc_label_table_s
 {
-	label_t* base[256];
+	unsigned                  count, size;
+	ofc_label_table__entry_t* label;
 };
 
 
@@ -40,38 +40,36 @@ ofc_label_table_t* ofc_label_table_create(void)
 			sizeof(ofc_label_table_t));
 	if (!table) return NULL;
 
-	unsigned i;
-	for (i = 0; i < 256; i++)
-		table->base[i] = NULL;
+	table->count = 0;
+	table->size  = 0;
+	table->label = NULL;
 	return table;
 }
 
-static void label__delete(label_t* label)
-{
-	if (!label)
-		return;
-	label__delete(label->next);
-	free(label);
-}
-
 void ofc_label_table_delete(ofc_label_table_t* table)
 {
 	if (!table)
 		return;
 
-	unsigned i;
-	for (i = 0; i < 256; i++)
-		label__delete(table->base[i]);
+	free(table->label);
 	free(table);
 }
 
 
-static uint8_t ofc_label_table__offset_hash(unsigned offset)
+/* Returns the index of the first label at or after offset. */
+static unsigned ofc_label_table__search(
+	const ofc_label_table_t* table, unsigned offset)
 {
-	uint32_t h = (offset & 0xFFFFFFFFU);
-	h = (h & 0x0000FFFF) ^ (h >> 16U);
-	h = (h & 0x000000FF) ^ (h >>  8U);
-	return h;
+	unsigned lo = 0, hi = table->count;
+	while (lo < hi)
+	{
+		unsigned mid = lo + ((hi - lo) / 2);
+		if (table->label[mid].offset < offset)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
 }
 
 bool ofc_label_table_add(
@@ -80,41 +78,103 @@ bool ofc_label_table_add(
 	if (!table)
 		return false;
 
-	/* Don't allow duplicate labels at the same position. */
-	if (ofc_label_table_find(table, offset, NULL))
-		return false;
-
-	uint8_t hash = ofc_label_table__offset_hash(offset);
+	unsigned i = table->count;
+	if ((i > 0) && (table->label[i - 1].offset >= offset))
+	{
+		i = ofc_label_table__search(table, offset);
 
-	label_t* label = (label_t*)malloc(sizeof(label_t));
-	if (!label) return false;
+		/* Don't allow duplicate labels at the same position. */
+		if ((i < table->count)
+			&& (table->label[i].offset == offset))
+			return false;
+	}
 
-	label->offset = offset;
-	label->number = number;
-	label->next   = table->base[hash];
+	if (table->count >= table->size)
+	{
+		unsigned size = (table->size > 0 ? (table->size << 1) : 64);
+		if ((size <= table->size)
+			|| (size > (UINT_MAX / sizeof(ofc_label_table__entry_t))))
+			return false;
+
+		ofc_label_table__entry_t* label
+			= (ofc_label_table__entry_t*)realloc(table->label,
+				(sizeof(ofc_label_table__entry_t) * size));
+		if (!label) return false;
+
+		table->label = label;
+		table->size  = size;
+	}
 
-	table->base[hash] = label;
+	if (i < table->count)
+	{
+		memmove(&table->label[i + 1], &table->label[i],
+			(sizeof(ofc_label_table__entry_t) * (table->count - i)));
+	}
 
+	table->label[i].offset = offset;
+	table->label[i].number = number;
+	table->count++;
 	return true;
 }
 
 bool ofc_label_table_find(
 	const ofc_label_table_t* table, unsigned offset, unsigned* number)
+{
+	if (!table || (table->count == 0))
+		return false;
+
+	unsigned i = ofc_label_table__search(table, offset);
+	if ((i >= table->count)
+		|| (table->label[i].offset != offset))
+		return false;
+
+	if (number) *number = table->label[i].number;
+	return true;
+}
+
+
+bool ofc_label_table_serialize(
+	ofc_serial_t* serial, const ofc_label_table_t* table)
 {
 	if (!table)
 		return false;
 
-	uint8_t hash = ofc_label_table__offset_hash(offset);
+	if (!ofc_serial_write_uint(serial, table->count))
+		return false;
+
+	/* Offsets are sorted, so only the gaps are written. */
+	unsigned i, prev;
+	for (i = 0, prev = 0; i < table->count; i++)
+	{
+		if (!ofc_serial_write_uint(serial, (table->label[i].offset - prev))
+			|| !ofc_serial_write_uint(serial, table->label[i].number))
+			return false;
+		prev = table->label[i].offset;
+	}
+
+	return true;
+}
 
-	label_t* label;
-	for (label = table->base[hash]; label; label = label->next)
+bool ofc_label_table_deserialize(
+	ofc_serial_t* serial, ofc_label_table_t* table)
+{
+	unsigned count;
+	if (!table || !ofc_serial_read_unsigned(serial, &count))
+		return false;
+
+	unsigned i, offset;
+	for (i = 0, offset = 0; i < count; i++)
 	{
-		if (label->offset == offset)
-		{
-			if (number) *number = label->number;
-			return true;
-		}
+		unsigned delta, number;
+		if (!ofc_serial_read_unsigned(serial, &delta)
+			|| !ofc_serial_read_unsigned(serial, &number)
+			|| (delta > (UINT_MAX - offset)))
+			return false;
+		offset += delta;
+
+		if (!ofc_label_table_add(table, offset, number))
+			return false;
 	}
 
-	return false;
+	return true;
 }
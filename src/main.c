@@ -33,6 +33,8 @@ void print_usage(const char* name)
 	printf("  -d, -debug                            selects debug mode, defaults to false\n");
 	printf("  -columns-<n>                          sets number of columns to <n>\n");
 	printf("  -case-sen                             selects case sensitivity, defaults to false\n");
+	printf("  -cache-dir=<dir>                      caches parse trees in <dir>\n");
+	printf("  -threads-<n>                          parses with <n> threads, defaults to 1\n");
 }
 
 const char *get_file_ext(const char *path) {
@@ -60,6 +62,7 @@ typedef enum
 	DEBUG,
 	COLUMNS,
 	CASE_SEN,
+	THREADS,
 	INVALID
 } args_e;
 
@@ -136,6 +139,21 @@ args_e get_options(char* arg, int* num)
 			return INVALID;
 		}
 	}
+	/* Parse -threads-n */
+	else if ((count == 2) && (strcmp(option[0], "threads") == 0))
+	{
+		int threads = strtol(option[1], (char **)NULL, 10);
+		if (threads > 0)
+		{
+			*num = threads;
+			return THREADS;
+		}
+		else
+		{
+			fprintf(stderr, "Error: invalid number of threads\n");
+			return INVALID;
+		}
+	}
 	/* Parse -case-sen */
 	else if ((count == 2) && (strcmp(option[0], "case") == 0)
 		&& (strcmp(option[1], "sen") == 0))
@@ -163,6 +181,7 @@ int main(int argc, const char* argv[])
 	const char* source_file_ext = get_file_ext(path);
 
 	ofc_lang_opts_t opts = OFC_LANG_OPTS_F77;
+	const char* cache_dir = NULL;
 
 	if (source_file_ext
 		&& (strcasecmp(source_file_ext, "F90") == 0))
@@ -171,6 +190,13 @@ int main(int argc, const char* argv[])
 	int i;
 	for (i = 1; i < (argc - 1); i++)
 	{
+		/* Handled here since a path may contain '-'. */
+		if (strncmp(argv[i], "-cache-dir=", 11) == 0)
+		{
+			cache_dir = &argv[i][11];
+			continue;
+		}
+
 		char* arg = strdup(argv[i]);
 		int num = 0;
 		args_e name = get_options(arg, &num);
@@ -199,6 +225,9 @@ int main(int argc, const char* argv[])
 			case CASE_SEN:
 				opts.case_sensitive = true;
 				break;
+			case THREADS:
+				ofc_parse_file_threads(num);
+				break;
 			default:
 				print_usage(argv[0]);
 				return EXIT_FAILURE;
@@ -212,26 +241,47 @@ int main(int argc, const char* argv[])
 		return EXIT_FAILURE;
 	}
 
-	ofc_sparse_t* condense = ofc_prep(file);
-	ofc_file_delete(file);
-	if (!condense)
+	ofc_sparse_t* condense = NULL;
+	ofc_parse_stmt_list_t* program = NULL;
+	if (cache_dir)
 	{
-		fprintf(stderr, "Error: Failed preprocess source file '%s'\n", path);
-		return EXIT_FAILURE;
+		program = ofc_parse_file_cache_load(
+			cache_dir, file, &condense);
 	}
 
-	ofc_parse_stmt_list_t* program
-		= ofc_parse_file(condense);
-
 	if (!program)
 	{
-		fprintf(stderr, "Error: Failed to parse program\n");
-		ofc_sparse_delete(condense);
-		return EXIT_FAILURE;
+		unsigned diagnostics = ofc_file_diagnostic_count();
+		condense = ofc_prep(file);
+		if (!condense)
+		{
+			fprintf(stderr, "Error: Failed preprocess source file '%s'\n", path);
+			ofc_file_delete(file);
+			return EXIT_FAILURE;
+		}
+
+		program = ofc_parse_file(condense);
+		ofc_parse_file_include_cache_clear();
+
+		if (!program)
+		{
+			fprintf(stderr, "Error: Failed to parse program\n");
+			ofc_sparse_delete(condense);
+			ofc_file_delete(file);
+			return EXIT_FAILURE;
+		}
+
+		/* Diagnostics aren't stored, so only clean parses are cached. */
+		if (cache_dir && (ofc_file_diagnostic_count() == diagnostics))
+		{
+			ofc_parse_file_cache_store(
+				cache_dir, file, condense, program);
+		}
 	}
+	ofc_file_delete(file);
 
 	#ifdef OFC_PRINT_PARSE
-	ofc_colstr_t* cs = ofc_colstr_create(72, 0);
+	ofc_colstr_t* cs = ofc_colstr_create_stream(72, 0, STDOUT_FILENO);
 	if (!ofc_parse_stmt_list_print(cs, 0, program))
 	{
 		fprintf(stderr, "Error: Failed to print parse tree\n");
@@ -254,7 +304,7 @@ int main(int argc, const char* argv[])
 	}
 
 	#ifdef OFC_PRINT_SEMA
-	ofc_colstr_t* cs = ofc_colstr_create(72, 0);
+	ofc_colstr_t* cs = ofc_colstr_create_stream(72, 0, STDOUT_FILENO);
 	if (!ofc_sema_scope_print(cs, 0, sema))
 	{
 		fprintf(stderr, "Error: Failed to print semantic tree\n");
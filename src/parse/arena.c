@@ -0,0 +1,130 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ofc/parse.h>
+
+
+/* Each thread parses into its own arena. */
+static __thread ofc_arena_t* ofc_parse_arena__current = NULL;
+
+
+ofc_arena_t* ofc_parse_arena_swap(ofc_arena_t* arena)
+{
+	ofc_arena_t* prev = ofc_parse_arena__current;
+	ofc_parse_arena__current = arena;
+	return prev;
+}
+
+size_t ofc_parse_arena_position(void)
+{
+	return ofc_arena_position(
+		ofc_parse_arena__current);
+}
+
+void ofc_parse_arena_rewind(size_t position)
+{
+	ofc_parse_memo_release(position);
+	ofc_arena_rewind(
+		ofc_parse_arena__current, position);
+}
+
+bool ofc_parse_arena_cleanup(void (*func)(void*), void* data)
+{
+	return ofc_arena_cleanup(
+		ofc_parse_arena__current, func, data);
+}
+
+
+void* ofc_parse_alloc(size_t size)
+{
+	return ofc_arena_block_alloc(
+		ofc_parse_arena__current, size);
+}
+
+void* ofc_parse_realloc(void* ptr, size_t size)
+{
+	return ofc_arena_block_realloc(
+		ofc_parse_arena__current, ptr, size);
+}
+
+void ofc_parse_free(void* ptr)
+{
+	ofc_arena_block_free(ptr);
+}
+
+bool ofc_parse_arena_owned(const void* ptr)
+{
+	return ofc_arena_block_owned(ptr);
+}
+
+
+ofc_string_t* ofc_parse_string_create(const char* base, unsigned size)
+{
+	/* Allocated as a single block so no separate free of base is needed. */
+	ofc_string_t* string
+		= (ofc_string_t*)ofc_parse_alloc(
+			sizeof(ofc_string_t) + (size > 0 ? (size + 1) : 0));
+	if (!string) return NULL;
+
+	string->base = (size == 0 ? NULL : (char*)&string[1]);
+	string->size = size;
+	if (string->base)
+	{
+		if (base)
+		{
+			memcpy(string->base, base, size);
+			string->base[size] = '\0';
+		}
+		else
+		{
+			memset(string->base, '\0', (size + 1));
+		}
+	}
+
+	return string;
+}
+
+ofc_string_t* ofc_parse_string_copy(const ofc_string_t* src)
+{
+	if (!src)
+		return NULL;
+
+	return ofc_parse_string_create(
+		src->base, src->size);
+}
+
+void ofc_parse_string_delete(ofc_string_t* string)
+{
+	ofc_parse_free(string);
+}
+
+bool ofc_parse_string_deserialize(
+	ofc_serial_t* serial, ofc_string_t** string)
+{
+	const char* base;
+	unsigned    size;
+	if (!string || !ofc_serial_read_string(
+		serial, &base, &size))
+		return false;
+
+	if (!base)
+	{
+		*string = NULL;
+		return true;
+	}
+
+	*string = ofc_parse_string_create(base, size);
+	return (*string != NULL);
+}
@@ -73,7 +73,7 @@ static ofc_parse_array_range_t* ofc_parse_array__range(
 	}
 
 	ofc_parse_array_range_t* range
-		= (ofc_parse_array_range_t*)malloc(
+		= (ofc_parse_array_range_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_array_range_t));
 	if (!range)
 	{
@@ -104,7 +104,7 @@ static void ofc_parse_array__range_delete(
 	ofc_parse_expr_delete(range->first);
 	ofc_parse_expr_delete(range->last);
 	ofc_parse_expr_delete(range->stride);
-	free(range);
+	ofc_parse_free(range);
 }
 
 static ofc_parse_array_range_t* ofc_parse_array__range_copy(
@@ -114,7 +114,7 @@ static ofc_parse_array_range_t* ofc_parse_array__range_copy(
 		return NULL;
 
 	ofc_parse_array_range_t* copy
-		= (ofc_parse_array_range_t*)malloc(
+		= (ofc_parse_array_range_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_array_range_t));
 	if (!copy) return NULL;
 
@@ -184,7 +184,7 @@ static bool ofc_parse_array__range_print(
 
 
 
-ofc_parse_array_index_t* ofc_parse_array_index(
+static ofc_parse_array_index_t* ofc_parse_array__index(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
 	unsigned* len)
@@ -194,7 +194,7 @@ ofc_parse_array_index_t* ofc_parse_array_index(
 		return NULL;
 
 	ofc_parse_array_index_t* index
-		= (ofc_parse_array_index_t*)malloc(
+		= (ofc_parse_array_index_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_array_index_t));
 	if (!index) return NULL;
 
@@ -210,7 +210,7 @@ ofc_parse_array_index_t* ofc_parse_array_index(
 		(void*)ofc_parse_array__range_delete);
 	if (l == 0)
 	{
-		free(index);
+		ofc_parse_free(index);
 		return NULL;
 	}
 	i += l;
@@ -228,6 +228,37 @@ ofc_parse_array_index_t* ofc_parse_array_index(
 	return index;
 }
 
+ofc_parse_array_index_t* ofc_parse_array_index(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	unsigned* len)
+{
+	void*    node;
+	unsigned i;
+	if (ofc_parse_memo_find(
+		OFC_PARSE_MEMO_ARRAY_INDEX, ptr, &node, &i))
+	{
+		if (node && len) *len = i;
+		return (ofc_parse_array_index_t*)node;
+	}
+
+	unsigned dpos = ofc_parse_debug_position(debug);
+
+	i = 0;
+	ofc_parse_array_index_t* index
+		= ofc_parse_array__index(src, ptr, debug, &i);
+
+	/* A shared result wouldn't raise its messages again. */
+	if (ofc_parse_debug_position(debug) == dpos)
+	{
+		ofc_parse_memo_add(
+			OFC_PARSE_MEMO_ARRAY_INDEX, ptr, index, i);
+	}
+
+	if (index && len) *len = i;
+	return index;
+}
+
 ofc_parse_array_index_t* ofc_parse_array_index_copy(
 	const ofc_parse_array_index_t* index)
 {
@@ -235,7 +266,7 @@ ofc_parse_array_index_t* ofc_parse_array_index_copy(
 		return NULL;
 
 	ofc_parse_array_index_t* copy
-		= (ofc_parse_array_index_t*)malloc(
+		= (ofc_parse_array_index_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_array_index_t));
 	if (!copy) return NULL;
 
@@ -248,7 +279,7 @@ ofc_parse_array_index_t* ofc_parse_array_index_copy(
 		(void*)ofc_parse_array__range_copy,
 		(void*)ofc_parse_array__range_delete))
 	{
-		free(copy);
+		ofc_parse_free(copy);
 		return NULL;
 	}
 
@@ -264,7 +295,7 @@ void ofc_parse_array_index_delete(
 	ofc_parse_list_delete(
 		index->count, (void**)index->range,
 		(void*)ofc_parse_array__range_delete);
-	free(index);
+	ofc_parse_free(index);
 }
 
 bool ofc_parse_array_index_print(
@@ -294,3 +325,92 @@ bool ofc_parse_array_index_print(
 
 	return true;
 }
+
+
+static bool ofc_parse_array__range_serialize(
+	ofc_serial_t* serial, const ofc_parse_array_range_t* range)
+{
+	if (!ofc_serial_write_bool(serial, (range != NULL)))
+		return false;
+
+	return (!range
+		|| (ofc_serial_write_str_ref(serial, range->src)
+			&& ofc_serial_write_bool(serial, range->is_slice)
+			&& ofc_parse_expr_serialize(serial, range->first)
+			&& ofc_parse_expr_serialize(serial, range->last)
+			&& ofc_parse_expr_serialize(serial, range->stride)));
+}
+
+static bool ofc_parse_array__range_deserialize(
+	ofc_serial_t* serial, ofc_parse_array_range_t** range)
+{
+	bool present;
+	if (!range || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*range = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_array_range_t* r
+		= (ofc_parse_array_range_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_array_range_t));
+	if (!r) return false;
+
+	r->first  = NULL;
+	r->last   = NULL;
+	r->stride = NULL;
+
+	if (!ofc_serial_read_str_ref(serial, &r->src)
+		|| !ofc_serial_read_bool(serial, &r->is_slice)
+		|| !ofc_parse_expr_deserialize(serial, &r->first)
+		|| !ofc_parse_expr_deserialize(serial, &r->last)
+		|| !ofc_parse_expr_deserialize(serial, &r->stride))
+	{
+		ofc_parse_array__range_delete(r);
+		return false;
+	}
+
+	*range = r;
+	return true;
+}
+
+bool ofc_parse_array_index_serialize(
+	ofc_serial_t* serial, const ofc_parse_array_index_t* index)
+{
+	if (!ofc_serial_write_bool(serial, (index != NULL)))
+		return false;
+
+	return (!index || ofc_parse_list_serialize(
+		serial, index->count, (const void**)index->range,
+		(void*)ofc_parse_array__range_serialize));
+}
+
+bool ofc_parse_array_index_deserialize(
+	ofc_serial_t* serial, ofc_parse_array_index_t** index)
+{
+	bool present;
+	if (!index || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*index = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_array_index_t* i
+		= (ofc_parse_array_index_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_array_index_t));
+	if (!i) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &i->count, (void***)&i->range,
+		(void*)ofc_parse_array__range_deserialize,
+		(void*)ofc_parse_array__range_delete))
+	{
+		ofc_parse_free(i);
+		return false;
+	}
+
+	*index = i;
+	return true;
+}
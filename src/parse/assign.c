@@ -46,7 +46,7 @@ ofc_parse_assign_t* ofc_parse_assign(
 	}
 
 	ofc_parse_assign_t* assign
-		= (ofc_parse_assign_t*)malloc(
+		= (ofc_parse_assign_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_assign_t));
 	if (!assign)
 	{
@@ -95,7 +95,7 @@ ofc_parse_assign_t* ofc_parse_assign_copy(
 		return NULL;
 
 	ofc_parse_assign_t* copy
-		= (ofc_parse_assign_t*)malloc(
+		= (ofc_parse_assign_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_assign_t));
 	if (!copy) return NULL;
 
@@ -120,7 +120,7 @@ void ofc_parse_assign_delete(
 
 	ofc_parse_expr_delete(assign->init);
 	ofc_parse_lhs_delete(assign->name);
-	free(assign);
+	ofc_parse_free(assign);
 }
 
 bool ofc_parse_assign_print(
@@ -151,7 +151,7 @@ ofc_parse_assign_list_t* ofc_parse_assign_list(
 	unsigned* len)
 {
 	ofc_parse_assign_list_t* list
-		= (ofc_parse_assign_list_t*)malloc(
+		= (ofc_parse_assign_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_assign_list_t));
 	if (!list) return NULL;
 
@@ -176,7 +176,7 @@ ofc_parse_assign_list_t* ofc_parse_assign_list_copy(
 		return NULL;
 
 	ofc_parse_assign_list_t* copy
-		= (ofc_parse_assign_list_t*)malloc(
+		= (ofc_parse_assign_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_assign_list_t));
 	if (!copy) return NULL;
 
@@ -189,7 +189,7 @@ ofc_parse_assign_list_t* ofc_parse_assign_list_copy(
 		(void*)ofc_parse_assign_copy,
 		(void*)ofc_parse_assign_delete))
 	{
-		free(copy);
+		ofc_parse_free(copy);
 		return NULL;
 	}
 
@@ -206,7 +206,7 @@ void ofc_parse_assign_list_delete(
 		list->count, (void**)list->assign,
 		(void*)ofc_parse_assign_delete);
 
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_assign_list_print(
@@ -228,3 +228,86 @@ bool ofc_parse_assign_list_print(
 
 	return (i > 0);
 }
+
+bool ofc_parse_assign_serialize(
+	ofc_serial_t* serial, const ofc_parse_assign_t* assign)
+{
+	if (!ofc_serial_write_bool(serial, (assign != NULL)))
+		return false;
+
+	return (!assign
+		|| (ofc_serial_write_str_ref(serial, assign->src)
+			&& ofc_parse_lhs_serialize(serial, assign->name)
+			&& ofc_parse_expr_serialize(serial, assign->init)));
+}
+
+bool ofc_parse_assign_deserialize(
+	ofc_serial_t* serial, ofc_parse_assign_t** assign)
+{
+	bool present;
+	if (!assign || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*assign = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_assign_t* n
+		= (ofc_parse_assign_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_assign_t));
+	if (!n) return false;
+
+	n->name = NULL;
+	n->init = NULL;
+
+	if (!ofc_serial_read_str_ref(serial, &n->src)
+		|| !ofc_parse_lhs_deserialize(serial, &n->name)
+		|| !ofc_parse_expr_deserialize(serial, &n->init))
+	{
+		ofc_parse_assign_delete(n);
+		return false;
+	}
+
+	*assign = n;
+	return true;
+}
+
+bool ofc_parse_assign_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_assign_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->assign,
+		(void*)ofc_parse_assign_serialize));
+}
+
+bool ofc_parse_assign_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_assign_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_assign_list_t* l
+		= (ofc_parse_assign_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_assign_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->assign,
+		(void*)ofc_parse_assign_deserialize,
+		(void*)ofc_parse_assign_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
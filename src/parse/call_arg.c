@@ -22,7 +22,7 @@ static ofc_parse_call_arg_t* ofc_parse__call_arg(
 	bool named, bool force, unsigned* len)
 {
 	ofc_parse_call_arg_t* call_arg
-		= (ofc_parse_call_arg_t*)malloc(
+		= (ofc_parse_call_arg_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_call_arg_t));
 	if (!call_arg) return NULL;
 
@@ -42,7 +42,7 @@ static ofc_parse_call_arg_t* ofc_parse__call_arg(
 		}
 		else if (force)
 		{
-			free(call_arg);
+			ofc_parse_free(call_arg);
 			ofc_parse_debug_rewind(debug, dpos);
 			return NULL;
 		}
@@ -68,7 +68,7 @@ static ofc_parse_call_arg_t* ofc_parse__call_arg(
 			src, &ptr[i], debug, &l);
 		if (!call_arg->expr)
 		{
-			free(call_arg);
+			ofc_parse_free(call_arg);
 			ofc_parse_debug_rewind(debug, dpos);
 			return NULL;
 		}
@@ -119,7 +119,7 @@ void ofc_parse_call_arg_delete(
 		return;
 
 	ofc_parse_expr_delete(call_arg->expr);
-	free(call_arg);
+	ofc_parse_free(call_arg);
 }
 
 bool ofc_parse_call_arg_print(
@@ -169,7 +169,7 @@ static ofc_parse_call_arg_list_t* ofc_parse_call_arg__list(
 	bool named, bool force, unsigned* len)
 {
 	ofc_parse_call_arg_list_t* list
-		= (ofc_parse_call_arg_list_t*)malloc(
+		= (ofc_parse_call_arg_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_call_arg_list_t));
 	if (!list) return NULL;
 
@@ -184,7 +184,7 @@ static ofc_parse_call_arg_list_t* ofc_parse_call_arg__list(
 		(void*)ofc_parse_call_arg_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -226,15 +226,15 @@ ofc_parse_call_arg_list_t* ofc_parse_call_arg_list_wrap(
 		return NULL;
 
 	ofc_parse_call_arg_list_t* list
-		= (ofc_parse_call_arg_list_t*)malloc(
+		= (ofc_parse_call_arg_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_call_arg_list_t));
 	if (!list) return NULL;
 
-	list->call_arg = (ofc_parse_call_arg_t**)malloc(
+	list->call_arg = (ofc_parse_call_arg_t**)ofc_parse_alloc(
 		sizeof(ofc_parse_call_arg_t*));
 	if (!list->call_arg)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -253,7 +253,7 @@ void ofc_parse_call_arg_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->call_arg,
 		(void*)ofc_parse_call_arg_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_call_arg_list_print(
@@ -263,3 +263,84 @@ bool ofc_parse_call_arg_list_print(
 		cs, list->count, (const void**)list->call_arg,
 		(void*)ofc_parse_call_arg_print);
 }
+
+bool ofc_parse_call_arg_serialize(
+	ofc_serial_t* serial, const ofc_parse_call_arg_t* call_arg)
+{
+	if (!call_arg)
+		return false;
+
+	return (ofc_serial_write_str_ref(serial, call_arg->src)
+		&& ofc_serial_write_uint(serial, call_arg->type)
+		&& ofc_serial_write_str_ref(serial, call_arg->name)
+		&& ofc_parse_expr_serialize(serial, call_arg->expr));
+}
+
+bool ofc_parse_call_arg_deserialize(
+	ofc_serial_t* serial, ofc_parse_call_arg_t** call_arg)
+{
+	if (!call_arg)
+		return false;
+
+	ofc_parse_call_arg_t* n
+		= (ofc_parse_call_arg_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_call_arg_t));
+	if (!n) return false;
+
+	n->expr = NULL;
+
+	unsigned type;
+	if (!ofc_serial_read_str_ref(serial, &n->src)
+		|| !ofc_serial_read_unsigned(serial, &type)
+		|| (type > OFC_PARSE_CALL_ARG_ASTERISK)
+		|| !ofc_serial_read_str_ref(serial, &n->name)
+		|| !ofc_parse_expr_deserialize(serial, &n->expr))
+	{
+		ofc_parse_call_arg_delete(n);
+		return false;
+	}
+	n->type = type;
+
+	*call_arg = n;
+	return true;
+}
+
+bool ofc_parse_call_arg_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_call_arg_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->call_arg,
+		(void*)ofc_parse_call_arg_serialize));
+}
+
+bool ofc_parse_call_arg_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_call_arg_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_call_arg_list_t* l
+		= (ofc_parse_call_arg_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_call_arg_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->call_arg,
+		(void*)ofc_parse_call_arg_deserialize,
+		(void*)ofc_parse_call_arg_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
@@ -42,7 +42,7 @@ ofc_parse_common_group_t* ofc_parse_common_group(
 	}
 
 	ofc_parse_common_group_t* common
-		= (ofc_parse_common_group_t*)malloc(
+		= (ofc_parse_common_group_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_common_group_t));
 	if (!common)
 	{
@@ -56,7 +56,7 @@ ofc_parse_common_group_t* ofc_parse_common_group(
 			src, &ptr[i], debug, &l);
 	if (!common->names)
 	{
-		free(common);
+		ofc_parse_free(common);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -75,7 +75,7 @@ void ofc_parse_common_group_delete(
 		return;
 
 	ofc_parse_lhs_list_delete(group->names);
-	free(group);
+	ofc_parse_free(group);
 }
 
 bool ofc_parse_common_group_print(
@@ -105,7 +105,7 @@ ofc_parse_common_group_list_t* ofc_parse_common_group_list(
 	unsigned* len)
 {
 	ofc_parse_common_group_list_t* list
-		= (ofc_parse_common_group_list_t*)malloc(
+		= (ofc_parse_common_group_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_common_group_list_t));
 	if (!list) return NULL;
 
@@ -119,7 +119,7 @@ ofc_parse_common_group_list_t* ofc_parse_common_group_list(
 		(void*)ofc_parse_common_group_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -136,7 +136,7 @@ void ofc_parse_common_group_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->group,
 		(void*)ofc_parse_common_group_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_common_group_list_print(
@@ -149,3 +149,83 @@ bool ofc_parse_common_group_list_print(
 		list->count, (const void**)list->group,
 		(void*)ofc_parse_common_group_print);
 }
+
+bool ofc_parse_common_group_serialize(
+	ofc_serial_t* serial, const ofc_parse_common_group_t* group)
+{
+	if (!ofc_serial_write_bool(serial, (group != NULL)))
+		return false;
+
+	return (!group
+		|| (ofc_serial_write_str_ref(serial, group->group)
+			&& ofc_parse_lhs_list_serialize(serial, group->names)));
+}
+
+bool ofc_parse_common_group_deserialize(
+	ofc_serial_t* serial, ofc_parse_common_group_t** group)
+{
+	bool present;
+	if (!group || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*group = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_common_group_t* n
+		= (ofc_parse_common_group_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_common_group_t));
+	if (!n) return false;
+
+	n->names = NULL;
+
+	if (!ofc_serial_read_str_ref(serial, &n->group)
+		|| !ofc_parse_lhs_list_deserialize(serial, &n->names))
+	{
+		ofc_parse_common_group_delete(n);
+		return false;
+	}
+
+	*group = n;
+	return true;
+}
+
+bool ofc_parse_common_group_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_common_group_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->group,
+		(void*)ofc_parse_common_group_serialize));
+}
+
+bool ofc_parse_common_group_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_common_group_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_common_group_list_t* l
+		= (ofc_parse_common_group_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_common_group_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->group,
+		(void*)ofc_parse_common_group_deserialize,
+		(void*)ofc_parse_common_group_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
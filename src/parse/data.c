@@ -24,7 +24,7 @@ static ofc_parse_clist_entry_t* ofc_parse_clist_entry(
 	unsigned dpos = ofc_parse_debug_position(debug);
 
 	ofc_parse_clist_entry_t* entry
-		= (ofc_parse_clist_entry_t*)malloc(
+		= (ofc_parse_clist_entry_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_clist_entry_t));
 	if (!entry) return NULL;
 
@@ -46,7 +46,7 @@ static ofc_parse_clist_entry_t* ofc_parse_clist_entry(
 		src, &ptr[i], debug, &l);
 	if (!entry->expr)
 	{
-		free(entry);
+		ofc_parse_free(entry);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -63,7 +63,7 @@ static void ofc_parse_clist_entry_delete(
 		return;
 
 	ofc_parse_expr_delete(entry->expr);
-	free(entry);
+	ofc_parse_free(entry);
 }
 
 static bool ofc_parse_clist_entry_print(
@@ -93,7 +93,7 @@ ofc_parse_clist_t* ofc_parse_clist(
 		return NULL;
 
 	ofc_parse_clist_t* list
-		= (ofc_parse_clist_t*)malloc(
+		= (ofc_parse_clist_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_clist_t));
 	if (!list) return NULL;
 
@@ -108,7 +108,7 @@ ofc_parse_clist_t* ofc_parse_clist(
 	if (l == 0)
 	{
 		/* clist may not be empty. */
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 	i += l;
@@ -133,7 +133,7 @@ void ofc_parse_clist_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->entry,
 		(void*)ofc_parse_clist_entry_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_clist_print(
@@ -155,7 +155,7 @@ static ofc_parse_data_entry_t* ofc_parse_data_entry(
 	unsigned* len)
 {
 	ofc_parse_data_entry_t* entry
-		= (ofc_parse_data_entry_t*)malloc(
+		= (ofc_parse_data_entry_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_data_entry_t));
 	if (!entry) return NULL;
 
@@ -166,7 +166,7 @@ static ofc_parse_data_entry_t* ofc_parse_data_entry(
 		src, ptr, debug, &i);
 	if (!entry->nlist)
 	{
-		free(entry);
+		ofc_parse_free(entry);
 		return NULL;
 	}
 
@@ -176,7 +176,7 @@ static ofc_parse_data_entry_t* ofc_parse_data_entry(
 	if (!entry->clist)
 	{
 		ofc_parse_lhs_list_delete(entry->nlist);
-		free(entry);
+		ofc_parse_free(entry);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -194,7 +194,7 @@ static void ofc_parse_data_entry_delete(
 
 	ofc_parse_lhs_list_delete(entry->nlist);
 	ofc_parse_clist_delete(entry->clist);
-	free(entry);
+	ofc_parse_free(entry);
 }
 
 static bool ofc_parse_data_entry_print(
@@ -216,7 +216,7 @@ ofc_parse_data_list_t* ofc_parse_data_list(
 	unsigned* len)
 {
 	ofc_parse_data_list_t* list
-		= (ofc_parse_data_list_t*)malloc(
+		= (ofc_parse_data_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_data_list_t));
 	if (!list) return NULL;
 
@@ -231,7 +231,7 @@ ofc_parse_data_list_t* ofc_parse_data_list(
 	if (i == 0)
 	{
 		/* data_list may not be empty. */
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -248,7 +248,7 @@ void ofc_parse_data_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->entry,
 		(void*)ofc_parse_data_entry_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_data_list_print(
@@ -261,3 +261,152 @@ bool ofc_parse_data_list_print(
 		list->count, (const void**)list->entry,
 		(void*)ofc_parse_data_entry_print);
 }
+
+static bool ofc_parse_clist_entry_serialize(
+	ofc_serial_t* serial, const ofc_parse_clist_entry_t* entry)
+{
+	if (!entry)
+		return false;
+
+	return (ofc_serial_write_uint(serial, entry->repeat)
+		&& ofc_parse_expr_serialize(serial, entry->expr));
+}
+
+static bool ofc_parse_clist_entry_deserialize(
+	ofc_serial_t* serial, ofc_parse_clist_entry_t** entry)
+{
+	if (!entry)
+		return false;
+
+	ofc_parse_clist_entry_t* n
+		= (ofc_parse_clist_entry_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_clist_entry_t));
+	if (!n) return false;
+
+	n->expr = NULL;
+
+	if (!ofc_serial_read_unsigned(serial, &n->repeat)
+		|| !ofc_parse_expr_deserialize(serial, &n->expr))
+	{
+		ofc_parse_clist_entry_delete(n);
+		return false;
+	}
+
+	*entry = n;
+	return true;
+}
+
+bool ofc_parse_clist_serialize(
+	ofc_serial_t* serial, const ofc_parse_clist_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->entry,
+		(void*)ofc_parse_clist_entry_serialize));
+}
+
+bool ofc_parse_clist_deserialize(
+	ofc_serial_t* serial, ofc_parse_clist_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_clist_t* l
+		= (ofc_parse_clist_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_clist_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->entry,
+		(void*)ofc_parse_clist_entry_deserialize,
+		(void*)ofc_parse_clist_entry_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
+
+static bool ofc_parse_data_entry_serialize(
+	ofc_serial_t* serial, const ofc_parse_data_entry_t* entry)
+{
+	if (!entry)
+		return false;
+
+	return (ofc_parse_lhs_list_serialize(serial, entry->nlist)
+		&& ofc_parse_clist_serialize(serial, entry->clist));
+}
+
+static bool ofc_parse_data_entry_deserialize(
+	ofc_serial_t* serial, ofc_parse_data_entry_t** entry)
+{
+	if (!entry)
+		return false;
+
+	ofc_parse_data_entry_t* n
+		= (ofc_parse_data_entry_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_data_entry_t));
+	if (!n) return false;
+
+	n->nlist = NULL;
+	n->clist = NULL;
+
+	if (!ofc_parse_lhs_list_deserialize(serial, &n->nlist)
+		|| !ofc_parse_clist_deserialize(serial, &n->clist))
+	{
+		ofc_parse_data_entry_delete(n);
+		return false;
+	}
+
+	*entry = n;
+	return true;
+}
+
+bool ofc_parse_data_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_data_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->entry,
+		(void*)ofc_parse_data_entry_serialize));
+}
+
+bool ofc_parse_data_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_data_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_data_list_t* l
+		= (ofc_parse_data_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_data_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->entry,
+		(void*)ofc_parse_data_entry_deserialize,
+		(void*)ofc_parse_data_entry_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
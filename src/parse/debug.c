@@ -16,17 +16,39 @@
 #include <ofc/parse/debug.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+
+/* Most messages are raised by speculative parses and rewound soon
+   after, so we only capture the format and arguments here and leave
+   formatting to ofc_parse_debug_print. */
+
+typedef union
+{
+	intmax_t    i;
+	uintmax_t   u;
+	long double f;
+	const void* p;
+} ofc_parse_debug_arg_t;
 
 typedef struct
 {
 	ofc_sparse_ref_t ref;
-	char*            message;
+	const char*      format;
+	unsigned         arg;
+	bool             raw;
 } ofc_parse_debug_msg_t;
 
 struct ofc_parse_debug_s
 {
-	unsigned                count, max;
-	ofc_parse_debug_msg_t** message;
+	unsigned               count, max;
+	ofc_parse_debug_msg_t* message;
+
+	unsigned               arg_count, arg_max;
+	ofc_parse_debug_arg_t* arg;
 };
 
 
@@ -42,6 +64,10 @@ ofc_parse_debug_t* ofc_parse_debug_create(void)
 	stack->max     = 0;
 	stack->message = NULL;
 
+	stack->arg_count = 0;
+	stack->arg_max   = 0;
+	stack->arg       = NULL;
+
 	return stack;
 }
 
@@ -50,14 +76,7 @@ void ofc_parse_debug_delete(ofc_parse_debug_t* stack)
 	if (!stack)
 		return;
 
-	unsigned i;
-	for (i = 0; i < stack->count; i++)
-	{
-		if (!stack->message[i])
-			continue;
-		free(stack->message[i]->message);
-		free(stack->message[i]);
-	}
+	free(stack->arg);
 	free(stack->message);
 	free(stack);
 }
@@ -71,21 +90,437 @@ unsigned ofc_parse_debug_position(const ofc_parse_debug_t* stack)
 void ofc_parse_debug_rewind(
 	ofc_parse_debug_t* stack, unsigned position)
 {
-	if (!stack)
+	if (!stack || (position >= stack->count))
 		return;
 
-	unsigned i;
-	for (i = position; i < stack->count; i++)
+	stack->arg_count = stack->message[position].arg;
+	stack->count = position;
+}
+
+
+/* A conversion specification, split so that it can be rebuilt
+   with any '*' width or precision replaced by its argument. */
+typedef struct
+{
+	const char* flags;
+	unsigned    flags_len;
+	const char* width;
+	unsigned    width_len;
+	const char* prec;
+	unsigned    prec_len;
+	unsigned    length;
+	char        conv;
+	unsigned    size;
+} ofc_parse_debug_spec_t;
+
+enum
+{
+	OFC_PARSE_DEBUG_LENGTH_NONE = 0,
+	OFC_PARSE_DEBUG_LENGTH_HH,
+	OFC_PARSE_DEBUG_LENGTH_H,
+	OFC_PARSE_DEBUG_LENGTH_L,
+	OFC_PARSE_DEBUG_LENGTH_LL,
+	OFC_PARSE_DEBUG_LENGTH_J,
+	OFC_PARSE_DEBUG_LENGTH_Z,
+	OFC_PARSE_DEBUG_LENGTH_T,
+	OFC_PARSE_DEBUG_LENGTH_LD,
+};
+
+static bool ofc_parse_debug__spec(
+	const char* ptr, ofc_parse_debug_spec_t* spec)
+{
+	/* ptr points just after the '%'. */
+	unsigned i = 0;
+
+	spec->flags = &ptr[i];
+	while ((ptr[i] != '\0') && strchr("-+ #0", ptr[i]))
+		i++;
+	spec->flags_len = (&ptr[i] - spec->flags);
+
+	spec->width = &ptr[i];
+	if (ptr[i] == '*')
+		i++;
+	else
+	{
+		while ((ptr[i] >= '0') && (ptr[i] <= '9'))
+			i++;
+	}
+	spec->width_len = (&ptr[i] - spec->width);
+
+	spec->prec = NULL;
+	spec->prec_len = 0;
+	if (ptr[i] == '.')
+	{
+		i++;
+		spec->prec = &ptr[i];
+		if (ptr[i] == '*')
+			i++;
+		else
+		{
+			while ((ptr[i] >= '0') && (ptr[i] <= '9'))
+				i++;
+		}
+		spec->prec_len = (&ptr[i] - spec->prec);
+	}
+
+	spec->length = OFC_PARSE_DEBUG_LENGTH_NONE;
+	switch (ptr[i])
+	{
+		case 'h':
+			i++;
+			spec->length = OFC_PARSE_DEBUG_LENGTH_H;
+			if (ptr[i] == 'h')
+			{
+				i++;
+				spec->length = OFC_PARSE_DEBUG_LENGTH_HH;
+			}
+			break;
+		case 'l':
+			i++;
+			spec->length = OFC_PARSE_DEBUG_LENGTH_L;
+			if (ptr[i] == 'l')
+			{
+				i++;
+				spec->length = OFC_PARSE_DEBUG_LENGTH_LL;
+			}
+			break;
+		case 'j':
+			i++;
+			spec->length = OFC_PARSE_DEBUG_LENGTH_J;
+			break;
+		case 'z':
+			i++;
+			spec->length = OFC_PARSE_DEBUG_LENGTH_Z;
+			break;
+		case 't':
+			i++;
+			spec->length = OFC_PARSE_DEBUG_LENGTH_T;
+			break;
+		case 'L':
+			i++;
+			spec->length = OFC_PARSE_DEBUG_LENGTH_LD;
+			break;
+		default:
+			break;
+	}
+
+	/* Anything we can't capture or rebuild is rejected here,
+	   that includes specifications too long to rebuild. */
+	spec->conv = ptr[i];
+	if ((spec->conv == '\0')
+		|| !strchr("diouxXcsp%eEfFgGaA", spec->conv))
+		return false;
+	if ((spec->flags_len + spec->width_len + spec->prec_len) > 32)
+		return false;
+	i++;
+
+	spec->size = i;
+	return true;
+}
+
+static void ofc_parse_debug__arg_push(
+	ofc_parse_debug_t* stack, const ofc_parse_debug_arg_t* arg)
+{
+	if (stack->arg_count >= stack->arg_max)
 	{
-		if (!stack->message[i])
+		unsigned nmax = (stack->arg_max << 1);
+		if (nmax == 0) nmax = 16;
+		ofc_parse_debug_arg_t* narg
+			= (ofc_parse_debug_arg_t*)realloc(stack->arg,
+				sizeof(ofc_parse_debug_arg_t) * nmax);
+		if (!narg) abort();
+		stack->arg = narg;
+		stack->arg_max = nmax;
+	}
+
+	stack->arg[stack->arg_count++] = *arg;
+}
+
+/* Pull each argument off the list in the type the format gives it,
+   narrowing integers here so printing can always use intmax_t.
+   Returns false if the format has a specification we don't know,
+   since the arguments after it can't be found. */
+static bool ofc_parse_debug__capture(
+	ofc_parse_debug_t* stack,
+	const char* format, va_list args)
+{
+	const char* ptr;
+	for (ptr = format; *ptr != '\0'; ptr++)
+	{
+		if (*ptr != '%')
 			continue;
 
-		free(stack->message[i]->message);
-		free(stack->message[i]);
-		stack->message[i] = NULL;
+		ofc_parse_debug_spec_t spec;
+		if (!ofc_parse_debug__spec(&ptr[1], &spec))
+			return false;
+		ptr += spec.size;
+
+		ofc_parse_debug_arg_t arg;
+		if ((spec.width_len == 1) && (spec.width[0] == '*'))
+		{
+			arg.i = va_arg(args, int);
+			ofc_parse_debug__arg_push(stack, &arg);
+		}
+		if ((spec.prec_len == 1) && (spec.prec[0] == '*'))
+		{
+			arg.i = va_arg(args, int);
+			ofc_parse_debug__arg_push(stack, &arg);
+		}
+
+		switch (spec.conv)
+		{
+			case '%':
+				continue;
+
+			case 'd':
+			case 'i':
+				switch (spec.length)
+				{
+					case OFC_PARSE_DEBUG_LENGTH_HH:
+						arg.i = (signed char)va_arg(args, int);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_H:
+						arg.i = (short)va_arg(args, int);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_L:
+						arg.i = va_arg(args, long);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_LL:
+						arg.i = va_arg(args, long long);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_J:
+						arg.i = va_arg(args, intmax_t);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_Z:
+						arg.i = va_arg(args, ssize_t);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_T:
+						arg.i = va_arg(args, ptrdiff_t);
+						break;
+					default:
+						arg.i = va_arg(args, int);
+						break;
+				}
+				break;
+
+			case 'o':
+			case 'u':
+			case 'x':
+			case 'X':
+				switch (spec.length)
+				{
+					case OFC_PARSE_DEBUG_LENGTH_HH:
+						arg.u = (unsigned char)va_arg(args, unsigned);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_H:
+						arg.u = (unsigned short)va_arg(args, unsigned);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_L:
+						arg.u = va_arg(args, unsigned long);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_LL:
+						arg.u = va_arg(args, unsigned long long);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_J:
+						arg.u = va_arg(args, uintmax_t);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_Z:
+						arg.u = va_arg(args, size_t);
+						break;
+					case OFC_PARSE_DEBUG_LENGTH_T:
+						arg.u = (uintmax_t)va_arg(args, ptrdiff_t);
+						break;
+					default:
+						arg.u = va_arg(args, unsigned);
+						break;
+				}
+				break;
+
+			case 'c':
+				arg.i = va_arg(args, int);
+				break;
+
+			case 's':
+			case 'p':
+				arg.p = va_arg(args, const void*);
+				break;
+
+			default:
+				if (spec.length == OFC_PARSE_DEBUG_LENGTH_LD)
+					arg.f = va_arg(args, long double);
+				else
+					arg.f = va_arg(args, double);
+				break;
+		}
+
+		ofc_parse_debug__arg_push(stack, &arg);
 	}
 
-	stack->count = position;
+	return true;
+}
+
+static void ofc_parse_debug__append(
+	char** buff, unsigned* len, unsigned* max,
+	const char* format, ...)
+	__attribute__ ((format (printf, 4, 5)));
+
+static void ofc_parse_debug__append(
+	char** buff, unsigned* len, unsigned* max,
+	const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int size = vsnprintf(NULL, 0, format, args);
+	va_end(args);
+
+	if (size < 0) abort();
+
+	unsigned nlen = (*len + size);
+	if (nlen >= *max)
+	{
+		unsigned nmax = (*max << 1);
+		if (nmax <= nlen) nmax = (nlen + 64);
+		char* nbuff = (char*)realloc(*buff, nmax);
+		if (!nbuff) abort();
+		*buff = nbuff;
+		*max = nmax;
+	}
+
+	va_start(args, format);
+	vsnprintf(&(*buff)[*len], (*max - *len), format, args);
+	va_end(args);
+
+	*len = nlen;
+}
+
+static void ofc_parse_debug__format(
+	const ofc_parse_debug_t* stack,
+	const ofc_parse_debug_msg_t* message,
+	char** buff, unsigned* len, unsigned* max)
+{
+	const ofc_parse_debug_arg_t* arg
+		= &stack->arg[message->arg];
+
+	*len = 0;
+	if (message->raw)
+	{
+		ofc_parse_debug__append(
+			buff, len, max, "%s", message->format);
+		return;
+	}
+	ofc_parse_debug__append(buff, len, max, "%s", "");
+
+	const char* ptr = message->format;
+	while (*ptr != '\0')
+	{
+		unsigned i;
+		for (i = 0; (ptr[i] != '\0') && (ptr[i] != '%'); i++);
+		if (i > 0)
+		{
+			ofc_parse_debug__append(
+				buff, len, max, "%.*s", i, ptr);
+			ptr += i;
+			continue;
+		}
+
+		ofc_parse_debug_spec_t spec;
+		ofc_parse_debug__spec(&ptr[1], &spec);
+		ptr += (spec.size + 1);
+
+		if (spec.conv == '%')
+		{
+			ofc_parse_debug__append(
+				buff, len, max, "%%");
+			continue;
+		}
+
+		/* Rebuild the specification without any '*' or length. */
+		char conv[64];
+		int clen = snprintf(conv, sizeof(conv), "%%%.*s",
+			spec.flags_len, spec.flags);
+
+		if ((spec.width_len == 1) && (spec.width[0] == '*'))
+		{
+			clen += snprintf(&conv[clen], (sizeof(conv) - clen),
+				"%d", (int)(arg++)->i);
+		}
+		else
+		{
+			clen += snprintf(&conv[clen], (sizeof(conv) - clen),
+				"%.*s", spec.width_len, spec.width);
+		}
+
+		if ((spec.prec_len == 1) && (spec.prec[0] == '*'))
+		{
+			int prec = (int)(arg++)->i;
+			if (prec >= 0)
+			{
+				clen += snprintf(&conv[clen], (sizeof(conv) - clen),
+					".%d", prec);
+			}
+		}
+		else if (spec.prec)
+		{
+			clen += snprintf(&conv[clen], (sizeof(conv) - clen),
+				".%.*s", spec.prec_len, spec.prec);
+		}
+
+		switch (spec.conv)
+		{
+			case 'd':
+			case 'i':
+			case 'o':
+			case 'u':
+			case 'x':
+			case 'X':
+				snprintf(&conv[clen], (sizeof(conv) - clen),
+					"j%c", spec.conv);
+				break;
+			case 'c':
+			case 's':
+			case 'p':
+				snprintf(&conv[clen], (sizeof(conv) - clen),
+					"%c", spec.conv);
+				break;
+			default:
+				snprintf(&conv[clen], (sizeof(conv) - clen),
+					"L%c", spec.conv);
+				break;
+		}
+
+		switch (spec.conv)
+		{
+			case 'd':
+			case 'i':
+				ofc_parse_debug__append(
+					buff, len, max, conv, arg->i);
+				break;
+			case 'o':
+			case 'u':
+			case 'x':
+			case 'X':
+				ofc_parse_debug__append(
+					buff, len, max, conv, arg->u);
+				break;
+			case 'c':
+				ofc_parse_debug__append(
+					buff, len, max, conv, (int)arg->i);
+				break;
+			case 's':
+				ofc_parse_debug__append(
+					buff, len, max, conv, (const char*)arg->p);
+				break;
+			case 'p':
+				ofc_parse_debug__append(
+					buff, len, max, conv, arg->p);
+				break;
+			default:
+				ofc_parse_debug__append(
+					buff, len, max, conv, arg->f);
+				break;
+		}
+		arg++;
+	}
 }
 
 void ofc_parse_debug_print(const ofc_parse_debug_t* stack)
@@ -93,16 +528,22 @@ void ofc_parse_debug_print(const ofc_parse_debug_t* stack)
 	if (!stack)
 		return;
 
+	char*    buff = NULL;
+	unsigned len = 0, max = 0;
+
 	unsigned i;
 	for (i = 0; i < stack->count; i++)
 	{
-		ofc_parse_debug_msg_t* message
-			= stack->message[i];
-		if (!message) continue;
+		const ofc_parse_debug_msg_t* message
+			= &stack->message[i];
 
+		ofc_parse_debug__format(
+			stack, message, &buff, &len, &max);
 		ofc_sparse_ref_warning(message->ref,
-			"%s", message->message);
+			"%s", buff);
 	}
+
+	free(buff);
 }
 
 
@@ -115,40 +556,36 @@ static void ofc_parse_debug_message(
 {
 	/* Error reporting is critical, if it fails we just abort. */
 
-	if (!stack)
+	if (!stack || !format)
 		abort();
 
-	ofc_parse_debug_msg_t* message
-		= (ofc_parse_debug_msg_t*)malloc(
-			sizeof(ofc_parse_debug_msg_t));
-	if (!message) abort();
-
-	message->ref = ref;
-
-	va_list largs;
-	va_copy(largs, args);
-	int len = vsnprintf(NULL, 0, format, largs);
-	va_end(largs);
-
-	if (len <= 0) abort();
-
-	message->message = (char*)malloc(len + 1);
-	if (!message->message) abort();
-	vsprintf(message->message, format, args);
-
 	if (stack->count >= stack->max)
 	{
 		unsigned nmax = (stack->max << 1);
 		if (nmax == 0) nmax = 16;
-		ofc_parse_debug_msg_t** nstack
-			= (ofc_parse_debug_msg_t**)realloc(stack->message,
-				sizeof(ofc_parse_debug_msg_t*) * nmax);
+		ofc_parse_debug_msg_t* nstack
+			= (ofc_parse_debug_msg_t*)realloc(stack->message,
+				sizeof(ofc_parse_debug_msg_t) * nmax);
 		if (!nstack) abort();
 		stack->message = nstack;
 		stack->max = nmax;
 	}
 
-	stack->message[stack->count++] = message;
+	ofc_parse_debug_msg_t* message
+		= &stack->message[stack->count];
+	message->ref    = ref;
+	message->format = format;
+	message->arg    = stack->arg_count;
+	message->raw    = false;
+
+	if (!ofc_parse_debug__capture(stack, format, args))
+	{
+		/* Keep the message unformatted rather than lose it. */
+		stack->arg_count = message->arg;
+		message->raw = true;
+	}
+
+	stack->count++;
 }
 
 void ofc_parse_debug_warning(
@@ -22,7 +22,7 @@ ofc_parse_decl_t* ofc_parse_decl(
 	unsigned* len)
 {
 	ofc_parse_decl_t* decl
-		= (ofc_parse_decl_t*)malloc(
+		= (ofc_parse_decl_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_decl_t));
 	if (!decl) return NULL;
 
@@ -31,7 +31,7 @@ ofc_parse_decl_t* ofc_parse_decl(
 		src, ptr, debug, &i);
 	if (!decl->lhs)
 	{
-		free(decl);
+		ofc_parse_free(decl);
 		return NULL;
 	}
 
@@ -66,7 +66,7 @@ void ofc_parse_decl_delete(
 	ofc_parse_clist_delete(decl->init_clist);
 
 	ofc_parse_lhs_delete(decl->lhs);
-	free(decl);
+	ofc_parse_free(decl);
 }
 
 bool ofc_parse_decl_print(
@@ -103,7 +103,7 @@ ofc_parse_decl_list_t* ofc_parse_decl_list(
 	unsigned* len)
 {
 	ofc_parse_decl_list_t* list
-		= (ofc_parse_decl_list_t*)malloc(
+		= (ofc_parse_decl_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_decl_list_t));
 	if (!list) return NULL;
 
@@ -117,7 +117,7 @@ ofc_parse_decl_list_t* ofc_parse_decl_list(
 		(void*)ofc_parse_decl_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -134,7 +134,7 @@ void ofc_parse_decl_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->decl,
 		(void*)ofc_parse_decl_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_decl_list_print(
@@ -144,3 +144,87 @@ bool ofc_parse_decl_list_print(
 		cs, list->count, (const void**)list->decl,
 		(void*)ofc_parse_decl_print);
 }
+
+bool ofc_parse_decl_serialize(
+	ofc_serial_t* serial, const ofc_parse_decl_t* decl)
+{
+	if (!ofc_serial_write_bool(serial, (decl != NULL)))
+		return false;
+
+	return (!decl
+		|| (ofc_parse_lhs_serialize(serial, decl->lhs)
+			&& ofc_parse_expr_serialize(serial, decl->init_expr)
+			&& ofc_parse_clist_serialize(serial, decl->init_clist)));
+}
+
+bool ofc_parse_decl_deserialize(
+	ofc_serial_t* serial, ofc_parse_decl_t** decl)
+{
+	bool present;
+	if (!decl || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*decl = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_decl_t* n
+		= (ofc_parse_decl_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_decl_t));
+	if (!n) return false;
+
+	n->lhs        = NULL;
+	n->init_expr  = NULL;
+	n->init_clist = NULL;
+
+	if (!ofc_parse_lhs_deserialize(serial, &n->lhs)
+		|| !ofc_parse_expr_deserialize(serial, &n->init_expr)
+		|| !ofc_parse_clist_deserialize(serial, &n->init_clist))
+	{
+		ofc_parse_decl_delete(n);
+		return false;
+	}
+
+	*decl = n;
+	return true;
+}
+
+bool ofc_parse_decl_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_decl_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->decl,
+		(void*)ofc_parse_decl_serialize));
+}
+
+bool ofc_parse_decl_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_decl_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_decl_list_t* l
+		= (ofc_parse_decl_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_decl_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->decl,
+		(void*)ofc_parse_decl_deserialize,
+		(void*)ofc_parse_decl_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
@@ -21,7 +21,7 @@ ofc_parse_define_file_arg_t* ofc_parse_define_file_arg(
 	ofc_parse_debug_t* debug, unsigned* len)
 {
 	ofc_parse_define_file_arg_t* define_file_arg
-		= (ofc_parse_define_file_arg_t*)malloc(
+		= (ofc_parse_define_file_arg_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_define_file_arg_t));
 	if (!define_file_arg) return NULL;
 
@@ -38,7 +38,7 @@ ofc_parse_define_file_arg_t* ofc_parse_define_file_arg(
 		src, &ptr[i], debug, &l);
 	if (!define_file_arg->unit)
 	{
-		free(define_file_arg);
+		ofc_parse_free(define_file_arg);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -118,7 +118,7 @@ void ofc_parse_define_file_arg_delete(
 	ofc_parse_expr_delete(define_file_arg->rec);
 	ofc_parse_expr_delete(define_file_arg->len);
 	ofc_parse_lhs_delete(define_file_arg->ascv);
-	free(define_file_arg);
+	ofc_parse_free(define_file_arg);
 }
 
 bool ofc_parse_define_file_arg_print(
@@ -143,7 +143,7 @@ ofc_parse_define_file_arg_list_t* ofc_parse_define_file_arg_list(
 	ofc_parse_debug_t* debug, unsigned* len)
 {
 	ofc_parse_define_file_arg_list_t* list
-		= (ofc_parse_define_file_arg_list_t*)malloc(
+		= (ofc_parse_define_file_arg_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_define_file_arg_list_t));
 	if (!list) return NULL;
 
@@ -156,7 +156,7 @@ ofc_parse_define_file_arg_list_t* ofc_parse_define_file_arg_list(
 		(void*)ofc_parse_define_file_arg_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -173,7 +173,7 @@ void ofc_parse_define_file_arg_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->define_file_arg,
 		(void*)ofc_parse_define_file_arg_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_define_file_arg_list_print(
@@ -183,3 +183,90 @@ bool ofc_parse_define_file_arg_list_print(
 		cs, list->count, (const void**)list->define_file_arg,
 		(void*)ofc_parse_define_file_arg_print);
 }
+
+bool ofc_parse_define_file_arg_serialize(
+	ofc_serial_t* serial, const ofc_parse_define_file_arg_t* define_file_arg)
+{
+	if (!ofc_serial_write_bool(serial, (define_file_arg != NULL)))
+		return false;
+
+	return (!define_file_arg
+		|| (ofc_parse_expr_serialize(serial, define_file_arg->unit)
+			&& ofc_parse_expr_serialize(serial, define_file_arg->rec)
+			&& ofc_parse_expr_serialize(serial, define_file_arg->len)
+			&& ofc_parse_lhs_serialize(serial, define_file_arg->ascv)));
+}
+
+bool ofc_parse_define_file_arg_deserialize(
+	ofc_serial_t* serial, ofc_parse_define_file_arg_t** define_file_arg)
+{
+	bool present;
+	if (!define_file_arg || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*define_file_arg = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_define_file_arg_t* n
+		= (ofc_parse_define_file_arg_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_define_file_arg_t));
+	if (!n) return false;
+
+	n->unit = NULL;
+	n->rec  = NULL;
+	n->len  = NULL;
+	n->ascv = NULL;
+
+	if (!ofc_parse_expr_deserialize(serial, &n->unit)
+		|| !ofc_parse_expr_deserialize(serial, &n->rec)
+		|| !ofc_parse_expr_deserialize(serial, &n->len)
+		|| !ofc_parse_lhs_deserialize(serial, &n->ascv))
+	{
+		ofc_parse_define_file_arg_delete(n);
+		return false;
+	}
+
+	*define_file_arg = n;
+	return true;
+}
+
+bool ofc_parse_define_file_arg_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_define_file_arg_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->define_file_arg,
+		(void*)ofc_parse_define_file_arg_serialize));
+}
+
+bool ofc_parse_define_file_arg_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_define_file_arg_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_define_file_arg_list_t* l
+		= (ofc_parse_define_file_arg_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_define_file_arg_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->define_file_arg,
+		(void*)ofc_parse_define_file_arg_deserialize,
+		(void*)ofc_parse_define_file_arg_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
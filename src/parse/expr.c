@@ -18,29 +18,29 @@
 
 
 static void ofc_parse_expr__cleanup(
-	ofc_parse_expr_t expr)
+	const ofc_parse_expr_t* expr)
 {
-	switch (expr.type)
+	switch (expr->type)
 	{
 		case OFC_PARSE_EXPR_CONSTANT:
-			ofc_parse_literal_cleanup(expr.literal);
+			ofc_parse_literal_cleanup(expr->literal);
 			break;
 
 		case OFC_PARSE_EXPR_VARIABLE:
-			ofc_parse_lhs_delete(expr.variable);
+			ofc_parse_lhs_delete(expr->variable);
 			break;
 
 		case OFC_PARSE_EXPR_BRACKETS:
-			ofc_parse_expr_delete(expr.brackets.expr);
+			ofc_parse_expr_delete(expr->brackets.expr);
 			break;
 
 		case OFC_PARSE_EXPR_UNARY:
-			ofc_parse_expr_delete(expr.unary.a);
+			ofc_parse_expr_delete(expr->unary.a);
 			break;
 
 		case OFC_PARSE_EXPR_BINARY:
-			ofc_parse_expr_delete(expr.binary.a);
-			ofc_parse_expr_delete(expr.binary.b);
+			ofc_parse_expr_delete(expr->binary.a);
+			ofc_parse_expr_delete(expr->binary.b);
 			break;
 
 		default:
@@ -112,28 +112,54 @@ static bool ofc_parse_expr__clone(
 	return true;
 }
 
+#define OFC_PARSE_EXPR__SIZE(member) \
+	(offsetof(ofc_parse_expr_t, member) \
+		+ sizeof(((ofc_parse_expr_t*)NULL)->member))
+
+/* Most nodes in a tree are operators or variables, which are far
+   smaller than a literal, so each type gets a node of its own size. */
+static size_t ofc_parse_expr__size(
+	ofc_parse_expr_e type)
+{
+	switch (type)
+	{
+		case OFC_PARSE_EXPR_VARIABLE:
+			return OFC_PARSE_EXPR__SIZE(variable);
+		case OFC_PARSE_EXPR_BRACKETS:
+			return OFC_PARSE_EXPR__SIZE(brackets);
+		case OFC_PARSE_EXPR_UNARY:
+			return OFC_PARSE_EXPR__SIZE(unary);
+		case OFC_PARSE_EXPR_BINARY:
+			return OFC_PARSE_EXPR__SIZE(binary);
+		default:
+			break;
+	}
+
+	return sizeof(ofc_parse_expr_t);
+}
+
 static ofc_parse_expr_t* ofc_parse_expr__alloc(
-	ofc_parse_expr_t expr)
+	const ofc_parse_expr_t* expr)
 {
+	size_t size = ofc_parse_expr__size(expr->type);
 	ofc_parse_expr_t* aexpr
-		= (ofc_parse_expr_t*)malloc(
-			sizeof(ofc_parse_expr_t));
+		= (ofc_parse_expr_t*)ofc_parse_alloc(size);
 	if (!aexpr) return NULL;
-	*aexpr = expr;
+	memcpy(aexpr, expr, size);
 	return aexpr;
 }
 
 
 
 static unsigned ofc_parse_expr__level(
-	ofc_parse_expr_t expr)
+	const ofc_parse_expr_t* expr)
 {
-	switch (expr.type)
+	switch (expr->type)
 	{
 		case OFC_PARSE_EXPR_UNARY:
-			return ofc_parse_operator_precedence(expr.unary.operator);
+			return ofc_parse_operator_precedence(expr->unary.operator);
 		case OFC_PARSE_EXPR_BINARY:
-			return ofc_parse_operator_precedence(expr.binary.operator);
+			return ofc_parse_operator_precedence(expr->binary.operator);
 		default:
 			break;
 	}
@@ -247,7 +273,7 @@ static unsigned ofc_parse_expr__primary(
 		{
 			if  (ptr[1 + len] != ')')
 			{
-				ofc_parse_expr__cleanup(expr_brackets);
+				ofc_parse_expr__cleanup(&expr_brackets);
 				ofc_parse_debug_rewind(debug, dpos);
 			}
 			else
@@ -255,10 +281,10 @@ static unsigned ofc_parse_expr__primary(
 				len += 2;
 
 				expr->brackets.expr
-					= ofc_parse_expr__alloc(expr_brackets);
+					= ofc_parse_expr__alloc(&expr_brackets);
 				if (!expr->brackets.expr)
 				{
-					ofc_parse_expr__cleanup(expr_brackets);
+					ofc_parse_expr__cleanup(&expr_brackets);
 					ofc_parse_debug_rewind(debug, dpos);
 					return 0;
 				}
@@ -272,57 +298,6 @@ static unsigned ofc_parse_expr__primary(
 	return 0;
 }
 
-static unsigned ofc_parse_expr__unary(
-	const ofc_sparse_t* src, const char* ptr,
-	ofc_parse_debug_t* debug,
-	ofc_parse_expr_t* expr, unsigned level)
-{
-	/* TODO - Defined unary operators. */
-
-	unsigned dpos = ofc_parse_debug_position(debug);
-
-	ofc_parse_operator_e op;
-	unsigned op_len = ofc_parse_operator(
-		src, ptr, debug, &op);
-	if ((op_len == 0)
-		|| !ofc_parse_operator_unary(op))
-	{
-		ofc_parse_debug_rewind(debug, dpos);
-		return 0;
-	}
-
-	unsigned op_level = ofc_parse_operator_precedence(op);
-	if (op_level > level)
-	{
-		ofc_parse_debug_rewind(debug, dpos);
-		return 0;
-	}
-
-	ofc_parse_expr_t a;
-	unsigned a_len = ofc_parse_expr__at_or_below(
-		src, &ptr[op_len], debug, &a, op_level);
-	if (a_len == 0)
-	{
-		ofc_parse_debug_rewind(debug, dpos);
-		return 0;
-	}
-
-	expr->type = OFC_PARSE_EXPR_UNARY;
-	expr->src = ofc_str_ref(ptr, (op_len + a_len));
-
-	expr->unary.operator = op;
-
-	expr->unary.a = ofc_parse_expr__alloc(a);
-	if (!expr->unary.a)
-	{
-		ofc_parse_expr__cleanup(a);
-		ofc_parse_debug_rewind(debug, dpos);
-		return 0;
-	}
-
-	return (op_len + a_len);
-}
-
 static bool ofc_parse_expr__has_right_ambig_point(
 	ofc_parse_expr_t* expr)
 {
@@ -371,136 +346,211 @@ static void ofc_parse_expr__cull_right_ambig_point(
 }
 
 
-static unsigned ofc_parse_expr__binary_at_or_below_b(
+static unsigned ofc_parse_expr__binary_operator(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
-	ofc_parse_expr_t a,
-	ofc_parse_expr_t* expr, unsigned level)
+	ofc_parse_operator_e* op)
 {
 	/* TODO - Defined binary operators. */
 
+	unsigned dpos = ofc_parse_debug_position(debug);
+
+	ofc_parse_operator_e o;
+	unsigned len = ofc_parse_operator(
+		src, ptr, debug, &o);
+	if ((len == 0) || !ofc_parse_operator_binary(o))
+	{
+		ofc_parse_debug_rewind(debug, dpos);
+		return 0;
+	}
+
+	if (op) *op = o;
+	return len;
+}
+
+static unsigned ofc_parse_expr__unary(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	ofc_parse_expr_t* expr)
+{
+	/* TODO - Defined unary operators. */
+
+	unsigned dpos = ofc_parse_debug_position(debug);
+
 	ofc_parse_operator_e op;
 	unsigned op_len = ofc_parse_operator(
 		src, ptr, debug, &op);
-	if ((op_len == 0) || !ofc_parse_operator_binary(op))
+	if ((op_len == 0)
+		|| !ofc_parse_operator_unary(op))
+	{
+		ofc_parse_debug_rewind(debug, dpos);
 		return 0;
+	}
 
-	unsigned op_level = ofc_parse_operator_precedence(op);
-	if ((op_level > level)
-		|| (ofc_parse_expr__level(a) > op_level))
+	ofc_parse_expr_t a;
+	unsigned a_len = ofc_parse_expr__at_or_below(
+		src, &ptr[op_len], debug, &a,
+		ofc_parse_operator_precedence(op));
+	if (a_len == 0)
+	{
+		ofc_parse_debug_rewind(debug, dpos);
 		return 0;
+	}
 
-	ofc_parse_expr_t b;
+	expr->type = OFC_PARSE_EXPR_UNARY;
+	expr->src = ofc_str_ref(ptr, (op_len + a_len));
+
+	expr->unary.operator = op;
+
+	expr->unary.a = ofc_parse_expr__alloc(&a);
+	if (!expr->unary.a)
+	{
+		ofc_parse_expr__cleanup(&a);
+		ofc_parse_debug_rewind(debug, dpos);
+		return 0;
+	}
+
+	return (op_len + a_len);
+}
+
+/* Parses the right operand of a binary operator at level, and culls
+   its trailing point if the operator which follows needs it. */
+static unsigned ofc_parse_expr__binary_operand(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	ofc_parse_expr_t* b, unsigned level)
+{
 	unsigned b_len = ofc_parse_expr__at_or_below(
-		src, &ptr[op_len], debug, &b, (op_level - 1));
+		src, ptr, debug, b, (level - 1));
 	if (b_len == 0) return 0;
 
 	/* Handle case where we have something like:
 	   ( 3 ** 3 .EQ. 76 ) */
-	if (ofc_parse_expr__has_right_ambig_point(&b))
+	if (ofc_parse_expr__has_right_ambig_point(b))
 	{
+		unsigned dpos = ofc_parse_debug_position(debug);
 		ofc_parse_operator_e cop;
-		unsigned cop_len = ofc_parse_operator(
-			src, &ptr[op_len + b_len - 1], debug, &cop);
-		if ((cop_len > 0)
-			&& ofc_parse_operator_binary(cop)
-			&& (ofc_parse_operator_precedence(cop) <= op_level))
+		if ((ofc_parse_expr__binary_operator(
+				src, &ptr[b_len - 1], debug, &cop) > 0)
+			&& (ofc_parse_operator_precedence(cop) <= level))
 		{
-			ofc_parse_expr__cull_right_ambig_point(&b);
+			ofc_parse_expr__cull_right_ambig_point(b);
 			b_len -= 1;
 		}
+		ofc_parse_debug_rewind(debug, dpos);
 	}
 
-	ofc_parse_expr_t c;
-
-	c.type = OFC_PARSE_EXPR_BINARY;
-	c.src  = ofc_str_ref_bridge(a.src, b.src);
-	c.binary.operator = op;
-
-	c.binary.a = ofc_parse_expr__alloc(a);
-	if (!c.binary.a)
-	{
-		ofc_parse_expr__cleanup(b);
-		return 0;
-	}
-
-	c.binary.b = ofc_parse_expr__alloc(b);
-	if (!c.binary.b)
-	{
-		/* Don't cleanup a here, we didn't create it. */
-		free(c.binary.a);
-		ofc_parse_expr__cleanup(b);
-		return 0;
-	}
-
-	unsigned c_len = ofc_parse_expr__binary_at_or_below_b(
-		src, &ptr[op_len + b_len], debug, c, expr, op_level);
-	if (c_len > 0) return (op_len + b_len + c_len);
-
-	*expr = c;
-	return (op_len + b_len);
+	return b_len;
 }
 
-static unsigned ofc_parse_expr__binary_at_or_below(
+/* Extends expr, which is len characters long, with a left associative
+   chain of binary operators at a single level no higher than level.
+   Returns the new length, or zero if no operator could be applied, in
+   which case stuck is set if expr can never be extended. */
+static unsigned ofc_parse_expr__binary(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
-	ofc_parse_expr_t* expr, unsigned level)
+	ofc_parse_expr_t* expr, unsigned len,
+	unsigned level, bool* stuck)
 {
 	unsigned dpos = ofc_parse_debug_position(debug);
 
-	ofc_parse_expr_t a;
-	unsigned a_len = ofc_parse_expr__at_or_below(
-		src, ptr, debug, &a, (level - 1));
-	if (a_len == 0) return 0;
-
-	/* Optimize by returning a if we see end of statement or close bracket. */
-	if (ofc_parse_expr__term(&ptr[a_len]))
+	/* If expr ends in an ambiguous point the operator may start on it. */
+	bool cull = false;
+	ofc_parse_operator_e op;
+	unsigned op_len = 0;
+	if (ofc_parse_expr__has_right_ambig_point(expr))
+	{
+		op_len = ofc_parse_expr__binary_operator(
+			src, &ptr[len - 1], debug, &op);
+		cull = (op_len > 0);
+	}
+	if (cull)
+		len -= 1;
+	else
+		op_len = ofc_parse_expr__binary_operator(
+			src, &ptr[len], debug, &op);
+	if (op_len == 0)
 	{
-		*expr = a;
-		return a_len;
+		*stuck = true;
+		return 0;
 	}
 
-	/* Handle case where we have something like:
-	   ( 3 ** 3 .EQ. 76 ) */
-	if (ofc_parse_expr__has_right_ambig_point(&a))
+	unsigned op_level = ofc_parse_operator_precedence(op);
+	if ((op_level > level)
+		|| (ofc_parse_expr__level(expr) > op_level))
 	{
-		ofc_parse_operator_e op;
-		unsigned op_len = ofc_parse_operator(
-			src, &ptr[a_len - 1], debug, &op);
-		if ((op_len > 0)
-			&& ofc_parse_operator_binary(op)
-			&& (ofc_parse_operator_precedence(op) <= level))
-		{
-			ofc_parse_expr__cull_right_ambig_point(&a);
-			a_len -= 1;
-		}
+		ofc_parse_debug_rewind(debug, dpos);
+		*stuck = (op_level <= level);
+		return 0;
 	}
 
-	unsigned b_len = ofc_parse_expr__binary_at_or_below_b(
-		src, &ptr[a_len], debug, a, expr, level);
+	ofc_parse_expr_t b;
+	unsigned b_len = ofc_parse_expr__binary_operand(
+		src, &ptr[len + op_len], debug, &b, op_level);
 	if (b_len == 0)
 	{
-		ofc_parse_expr__cleanup(a);
 		ofc_parse_debug_rewind(debug, dpos);
+		*stuck = true;
 		return 0;
 	}
 
-	return (a_len + b_len);
-}
-
-static unsigned ofc_parse_expr__binary(
-	const ofc_sparse_t* src, const char* ptr,
-	ofc_parse_debug_t* debug,
-	ofc_parse_expr_t* expr, unsigned level)
-{
-	unsigned i;
-	for (i = level; i > 0; i--)
+	unsigned c_len = 0;
+	while (true)
 	{
-		unsigned len = ofc_parse_expr__binary_at_or_below(
-			src, ptr, debug, expr, i);
-		if (len > 0) return len;
+		ofc_parse_expr_t c;
+
+		c.type = OFC_PARSE_EXPR_BINARY;
+		c.binary.operator = op;
+
+		c.binary.a = ofc_parse_expr__alloc(expr);
+		c.binary.b = ofc_parse_expr__alloc(&b);
+		if (!c.binary.a || !c.binary.b)
+		{
+			/* Don't cleanup expr here, the caller owns it. */
+			ofc_parse_free(c.binary.a);
+			ofc_parse_free(c.binary.b);
+			ofc_parse_expr__cleanup(&b);
+			if (c_len == 0)
+			{
+				ofc_parse_debug_rewind(debug, dpos);
+				*stuck = true;
+			}
+			break;
+		}
+
+		if (cull)
+		{
+			ofc_parse_expr__cull_right_ambig_point(c.binary.a);
+			cull = false;
+		}
+		c.src = ofc_str_ref_bridge(c.binary.a->src, b.src);
+
+		*expr = c;
+		len += (op_len + b_len);
+		c_len = len;
+
+		/* Operators at the same level associate to the left. */
+		unsigned cpos = ofc_parse_debug_position(debug);
+		op_len = ofc_parse_expr__binary_operator(
+			src, &ptr[len], debug, &op);
+		if ((op_len == 0)
+			|| (ofc_parse_operator_precedence(op) != op_level))
+		{
+			ofc_parse_debug_rewind(debug, cpos);
+			break;
+		}
+
+		b_len = ofc_parse_expr__binary_operand(
+			src, &ptr[len + op_len], debug, &b, op_level);
+		if (b_len == 0)
+		{
+			ofc_parse_debug_rewind(debug, cpos);
+			break;
+		}
 	}
-	return 0;
+
+	return c_len;
 }
 
 static unsigned ofc_parse_expr__at_or_below(
@@ -508,93 +558,139 @@ static unsigned ofc_parse_expr__at_or_below(
 	ofc_parse_debug_t* debug,
 	ofc_parse_expr_t* expr, unsigned level)
 {
-	unsigned len = ofc_parse_expr__binary(
-		src, ptr, debug, expr, level);
-	if (len > 0) return len;
+	/* This climbs the precedence levels once, extending the expression
+	   at each level in turn rather than reparsing it from the start. */
 
-	len = ofc_parse_expr__unary(
-		src, ptr, debug, expr, level);
-	if (len > 0) return len;
+	unsigned dpos = ofc_parse_debug_position(debug);
 
-	return ofc_parse_expr__primary(
+	unsigned uop_level = 0;
+	ofc_parse_operator_e uop;
+	if ((ofc_parse_operator(src, ptr, debug, &uop) > 0)
+		&& ofc_parse_operator_unary(uop))
+		uop_level = ofc_parse_operator_precedence(uop);
+	ofc_parse_debug_rewind(debug, dpos);
+
+	unsigned len = ofc_parse_expr__primary(
 		src, ptr, debug, expr);
+
+	bool bound = false;
+	bool stuck = false;
+	unsigned l;
+	for (l = 1; l <= level; l++)
+	{
+		if (len > 0)
+		{
+			if (ofc_parse_expr__term(&ptr[len]))
+				break;
+
+			if (!stuck)
+			{
+				unsigned c_len = ofc_parse_expr__binary(
+					src, ptr, debug, expr, len, l, &stuck);
+				if (c_len > 0)
+				{
+					len = c_len;
+					bound = true;
+					continue;
+				}
+			}
+		}
+
+		/* A leading sign is only a unary operator if nothing binds
+		   to the primary before we reach the operator's level. */
+		if (!bound && (l == uop_level))
+		{
+			if (len > 0)
+			{
+				ofc_parse_expr__cleanup(expr);
+				ofc_parse_debug_rewind(debug, dpos);
+			}
+
+			stuck = false;
+			len = ofc_parse_expr__unary(
+				src, ptr, debug, expr);
+			if (len == 0)
+			{
+				len = ofc_parse_expr__primary(
+					src, ptr, debug, expr);
+			}
+		}
+	}
+
+	return len;
 }
 
 
 
-ofc_parse_expr_t* ofc_parse_expr_integer(
+static ofc_parse_expr_t* ofc_parse_expr__memo(
 	const ofc_sparse_t* src, const char* ptr,
-	ofc_parse_debug_t* debug,
-	unsigned* len)
+	ofc_parse_debug_t* debug, unsigned* len,
+	ofc_parse_memo_e kind,
+	unsigned (*func)(const ofc_sparse_t*, const char*,
+		ofc_parse_debug_t*, ofc_parse_expr_t*))
 {
+	void*    node;
+	unsigned i;
+	if (ofc_parse_memo_find(kind, ptr, &node, &i))
+	{
+		if (node && len) *len = i;
+		return (ofc_parse_expr_t*)node;
+	}
+
 	unsigned dpos = ofc_parse_debug_position(debug);
 
 	ofc_parse_expr_t e;
-	unsigned i = ofc_parse_expr__integer(
-		src, ptr, debug, &e);
-	if (i == 0) return NULL;
-
-	ofc_parse_expr_t* expr
-		= ofc_parse_expr__alloc(e);
-	if (!expr)
+	ofc_parse_expr_t* expr = NULL;
+	i = func(src, ptr, debug, &e);
+	if (i > 0)
 	{
-		ofc_parse_debug_rewind(debug, dpos);
-		ofc_parse_expr__cleanup(e);
-		return NULL;
+		expr = ofc_parse_expr__alloc(&e);
+		if (!expr)
+		{
+			ofc_parse_debug_rewind(debug, dpos);
+			ofc_parse_expr__cleanup(&e);
+			return NULL;
+		}
 	}
 
-	if (len) *len = i;
+	/* A shared result wouldn't raise its messages again. */
+	if (ofc_parse_debug_position(debug) == dpos)
+		ofc_parse_memo_add(kind, ptr, expr, i);
+
+	if (expr && len) *len = i;
 	return expr;
 }
 
-ofc_parse_expr_t* ofc_parse_expr_integer_variable(
-       const ofc_sparse_t* src, const char* ptr,
-       ofc_parse_debug_t* debug, unsigned* len)
+ofc_parse_expr_t* ofc_parse_expr_integer(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	unsigned* len)
 {
-       unsigned dpos = ofc_parse_debug_position(debug);
-
-       ofc_parse_expr_t e;
-       unsigned i = ofc_parse_expr__integer_variable(
-               src, ptr, debug, &e);
-       if (i == 0) return NULL;
-
-       ofc_parse_expr_t* expr
-               = ofc_parse_expr__alloc(e);
-       if (!expr)
-       {
-               ofc_parse_debug_rewind(debug, dpos);
-               ofc_parse_expr__cleanup(e);
-               return NULL;
-       }
-
-       if (len) *len = i;
-       return expr;
+	return ofc_parse_expr__memo(
+		src, ptr, debug, len,
+		OFC_PARSE_MEMO_EXPR_INTEGER,
+		ofc_parse_expr__integer);
 }
 
+ofc_parse_expr_t* ofc_parse_expr_integer_variable(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug, unsigned* len)
+{
+	return ofc_parse_expr__memo(
+		src, ptr, debug, len,
+		OFC_PARSE_MEMO_EXPR_INTEGER_VARIABLE,
+		ofc_parse_expr__integer_variable);
+}
 
 ofc_parse_expr_t* ofc_parse_expr(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
 	unsigned* len)
 {
-	unsigned dpos = ofc_parse_debug_position(debug);
-
-	ofc_parse_expr_t e;
-	unsigned i = ofc_parse__expr(
-		src, ptr, debug, &e);
-	if (i == 0) return NULL;
-
-	ofc_parse_expr_t* expr
-		= ofc_parse_expr__alloc(e);
-	if (!expr)
-	{
-		ofc_parse_debug_rewind(debug, dpos);
-		ofc_parse_expr__cleanup(e);
-		return NULL;
-	}
-
-	if (len) *len = i;
-	return expr;
+	return ofc_parse_expr__memo(
+		src, ptr, debug, len,
+		OFC_PARSE_MEMO_EXPR,
+		ofc_parse__expr);
 }
 
 void ofc_parse_expr_delete(
@@ -603,8 +699,8 @@ void ofc_parse_expr_delete(
 	if (!expr)
 		return;
 
-	ofc_parse_expr__cleanup(*expr);
-	free(expr);
+	ofc_parse_expr__cleanup(expr);
+	ofc_parse_free(expr);
 }
 
 bool ofc_parse_expr_print(
@@ -661,12 +757,120 @@ ofc_parse_expr_t* ofc_parse_expr_copy(
 		return NULL;
 
 	ofc_parse_expr_t* acopy
-		= ofc_parse_expr__alloc(copy);
+		= ofc_parse_expr__alloc(&copy);
 	if (!acopy)
-		ofc_parse_expr__cleanup(copy);
+		ofc_parse_expr__cleanup(&copy);
 	return acopy;
 }
 
+bool ofc_parse_expr_serialize(
+	ofc_serial_t* serial, const ofc_parse_expr_t* expr)
+{
+	if (!ofc_serial_write_bool(serial, (expr != NULL)))
+		return false;
+	if (!expr)
+		return true;
+
+	if (!ofc_serial_write_uint(serial, expr->type)
+		|| !ofc_serial_write_str_ref(serial, expr->src))
+		return false;
+
+	switch (expr->type)
+	{
+		case OFC_PARSE_EXPR_CONSTANT:
+			return ofc_parse_literal_serialize(
+				serial, &expr->literal);
+		case OFC_PARSE_EXPR_VARIABLE:
+			return ofc_parse_lhs_serialize(
+				serial, expr->variable);
+		case OFC_PARSE_EXPR_BRACKETS:
+			return ofc_parse_expr_serialize(
+				serial, expr->brackets.expr);
+		case OFC_PARSE_EXPR_UNARY:
+			return (ofc_serial_write_uint(serial, expr->unary.operator)
+				&& ofc_parse_expr_serialize(serial, expr->unary.a));
+		case OFC_PARSE_EXPR_BINARY:
+			return (ofc_serial_write_uint(serial, expr->binary.operator)
+				&& ofc_parse_expr_serialize(serial, expr->binary.a)
+				&& ofc_parse_expr_serialize(serial, expr->binary.b));
+		default:
+			break;
+	}
+
+	return false;
+}
+
+bool ofc_parse_expr_deserialize(
+	ofc_serial_t* serial, ofc_parse_expr_t** expr)
+{
+	bool present;
+	if (!expr || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	if (!present)
+	{
+		*expr = NULL;
+		return true;
+	}
+
+	unsigned type;
+	ofc_parse_expr_t e;
+	if (!ofc_serial_read_unsigned(serial, &type)
+		|| !ofc_serial_read_str_ref(serial, &e.src))
+		return false;
+	e.type = type;
+
+	unsigned op;
+	bool success = false;
+	switch (e.type)
+	{
+		case OFC_PARSE_EXPR_CONSTANT:
+			success = ofc_parse_literal_deserialize(
+				serial, &e.literal);
+			break;
+		case OFC_PARSE_EXPR_VARIABLE:
+			success = ofc_parse_lhs_deserialize(
+				serial, &e.variable);
+			break;
+		case OFC_PARSE_EXPR_BRACKETS:
+			success = ofc_parse_expr_deserialize(
+				serial, &e.brackets.expr);
+			break;
+		case OFC_PARSE_EXPR_UNARY:
+			if (!ofc_serial_read_unsigned(serial, &op)
+				|| (op >= OFC_PARSE_OPERATOR_COUNT))
+				break;
+			e.unary.operator = op;
+			success = ofc_parse_expr_deserialize(
+				serial, &e.unary.a);
+			break;
+		case OFC_PARSE_EXPR_BINARY:
+			if (!ofc_serial_read_unsigned(serial, &op)
+				|| (op >= OFC_PARSE_OPERATOR_COUNT))
+				break;
+			e.binary.operator = op;
+			if (!ofc_parse_expr_deserialize(
+				serial, &e.binary.a))
+				break;
+			success = ofc_parse_expr_deserialize(
+				serial, &e.binary.b);
+			if (!success)
+				ofc_parse_expr_delete(e.binary.a);
+			break;
+		default:
+			break;
+	}
+	if (!success) return false;
+
+	*expr = ofc_parse_expr__alloc(&e);
+	if (!*expr)
+	{
+		ofc_parse_expr__cleanup(&e);
+		return false;
+	}
+	return true;
+}
+
 
 
 ofc_parse_expr_list_t* ofc_parse_expr_list(
@@ -675,7 +879,7 @@ ofc_parse_expr_list_t* ofc_parse_expr_list(
 	unsigned* len)
 {
 	ofc_parse_expr_list_t* list
-		= (ofc_parse_expr_list_t*)malloc(
+		= (ofc_parse_expr_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_expr_list_t));
 	if (!list) return NULL;
 
@@ -689,7 +893,7 @@ ofc_parse_expr_list_t* ofc_parse_expr_list(
 		(void*)ofc_parse_expr_delete);
 	if (l == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -706,7 +910,7 @@ void ofc_parse_expr_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->expr,
 		(void*)ofc_parse_expr_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_expr_list_print(
@@ -719,3 +923,43 @@ bool ofc_parse_expr_list_print(
 		cs, list->count, (const void**)list->expr,
 		(void*)ofc_parse_expr_print);
 }
+
+bool ofc_parse_expr_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_expr_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->expr,
+		(void*)ofc_parse_expr_serialize));
+}
+
+bool ofc_parse_expr_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_expr_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_expr_list_t* l
+		= (ofc_parse_expr_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_expr_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->expr,
+		(void*)ofc_parse_expr_deserialize,
+		(void*)ofc_parse_expr_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
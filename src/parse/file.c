@@ -14,23 +14,556 @@
  */
 
 #include <ofc/parse.h>
+#include <ofc/parse/file.h>
+#include <ofc/prep.h>
+#include <ofc/hashmap.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <strings.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 
-ofc_parse_stmt_list_t* ofc_parse_file(const ofc_sparse_t* src)
+static ofc_parse_stmt_list_t* ofc_parse_file__stmt(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	unsigned* len)
 {
+	ofc_parse_stmt_list_t* list
+		= (ofc_parse_stmt_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_stmt_list_t));
+	if (!list) return NULL;
+
+	list->count = 0;
+	list->stmt  = NULL;
+	list->arena = NULL;
+	list->ref   = 0;
+
+	unsigned i = 0;
+	ofc_parse_stmt_t* stmt
+		= ofc_parse_stmt(src, ptr, debug, &i);
+	if (stmt)
+	{
+		list->stmt = (ofc_parse_stmt_t**)ofc_parse_alloc(
+			sizeof(ofc_parse_stmt_t*));
+		if (!list->stmt)
+		{
+			ofc_parse_stmt_delete(stmt);
+			ofc_parse_free(list);
+			return NULL;
+		}
+		list->stmt[0] = stmt;
+		list->count = 1;
+	}
+	else if (i == 0)
+	{
+		ofc_parse_free(list);
+		return NULL;
+	}
+
+	if (len) *len = i;
+	return list;
+}
+
+/* Consecutive program units are parsed together on a worker thread as
+   a part, which collects its own diagnostics to be reported in order. */
+typedef struct
+{
+	unsigned start, end;
+
+	ofc_parse_debug_t* debug;
+	ofc_arena_t*       arena;
+
+	unsigned           count;
+	ofc_parse_stmt_t** stmt;
+
+	/* Where parsing ended, stopped is set if a statement didn't parse
+	   and failed if the part couldn't be parsed at all. */
+	unsigned len;
+	bool     stopped;
+	bool     failed;
+
+	char*  diag;
+	size_t diag_size;
+} ofc_parse_file__part_t;
+
+typedef struct
+{
+	const ofc_sparse_t* src;
+
+	unsigned                count, next;
+	ofc_parse_file__part_t* part;
+} ofc_parse_file__parts_t;
+
+/* Files smaller than this once condensed aren't worth starting threads for. */
+#define OFC_PARSE_FILE__PARALLEL_MIN (64 * 1024)
+/* Parts per thread, so that uneven units still balance out. */
+#define OFC_PARSE_FILE__PARALLEL_PARTS 4
+
+/* Parsing is serial unless asked otherwise. */
+static unsigned ofc_parse_file__threads = 1;
+
+void ofc_parse_file_threads(unsigned threads)
+{
+	ofc_parse_file__threads = threads;
+}
+
+/* Includes are parsed as they're seen and shared between includers, so
+   the first to include a file reports its diagnostics. */
+static bool ofc_parse_file__unit_include(
+	const char* ptr, unsigned len)
+{
+	return ((len > 7)
+		&& (strncasecmp(ptr, "INCLUDE", 7) == 0)
+		&& ((ptr[7] == '\'') || (ptr[7] == '\"')));
+}
+
+static bool ofc_parse_file__part_append(
+	unsigned* count, ofc_parse_stmt_t*** stmt,
+	unsigned* max, ofc_parse_stmt_t* s)
+{
+	if (*count >= *max)
+	{
+		unsigned nmax = (*max << 1);
+		if (nmax == 0) nmax = 16;
+		ofc_parse_stmt_t** nstmt
+			= (ofc_parse_stmt_t**)ofc_parse_realloc(*stmt,
+				(sizeof(ofc_parse_stmt_t*) * nmax));
+		if (!nstmt) return false;
+		*stmt = nstmt;
+		*max  = nmax;
+	}
+
+	(*stmt)[(*count)++] = s;
+	return true;
+}
+
+static void ofc_parse_file__part_parse(
+	const ofc_sparse_t* src, ofc_parse_file__part_t* part)
+{
+	part->debug = ofc_parse_debug_create();
+	part->arena = ofc_arena_create();
+
+	FILE* stream = open_memstream(
+		&part->diag, &part->diag_size);
+	if (!part->debug || !part->arena || !stream)
+	{
+		if (stream) fclose(stream);
+		part->failed = true;
+		return;
+	}
+
+	ofc_parse_memo_t* memo = ofc_parse_memo_create();
+
+	ofc_arena_t*      outer        = ofc_parse_arena_swap(part->arena);
+	ofc_parse_memo_t* outer_memo   = ofc_parse_memo_swap(memo);
+	FILE*             outer_stream = ofc_file_diagnostics_swap(stream);
+
 	const char* ptr = ofc_sparse_strz(src);
 
+	unsigned max = 0;
+	unsigned i = part->start;
+	while (i < part->end)
+	{
+		unsigned l = 0;
+		ofc_parse_stmt_t* stmt = ofc_parse_stmt(
+			src, &ptr[i], part->debug, &l);
+		if (!stmt)
+		{
+			part->stopped = true;
+			break;
+		}
+
+		if (!ofc_parse_file__part_append(
+			&part->count, &part->stmt, &max, stmt))
+		{
+			ofc_parse_stmt_delete(stmt);
+			part->failed = true;
+			break;
+		}
+
+		i += l;
+	}
+	part->len = i;
+
+	ofc_file_diagnostics_swap(outer_stream);
+	ofc_parse_memo_swap(outer_memo);
+	ofc_parse_arena_swap(outer);
+	ofc_parse_memo_delete(memo);
+
+	fclose(stream);
+}
+
+static void* ofc_parse_file__part_worker(void* data)
+{
+	ofc_parse_file__parts_t* parts
+		= (ofc_parse_file__parts_t*)data;
+
+	while (true)
+	{
+		unsigned i = __atomic_fetch_add(
+			&parts->next, 1, __ATOMIC_RELAXED);
+		if (i >= parts->count)
+			break;
+
+		ofc_parse_file__part_parse(
+			parts->src, &parts->part[i]);
+	}
+
+	return NULL;
+}
+
+static void ofc_parse_file__part_cleanup(
+	ofc_parse_file__part_t* part)
+{
+	unsigned i;
+	for (i = 0; i < part->count; i++)
+		ofc_parse_stmt_delete(part->stmt[i]);
+	ofc_parse_free(part->stmt);
+
+	ofc_parse_debug_delete(part->debug);
+	ofc_arena_delete(part->arena);
+	free(part->diag);
+}
+
+static void ofc_parse_file__arena_delete(void* arena)
+{
+	ofc_arena_delete((ofc_arena_t*)arena);
+}
+
+/* Stitches the parts together as ofc_parse_stmt_list would have parsed
+   them, any text not covered by a part is parsed here in order. */
+typedef struct
+{
+	const ofc_sparse_t* src;
+
+	unsigned               len;
+	bool                   stopped;
+	bool                   error;
+	bool                   failed;
+
+	ofc_parse_stmt_list_t* list;
+	unsigned               max;
+
+	unsigned            debug_count;
+	ofc_parse_debug_t** debug;
+} ofc_parse_file__stitch_t;
+
+static void ofc_parse_file__stitch_stmt(
+	ofc_parse_file__stitch_t* stitch, ofc_parse_stmt_t* stmt)
+{
+	/* Nothing after an error is kept. */
+	if (stitch->error || stitch->failed)
+	{
+		ofc_parse_stmt_delete(stmt);
+		return;
+	}
+
+	if (!ofc_parse_file__part_append(
+		&stitch->list->count, &stitch->list->stmt,
+		&stitch->max, stmt))
+	{
+		ofc_parse_stmt_delete(stmt);
+		stitch->failed = true;
+		return;
+	}
+
+	stitch->error = (stmt->type == OFC_PARSE_STMT_ERROR);
+}
+
+static void ofc_parse_file__stitch_to(
+	ofc_parse_file__stitch_t* stitch, unsigned end)
+{
+	if (stitch->stopped || stitch->failed
+		|| (stitch->len >= end))
+		return;
+
+	ofc_parse_debug_t* debug = ofc_parse_debug_create();
+	if (!debug)
+	{
+		stitch->failed = true;
+		return;
+	}
+	stitch->debug[stitch->debug_count++] = debug;
+
+	const char* ptr = ofc_sparse_strz(stitch->src);
+	while (!stitch->stopped && !stitch->failed
+		&& (stitch->len < end))
+	{
+		unsigned l = 0;
+		ofc_parse_stmt_t* stmt = ofc_parse_stmt(
+			stitch->src, &ptr[stitch->len], debug, &l);
+		if (!stmt)
+		{
+			stitch->stopped = true;
+			break;
+		}
+
+		ofc_parse_file__stitch_stmt(stitch, stmt);
+		stitch->len += l;
+	}
+}
+
+static void ofc_parse_file__stitch_part(
+	ofc_parse_file__stitch_t* stitch, ofc_parse_file__part_t* part)
+{
+	ofc_parse_file__stitch_to(stitch, part->start);
+
+	if (stitch->stopped || stitch->failed || part->failed
+		|| (stitch->len != part->start))
+		return;
+
+	if (part->diag_size > 0)
+	{
+		fwrite(part->diag, 1, part->diag_size,
+			ofc_file_diagnostics());
+	}
+
+	if (!ofc_parse_arena_cleanup(
+		ofc_parse_file__arena_delete, part->arena))
+	{
+		stitch->failed = true;
+		return;
+	}
+	part->arena = NULL;
+
+	stitch->debug[stitch->debug_count++] = part->debug;
+	part->debug = NULL;
+
+	unsigned i;
+	for (i = 0; i < part->count; i++)
+		ofc_parse_file__stitch_stmt(stitch, part->stmt[i]);
+	part->count = 0;
+
+	stitch->len     = part->len;
+	stitch->stopped = part->stopped;
+}
+
+/* Parses the program units of a file on a pool of threads, returns false
+   when the file should just be parsed serially. Diagnostics and the list
+   returned are the same as ofc_parse_stmt_list would give. */
+static bool ofc_parse_file__units(
+	const ofc_sparse_t* src,
+	ofc_parse_stmt_list_t** list, unsigned* len)
+{
+	const char* ptr  = ofc_sparse_strz(src);
+	unsigned    size = ofc_sparse_len(src);
+	if (!ptr || (size < OFC_PARSE_FILE__PARALLEL_MIN))
+		return false;
+
+	unsigned threads = ofc_parse_file__threads;
+	if (threads == 0)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = (online > 0 ? online : 1);
+	}
+	if (threads < 2)
+		return false;
+
+	unsigned max_parts = (threads * OFC_PARSE_FILE__PARALLEL_PARTS);
+	unsigned target    = (size / max_parts);
+
+	ofc_parse_file__parts_t parts;
+	parts.src   = src;
+	parts.count = 0;
+	parts.next  = 0;
+	parts.part  = (ofc_parse_file__part_t*)calloc(
+		max_parts, sizeof(ofc_parse_file__part_t));
+	if (!parts.part) return false;
+
+	/* Split after the end of a unit once a part is big enough. */
+	unsigned start = 0;
+	unsigned count = ofc_sparse_stmt_count(src);
+	unsigned i;
+	for (i = 0; i < count; i++)
+	{
+		unsigned offset, slen;
+		ofc_sparse_stmt(src, i, &offset, &slen);
+
+		if (ofc_parse_file__unit_include(&ptr[offset], slen))
+		{
+			free(parts.part);
+			return false;
+		}
+
+		unsigned next;
+		if (ofc_prep_unit_end(&ptr[offset], slen)
+			&& ofc_sparse_stmt(src, (i + 1), &next, NULL)
+			&& ((next - start) >= target)
+			&& ((parts.count + 1) < max_parts))
+		{
+			parts.part[parts.count].start = start;
+			parts.part[parts.count].end   = next;
+			parts.count++;
+			start = next;
+		}
+	}
+
+	if (parts.count == 0)
+	{
+		free(parts.part);
+		return false;
+	}
+
+	parts.part[parts.count].start = start;
+	parts.part[parts.count].end   = size;
+	parts.count++;
+
+	if (threads > parts.count)
+		threads = parts.count;
+
+	/* This thread works too, so it's fine if some fail to start. */
+	pthread_t thread[threads - 1];
+	unsigned started;
+	for (started = 0; started < (threads - 1); started++)
+	{
+		if (pthread_create(&thread[started], NULL,
+			ofc_parse_file__part_worker, &parts) != 0)
+			break;
+	}
+	ofc_parse_file__part_worker(&parts);
+	for (i = 0; i < started; i++)
+		pthread_join(thread[i], NULL);
+
+	ofc_parse_file__stitch_t stitch;
+	stitch.src     = src;
+	stitch.len     = 0;
+	stitch.stopped = false;
+	stitch.error   = false;
+	stitch.failed  = false;
+	stitch.list    = NULL;
+	stitch.max     = 0;
+
+	stitch.debug_count = 0;
+	stitch.debug = (ofc_parse_debug_t**)malloc(
+		sizeof(ofc_parse_debug_t*) * ((parts.count * 2) + 1));
+
+	ofc_arena_t*      arena = ofc_arena_create();
+	ofc_parse_memo_t* memo  = ofc_parse_memo_create();
+
+	ofc_arena_t*      outer      = ofc_parse_arena_swap(arena);
+	ofc_parse_memo_t* outer_memo = ofc_parse_memo_swap(memo);
+
+	if (arena && stitch.debug)
+	{
+		stitch.list = (ofc_parse_stmt_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_stmt_list_t));
+	}
+	if (stitch.list)
+	{
+		stitch.list->count = 0;
+		stitch.list->stmt  = NULL;
+		stitch.list->arena = NULL;
+		stitch.list->ref   = 0;
+	}
+	else
+	{
+		stitch.failed = true;
+	}
+
+	for (i = 0; i < parts.count; i++)
+	{
+		ofc_parse_file__stitch_part(&stitch, &parts.part[i]);
+		ofc_parse_file__part_cleanup(&parts.part[i]);
+	}
+	free(parts.part);
+
+	ofc_parse_file__stitch_to(&stitch, UINT_MAX);
+
+	ofc_parse_memo_swap(outer_memo);
+	ofc_parse_arena_swap(outer);
+	ofc_parse_memo_delete(memo);
+
+	/* Like ofc_parse_stmt_list, nothing is reported
+	   when not even the first statement parses. */
+	bool success = (!stitch.failed && (stitch.len > 0));
+	for (i = 0; i < stitch.debug_count; i++)
+	{
+		if (success)
+			ofc_parse_debug_print(stitch.debug[i]);
+		ofc_parse_debug_delete(stitch.debug[i]);
+	}
+	free(stitch.debug);
+
+	if (!success)
+	{
+		if (stitch.list)
+		{
+			stitch.list->arena = arena;
+			ofc_parse_stmt_list_delete(stitch.list);
+		}
+		else
+		{
+			ofc_arena_delete(arena);
+		}
+		*list = NULL;
+		return true;
+	}
+
+	stitch.list->arena = arena;
+	*list = stitch.list;
+	*len  = stitch.len;
+	return true;
+}
+
+static ofc_parse_stmt_list_t* ofc_parse_file__parse(
+	const ofc_sparse_t* src, const char* ptr, bool single,
+	unsigned* len)
+{
 	ofc_parse_debug_t* debug
 		= ofc_parse_debug_create();
 	if (!debug) return NULL;
 
-	unsigned len;
-	ofc_parse_stmt_list_t* list
-		= ofc_parse_stmt_list(src, ptr, debug, &len);
-	if (!list) return NULL;
+	ofc_arena_t* arena = ofc_arena_create();
+	if (!arena)
+	{
+		ofc_parse_debug_delete(debug);
+		return NULL;
+	}
+
+	/* The memo is optional, we just parse more slowly without it. */
+	ofc_parse_memo_t* memo = ofc_parse_memo_create();
+
+	/* Includes parse into their own arena, so restore the outer one. */
+	ofc_arena_t*      outer      = ofc_parse_arena_swap(arena);
+	ofc_parse_memo_t* outer_memo = ofc_parse_memo_swap(memo);
+
+	ofc_parse_stmt_list_t* list = (single
+		? ofc_parse_file__stmt(src, ptr, debug, len)
+		: ofc_parse_stmt_list(src, ptr, debug, len));
+
+	ofc_parse_memo_swap(outer_memo);
+	ofc_parse_arena_swap(outer);
+	ofc_parse_memo_delete(memo);
+
+	if (!list)
+	{
+		ofc_parse_debug_delete(debug);
+		ofc_arena_delete(arena);
+		return NULL;
+	}
+	list->arena = arena;
 
 	ofc_parse_debug_print(debug);
 	ofc_parse_debug_delete(debug);
+	return list;
+}
+
+ofc_parse_stmt_list_t* ofc_parse_file(const ofc_sparse_t* src)
+{
+	const char* ptr = ofc_sparse_strz(src);
+
+	unsigned len;
+	ofc_parse_stmt_list_t* list;
+	if (!ofc_parse_file__units(src, &list, &len))
+		list = ofc_parse_file__parse(src, ptr, false, &len);
+	if (!list) return NULL;
 
 	if (ptr[len] != '\0')
 	{
@@ -43,6 +576,560 @@ ofc_parse_stmt_list_t* ofc_parse_file(const ofc_sparse_t* src)
 	return list;
 }
 
+ofc_parse_stmt_list_t* ofc_parse_file_stmt(
+	const ofc_sparse_t* src, unsigned index, unsigned* count)
+{
+	unsigned offset;
+	if (!ofc_sparse_stmt(src, index, &offset, NULL))
+		return NULL;
+
+	const char* ptr = &ofc_sparse_strz(src)[offset];
+
+	unsigned len;
+	ofc_parse_stmt_list_t* list
+		= ofc_parse_file__parse(src, ptr, true, &len);
+	if (!list) return NULL;
+
+	/* A block statement takes the statements in its body with it. */
+	unsigned next;
+	if (!ofc_sparse_stmt_find(src, &ptr[len], &next)
+		|| (next <= index))
+		next = (index + 1);
+
+	if (count) *count = (next - index);
+	return list;
+}
+
+/* Included files are keyed by their resolved path as written rather than
+   a canonical one, since that path is what's printed and reported. */
+typedef struct
+{
+	char*           path;
+	char*           include;
+	ofc_lang_opts_t opts;
+
+	/* The file is prepped and parsed again if either changes. */
+	struct timespec mtime;
+	off_t           size;
+
+	ofc_file_t*            file;
+	ofc_sparse_t*          src;
+	ofc_parse_stmt_list_t* list;
+} ofc_parse_file__include_t;
+
+static unsigned ofc_parse_file__include_hash(
+	const ofc_parse_file__include_t* key)
+{
+	unsigned hash = ofc_str_ref_hash(
+		ofc_str_ref_from_strz(key->path));
+	if (key->include)
+	{
+		hash ^= ofc_str_ref_hash(
+			ofc_str_ref_from_strz(key->include)) * 31;
+	}
+
+	hash ^= key->opts.form
+		^ (key->opts.tab_width << 4)
+		^ (key->opts.columns << 12);
+	return hash;
+}
+
+static bool ofc_parse_file__include_compare(
+	const ofc_parse_file__include_t* a,
+	const ofc_parse_file__include_t* b)
+{
+	if (strcmp(a->path, b->path) != 0)
+		return false;
+
+	if (a->include || b->include)
+	{
+		if (!a->include || !b->include
+			|| (strcmp(a->include, b->include) != 0))
+			return false;
+	}
+
+	return ((a->opts.form == b->opts.form)
+		&& (a->opts.tab_width == b->opts.tab_width)
+		&& (a->opts.debug == b->opts.debug)
+		&& (a->opts.columns == b->opts.columns)
+		&& (a->opts.case_sensitive == b->opts.case_sensitive));
+}
+
+static const ofc_parse_file__include_t* ofc_parse_file__include_key(
+	const ofc_parse_file__include_t* include)
+{
+	return include;
+}
+
+static void ofc_parse_file__include_release(
+	ofc_parse_file__include_t* include)
+{
+	ofc_parse_stmt_list_delete(include->list);
+	ofc_sparse_delete(include->src);
+	ofc_file_delete(include->file);
+}
+
+static void ofc_parse_file__include_delete(
+	ofc_parse_file__include_t* include)
+{
+	if (!include)
+		return;
+
+	ofc_parse_file__include_release(include);
+	free(include->include);
+	free(include->path);
+	free(include);
+}
+
+static bool ofc_parse_file__include_hold(
+	ofc_parse_file__include_t* include,
+	ofc_file_t* file, ofc_sparse_t* src,
+	ofc_parse_stmt_list_t* list)
+{
+	if (!ofc_file_reference(file))
+		return false;
+
+	if (!ofc_sparse_reference(src))
+	{
+		ofc_file_delete(file);
+		return false;
+	}
+
+	if (!ofc_parse_stmt_list_reference(list))
+	{
+		ofc_sparse_delete(src);
+		ofc_file_delete(file);
+		return false;
+	}
+
+	include->file = file;
+	include->src  = src;
+	include->list = list;
+	return true;
+}
+
+static ofc_hashmap_t* ofc_parse_file__include_map = NULL;
+static pthread_mutex_t ofc_parse_file__include_lock
+	= PTHREAD_MUTEX_INITIALIZER;
+
+static ofc_parse_stmt_list_t* ofc_parse_file__include_load(
+	const char* path, ofc_lang_opts_t opts, const char* include,
+	ofc_file_t** file, ofc_sparse_t** src)
+{
+	*file = ofc_file_create_include(path, opts, include);
+	if (!*file) return NULL;
+
+	*src = ofc_prep(*file);
+	ofc_parse_stmt_list_t* list
+		= (*src ? ofc_parse_file(*src) : NULL);
+	if (!list) ofc_sparse_delete(*src);
+	return list;
+}
+
+ofc_parse_stmt_list_t* ofc_parse_file_include(
+	const char* path, ofc_lang_opts_t opts, const char* include,
+	ofc_file_t** file, ofc_sparse_t** src)
+{
+	if (!path || !file || !src)
+		return NULL;
+
+	/* Anything that isn't a regular file is left for ofc_file_create. */
+	struct stat fs;
+	if ((stat(path, &fs) != 0)
+		|| !S_ISREG(fs.st_mode))
+	{
+		return ofc_parse_file__include_load(
+			path, opts, include, file, src);
+	}
+
+	ofc_parse_file__include_t key;
+	key.path    = (char*)path;
+	key.include = (char*)include;
+	key.opts    = opts;
+	key.mtime   = fs.st_mtim;
+	key.size    = fs.st_size;
+
+	pthread_mutex_lock(&ofc_parse_file__include_lock);
+	const ofc_parse_file__include_t* cached = NULL;
+	if (ofc_parse_file__include_map)
+	{
+		cached = ofc_hashmap_find(
+			ofc_parse_file__include_map, &key);
+	}
+
+	if (cached
+		&& (cached->mtime.tv_sec  == key.mtime.tv_sec )
+		&& (cached->mtime.tv_nsec == key.mtime.tv_nsec)
+		&& (cached->size == key.size))
+	{
+		ofc_parse_file__include_t hold;
+		bool held = ofc_parse_file__include_hold(
+			&hold, cached->file, cached->src, cached->list);
+		pthread_mutex_unlock(&ofc_parse_file__include_lock);
+
+		if (!held)
+		{
+			*file = NULL;
+			return NULL;
+		}
+
+		*file = hold.file;
+		*src  = hold.src;
+		return hold.list;
+	}
+	pthread_mutex_unlock(&ofc_parse_file__include_lock);
+
+	/* The lock isn't held while parsing, since the file may
+	   itself include others. */
+	ofc_parse_stmt_list_t* list
+		= ofc_parse_file__include_load(
+			path, opts, include, file, src);
+	if (!list) return NULL;
+
+	/* Caching is best effort, the result is returned either way. */
+	ofc_parse_file__include_t* entry
+		= (ofc_parse_file__include_t*)malloc(
+			sizeof(ofc_parse_file__include_t));
+	if (entry)
+	{
+		*entry = key;
+		entry->path    = strdup(path);
+		entry->include = (include ? strdup(include) : NULL);
+
+		if (!entry->path || (include && !entry->include)
+			|| !ofc_parse_file__include_hold(
+				entry, *file, *src, list))
+		{
+			entry->file = NULL;
+			entry->src  = NULL;
+			entry->list = NULL;
+			ofc_parse_file__include_delete(entry);
+			entry = NULL;
+		}
+	}
+
+	if (entry)
+	{
+		pthread_mutex_lock(&ofc_parse_file__include_lock);
+
+		if (!ofc_parse_file__include_map)
+		{
+			ofc_parse_file__include_map = ofc_hashmap_create(
+				(void*)ofc_parse_file__include_hash,
+				(void*)ofc_parse_file__include_compare,
+				(void*)ofc_parse_file__include_key,
+				(void*)ofc_parse_file__include_delete);
+		}
+
+		ofc_parse_file__include_t* stale = NULL;
+		if (ofc_parse_file__include_map)
+		{
+			stale = ofc_hashmap_find_modify(
+				ofc_parse_file__include_map, entry);
+		}
+
+		if (stale)
+		{
+			/* Replace the old result without changing the key. */
+			ofc_parse_file__include_release(stale);
+			stale->mtime = entry->mtime;
+			stale->size  = entry->size;
+			stale->file  = entry->file;
+			stale->src   = entry->src;
+			stale->list  = entry->list;
+
+			entry->file = NULL;
+			entry->src  = NULL;
+			entry->list = NULL;
+		}
+		else if (ofc_parse_file__include_map
+			&& ofc_hashmap_add(ofc_parse_file__include_map, entry))
+		{
+			entry = NULL;
+		}
+
+		pthread_mutex_unlock(&ofc_parse_file__include_lock);
+		ofc_parse_file__include_delete(entry);
+	}
+
+	return list;
+}
+
+void ofc_parse_file_include_cache_clear(void)
+{
+	pthread_mutex_lock(&ofc_parse_file__include_lock);
+	ofc_hashmap_delete(ofc_parse_file__include_map);
+	ofc_parse_file__include_map = NULL;
+	pthread_mutex_unlock(&ofc_parse_file__include_lock);
+}
+
+
+/* Parse trees are stored on disk keyed by the path, options, size and
+   a 64-bit hash of the source. The key is stored along with the tree
+   and compared on load, so the source hash is checked before use. */
+#define OFC_PARSE_FILE__CACHE_MAGIC   "OFCP"
+#define OFC_PARSE_FILE__CACHE_VERSION 4
+
+static uint64_t ofc_parse_file__cache_hash(
+	uint64_t hash, const void* data, size_t size)
+{
+	const uint8_t* d = (const uint8_t*)data;
+	size_t i;
+	for (i = 0; i < size; i++)
+	{
+		hash ^= d[i];
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+static bool ofc_parse_file__cache_key_serialize(
+	ofc_serial_t* serial, const ofc_file_t* file)
+{
+	const char* path    = ofc_file_get_path(file);
+	const char* include = ofc_file_get_include(file);
+	const char* strz    = ofc_file_get_strz(file);
+	if (!path || !strz)
+		return false;
+
+	ofc_string_t spath = { .base = (char*)path, .size = strlen(path) };
+	ofc_string_t sinclude = { .base = (char*)include,
+		.size = (include ? strlen(include) : 0) };
+
+	size_t size = ofc_file_get_size(file);
+	return (ofc_serial_write_string(serial, &spath)
+		&& ofc_serial_write_string(serial, (include ? &sinclude : NULL))
+		&& ofc_serial_write_lang_opts(serial, ofc_file_get_lang_opts(file))
+		&& ofc_serial_write_uint(serial, size)
+		&& ofc_serial_write_uint(serial, ofc_parse_file__cache_hash(
+			0xCBF29CE484222325ULL, strz, size)));
+}
+
+static char* ofc_parse_file__cache_path(
+	const char* dir, const void* key, size_t size)
+{
+	uint64_t hash = ofc_parse_file__cache_hash(
+		0xCBF29CE484222325ULL, key, size);
+
+	size_t len = strlen(dir) + 32;
+	char* path = (char*)malloc(len);
+	if (!path) return NULL;
+
+	snprintf(path, len, "%s/%016llx.ofcp",
+		dir, (unsigned long long)hash);
+	return path;
+}
+
+static ofc_parse_stmt_list_t* ofc_parse_file__cache_deserialize(
+	const char* data, size_t size,
+	const void* key, size_t ksize,
+	ofc_file_t* file, ofc_sparse_t** src)
+{
+	ofc_serial_t* serial
+		= ofc_serial_create_read(data, size);
+	if (!serial) return NULL;
+
+	const char* magic = ofc_serial_read_data(
+		serial, strlen(OFC_PARSE_FILE__CACHE_MAGIC));
+	unsigned  version;
+	uintmax_t checksum;
+	if (!magic || (memcmp(magic, OFC_PARSE_FILE__CACHE_MAGIC,
+			strlen(OFC_PARSE_FILE__CACHE_MAGIC)) != 0)
+		|| !ofc_serial_read_unsigned(serial, &version)
+		|| (version != OFC_PARSE_FILE__CACHE_VERSION)
+		|| !ofc_serial_read_uint(serial, &checksum))
+	{
+		ofc_serial_delete(serial);
+		return NULL;
+	}
+
+	/* The whole payload is checked up front, since the tree refers
+	   back to shared objects by index without knowing their type. */
+	const char* payload = ofc_serial_read_data(serial, 0);
+	size_t      psize   = (size - (size_t)(payload - data));
+	if (ofc_parse_file__cache_hash(0xCBF29CE484222325ULL,
+		payload, psize) != checksum)
+	{
+		ofc_serial_delete(serial);
+		return NULL;
+	}
+
+	/* The stored key must match exactly, not just its hash. */
+	if ((psize < ksize) || (memcmp(payload, key, ksize) != 0)
+		|| !ofc_serial_read_data(serial, ksize))
+	{
+		ofc_serial_delete(serial);
+		return NULL;
+	}
+
+	ofc_sparse_t* sparse = ofc_sparse_deserialize(serial, file);
+	if (!sparse || !ofc_serial_object_add(serial, sparse))
+	{
+		ofc_sparse_delete(sparse);
+		ofc_serial_delete(serial);
+		return NULL;
+	}
+
+	ofc_arena_t* arena = ofc_arena_create();
+	if (!arena)
+	{
+		ofc_sparse_delete(sparse);
+		ofc_serial_delete(serial);
+		return NULL;
+	}
+
+	ofc_arena_t* outer = ofc_parse_arena_swap(arena);
+	ofc_serial_sparse_swap(serial, sparse);
+
+	ofc_parse_stmt_list_t* list = NULL;
+	bool success = (ofc_parse_stmt_list_deserialize(serial, &list)
+		&& list && ofc_serial_end(serial));
+
+	ofc_parse_arena_swap(outer);
+	ofc_serial_delete(serial);
+
+	if (!success)
+	{
+		ofc_parse_stmt_list_delete(list);
+		ofc_arena_delete(arena);
+		ofc_sparse_delete(sparse);
+		return NULL;
+	}
+	list->arena = arena;
+
+	*src = sparse;
+	return list;
+}
+
+ofc_parse_stmt_list_t* ofc_parse_file_cache_load(
+	const char* dir, ofc_file_t* file, ofc_sparse_t** src)
+{
+	if (!dir || !file || !src)
+		return NULL;
+
+	ofc_serial_t* key = ofc_serial_create();
+	if (!key || !ofc_parse_file__cache_key_serialize(key, file))
+	{
+		ofc_serial_delete(key);
+		return NULL;
+	}
+
+	size_t      ksize;
+	const void* kdata = ofc_serial_data(key, &ksize);
+
+	char* path = ofc_parse_file__cache_path(dir, kdata, ksize);
+	int fd = (path ? open(path, O_RDONLY) : -1);
+	free(path);
+
+	struct stat fs;
+	if ((fd < 0) || (fstat(fd, &fs) != 0)
+		|| !S_ISREG(fs.st_mode) || (fs.st_size <= 0))
+	{
+		if (fd >= 0) close(fd);
+		ofc_serial_delete(key);
+		return NULL;
+	}
+
+	size_t size = fs.st_size;
+	void* data = mmap(NULL, size,
+		PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	ofc_parse_stmt_list_t* list = NULL;
+	if (data != MAP_FAILED)
+	{
+		list = ofc_parse_file__cache_deserialize(
+			(const char*)data, size, kdata, ksize, file, src);
+		munmap(data, size);
+	}
+
+	ofc_serial_delete(key);
+	return list;
+}
+
+bool ofc_parse_file_cache_store(
+	const char* dir, const ofc_file_t* file,
+	const ofc_sparse_t* src, const ofc_parse_stmt_list_t* list)
+{
+	if (!dir || !file || !src || !list)
+		return false;
+
+	ofc_serial_t* serial = ofc_serial_create();
+	if (!serial) return false;
+
+	/* The key is at the start of the payload. */
+	size_t ksize;
+	if (!ofc_parse_file__cache_key_serialize(serial, file)
+		|| !ofc_serial_data(serial, &ksize))
+	{
+		ofc_serial_delete(serial);
+		return false;
+	}
+
+	/* Statements are written relative to the root source. */
+	ofc_serial_sparse_swap(serial, src);
+	if (!ofc_sparse_serialize(serial, src)
+		|| !ofc_serial_object_add(serial, (void*)src)
+		|| !ofc_parse_stmt_list_serialize(serial, list))
+	{
+		ofc_serial_delete(serial);
+		return false;
+	}
+
+	size_t      psize;
+	const void* payload = ofc_serial_data(serial, &psize);
+
+	ofc_serial_t* header = ofc_serial_create();
+	char* path = ofc_parse_file__cache_path(dir, payload, ksize);
+	bool success = (path && header
+		&& ofc_serial_write_data(header, OFC_PARSE_FILE__CACHE_MAGIC,
+			strlen(OFC_PARSE_FILE__CACHE_MAGIC))
+		&& ofc_serial_write_uint(header, OFC_PARSE_FILE__CACHE_VERSION)
+		&& ofc_serial_write_uint(header, ofc_parse_file__cache_hash(
+			0xCBF29CE484222325ULL, payload, psize)));
+
+	if (success && (mkdir(dir, 0777) != 0) && (errno != EEXIST))
+		success = false;
+
+	/* Written to a temporary file first, so a reader never sees
+	   a partial tree, even if several compilers share the cache. */
+	char* tpath = NULL;
+	if (success)
+	{
+		size_t tlen = strlen(path) + 32;
+		tpath = (char*)malloc(tlen);
+		if (tpath) snprintf(tpath, tlen, "%s.%ld.tmp", path, (long)getpid());
+	}
+
+	FILE* fp = (tpath ? fopen(tpath, "wb") : NULL);
+	if (fp)
+	{
+		size_t      hsize;
+		const void* hdata = ofc_serial_data(header, &hsize);
+		success = ((fwrite(hdata, 1, hsize, fp) == hsize)
+			&& (fwrite(payload, 1, psize, fp) == psize));
+		if (fclose(fp) != 0)
+			success = false;
+
+		if (!success || (rename(tpath, path) != 0))
+		{
+			unlink(tpath);
+			success = false;
+		}
+	}
+	else
+	{
+		success = false;
+	}
+
+	free(tpath);
+	free(path);
+	ofc_serial_delete(header);
+	ofc_serial_delete(serial);
+	return success;
+}
+
+
 bool ofc_parse_file_print(
 	ofc_colstr_t* cs,
 	const ofc_parse_stmt_list_t* list)
@@ -69,7 +69,7 @@ ofc_parse_format_desc_t* ofc_parse_format_desc(
 	unsigned* len)
 {
 	ofc_parse_format_desc_t* desc
-		= (ofc_parse_format_desc_t*)malloc(
+		= (ofc_parse_format_desc_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_format_desc_t));
 	if (!desc) return NULL;
 
@@ -127,7 +127,7 @@ ofc_parse_format_desc_t* ofc_parse_format_desc(
 		{
 			ofc_parse_format_desc_list_delete(
 				desc->repeat);
-			free(desc);
+			ofc_parse_free(desc);
 			ofc_parse_debug_rewind(debug, dpos);
 			return NULL;
 		}
@@ -148,7 +148,7 @@ ofc_parse_format_desc_t* ofc_parse_format_desc(
 		= ofc_parse_format_desc__map[m];
 	if (!map.name)
 	{
-		free(desc);
+		ofc_parse_free(desc);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -198,7 +198,7 @@ void ofc_parse_format_desc_delete(
 	{
 		case OFC_PARSE_FORMAT_DESC_HOLLERITH:
 		case OFC_PARSE_FORMAT_DESC_STRING:
-			ofc_string_delete(desc->string);
+			ofc_parse_string_delete(desc->string);
 			break;
 		case OFC_PARSE_FORMAT_DESC_REPEAT:
 			ofc_parse_format_desc_list_delete(desc->repeat);
@@ -206,7 +206,7 @@ void ofc_parse_format_desc_delete(
 		default:
 			break;
 	}
-	free(desc);
+	ofc_parse_free(desc);
 }
 
 const char* ofc_parse_format_desc__name[] =
@@ -367,7 +367,7 @@ static void ofc_parse_format_desc__cleanup(
 	{
 		case OFC_PARSE_FORMAT_DESC_STRING:
 		case OFC_PARSE_FORMAT_DESC_HOLLERITH:
-			ofc_string_delete(desc.string);
+			ofc_parse_string_delete(desc.string);
 			break;
 		case OFC_PARSE_FORMAT_DESC_REPEAT:
 			ofc_parse_format_desc_list_delete(desc.repeat);
@@ -389,7 +389,7 @@ static bool ofc_parse_format_desc__clone(
 	{
 		case OFC_PARSE_FORMAT_DESC_STRING:
 		case OFC_PARSE_FORMAT_DESC_HOLLERITH:
-			clone.string = ofc_string_copy(src->string);
+			clone.string = ofc_parse_string_copy(src->string);
 			if (src->string && !clone.string)
 				return false;
 			break;
@@ -409,7 +409,7 @@ static ofc_parse_format_desc_t* ofc_parse_format_desc__alloc(
 	ofc_parse_format_desc_t desc)
 {
 	ofc_parse_format_desc_t* adesc
-		= (ofc_parse_format_desc_t*)malloc(
+		= (ofc_parse_format_desc_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_format_desc_t));
 	if (!adesc) return NULL;
 	*adesc = desc;
@@ -437,7 +437,7 @@ ofc_parse_format_desc_list_t* ofc_parse_format_desc_list_copy(
 		return NULL;
 
 	ofc_parse_format_desc_list_t* copy
-		= (ofc_parse_format_desc_list_t*)malloc(
+		= (ofc_parse_format_desc_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_format_desc_list_t));
 	if (!copy) return NULL;
 
@@ -450,7 +450,7 @@ ofc_parse_format_desc_list_t* ofc_parse_format_desc_list_copy(
 		(void*)ofc_parse_format_desc_copy,
 		(void*)ofc_parse_format_desc_delete))
 	{
-		free(copy);
+		ofc_parse_free(copy);
 		return NULL;
 	}
 
@@ -463,7 +463,7 @@ ofc_parse_format_desc_list_t* ofc_parse_format_desc_list(
 	unsigned* len)
 {
 	ofc_parse_format_desc_list_t* list
-		= (ofc_parse_format_desc_list_t*)malloc(
+		= (ofc_parse_format_desc_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_format_desc_list_t));
 	if (!list) return NULL;
 
@@ -477,7 +477,7 @@ ofc_parse_format_desc_list_t* ofc_parse_format_desc_list(
 		(void*)ofc_parse_format_desc_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -494,7 +494,7 @@ void ofc_parse_format_desc_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->desc,
 		(void*)ofc_parse_format_desc_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_format_desc_list_print(
@@ -535,3 +535,116 @@ bool ofc_parse_format_is_data_desc(
 
 	return false;
 }
+
+bool ofc_parse_format_desc_serialize(
+	ofc_serial_t* serial, const ofc_parse_format_desc_t* desc)
+{
+	if (!desc)
+		return false;
+
+	if (!ofc_serial_write_uint(serial, desc->type)
+		|| !ofc_serial_write_bool(serial, desc->neg)
+		|| !ofc_serial_write_uint(serial, desc->n))
+		return false;
+
+	switch (desc->type)
+	{
+		case OFC_PARSE_FORMAT_DESC_STRING:
+		case OFC_PARSE_FORMAT_DESC_HOLLERITH:
+			return ofc_serial_write_string(
+				serial, desc->string);
+		case OFC_PARSE_FORMAT_DESC_REPEAT:
+			return ofc_parse_format_desc_list_serialize(
+				serial, desc->repeat);
+		default:
+			break;
+	}
+
+	return (ofc_serial_write_uint(serial, desc->w)
+		&& ofc_serial_write_uint(serial, desc->d)
+		&& ofc_serial_write_uint(serial, desc->e));
+}
+
+bool ofc_parse_format_desc_deserialize(
+	ofc_serial_t* serial, ofc_parse_format_desc_t** desc)
+{
+	if (!desc)
+		return false;
+
+	unsigned type;
+	ofc_parse_format_desc_t d;
+	if (!ofc_serial_read_unsigned(serial, &type)
+		|| (type >= OFC_PARSE_FORMAT_DESC_COUNT)
+		|| !ofc_serial_read_bool(serial, &d.neg)
+		|| !ofc_serial_read_unsigned(serial, &d.n))
+		return false;
+	d.type = type;
+
+	bool success;
+	switch (d.type)
+	{
+		case OFC_PARSE_FORMAT_DESC_STRING:
+		case OFC_PARSE_FORMAT_DESC_HOLLERITH:
+			success = ofc_parse_string_deserialize(
+				serial, &d.string);
+			break;
+		case OFC_PARSE_FORMAT_DESC_REPEAT:
+			success = ofc_parse_format_desc_list_deserialize(
+				serial, &d.repeat);
+			break;
+		default:
+			success = (ofc_serial_read_unsigned(serial, &d.w)
+				&& ofc_serial_read_unsigned(serial, &d.d)
+				&& ofc_serial_read_unsigned(serial, &d.e));
+			break;
+	}
+	if (!success) return false;
+
+	*desc = ofc_parse_format_desc__alloc(d);
+	if (!*desc)
+	{
+		ofc_parse_format_desc__cleanup(d);
+		return false;
+	}
+	return true;
+}
+
+bool ofc_parse_format_desc_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_format_desc_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->desc,
+		(void*)ofc_parse_format_desc_serialize));
+}
+
+bool ofc_parse_format_desc_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_format_desc_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_format_desc_list_t* l
+		= (ofc_parse_format_desc_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_format_desc_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->desc,
+		(void*)ofc_parse_format_desc_deserialize,
+		(void*)ofc_parse_format_desc_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
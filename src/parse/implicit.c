@@ -124,7 +124,7 @@ ofc_parse_implicit_t* ofc_parse_implicit(
 	i += l;
 
 	ofc_parse_implicit_t* aimplicit
-		= (ofc_parse_implicit_t*)malloc(
+		= (ofc_parse_implicit_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_implicit_t));
 	if (!aimplicit)
 	{
@@ -145,7 +145,7 @@ void ofc_parse_implicit_delete(
 		return;
 
 	ofc_parse_type_delete(implicit->type);
-	free(implicit);
+	ofc_parse_free(implicit);
 }
 
 bool ofc_parse_implicit_print(
@@ -201,7 +201,7 @@ ofc_parse_implicit_list_t* ofc_parse_implicit_list(
 	unsigned* len)
 {
 	ofc_parse_implicit_list_t* list
-		= (ofc_parse_implicit_list_t*)malloc(
+		= (ofc_parse_implicit_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_implicit_list_t));
 	if (!list) return NULL;
 
@@ -214,7 +214,7 @@ ofc_parse_implicit_list_t* ofc_parse_implicit_list(
 		(void*)ofc_parse_implicit_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -231,7 +231,7 @@ void ofc_parse_implicit_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->rule,
 		(void*)ofc_parse_implicit_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_implicit_list_print(
@@ -244,3 +244,80 @@ bool ofc_parse_implicit_list_print(
 		list->count, (const void**)list->rule,
 		(void*)ofc_parse_implicit_print);
 }
+
+bool ofc_parse_implicit_serialize(
+	ofc_serial_t* serial, const ofc_parse_implicit_t* implicit)
+{
+	if (!implicit)
+		return false;
+
+	return (ofc_parse_type_serialize(serial, implicit->type)
+		&& ofc_serial_write_uint(serial, implicit->mask));
+}
+
+bool ofc_parse_implicit_deserialize(
+	ofc_serial_t* serial, ofc_parse_implicit_t** implicit)
+{
+	if (!implicit)
+		return false;
+
+	ofc_parse_implicit_t* n
+		= (ofc_parse_implicit_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_implicit_t));
+	if (!n) return false;
+
+	n->type = NULL;
+
+	uintmax_t mask;
+	if (!ofc_parse_type_deserialize(serial, &n->type)
+		|| !ofc_serial_read_uint(serial, &mask)
+		|| (mask >= (1U << 26)))
+	{
+		ofc_parse_implicit_delete(n);
+		return false;
+	}
+	n->mask = mask;
+
+	*implicit = n;
+	return true;
+}
+
+bool ofc_parse_implicit_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_implicit_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->rule,
+		(void*)ofc_parse_implicit_serialize));
+}
+
+bool ofc_parse_implicit_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_implicit_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_implicit_list_t* l
+		= (ofc_parse_implicit_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_implicit_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->rule,
+		(void*)ofc_parse_implicit_deserialize,
+		(void*)ofc_parse_implicit_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
@@ -27,7 +27,7 @@ ofc_parse_implicit_do_t* ofc_parse_implicit_do(
 		return 0;
 
 	ofc_parse_implicit_do_t* id
-		= (ofc_parse_implicit_do_t*)malloc(
+		= (ofc_parse_implicit_do_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_implicit_do_t));
 	if (!id) return 0;
 
@@ -43,7 +43,7 @@ ofc_parse_implicit_do_t* ofc_parse_implicit_do(
 		src, &ptr[i], debug, &l);
 	if (!id->dlist)
 	{
-		free(id);
+		ofc_parse_free(id);
 		return 0;
 	}
 	i += l;
@@ -115,7 +115,7 @@ ofc_parse_implicit_do_t* ofc_parse_implicit_do_copy(
 		return NULL;
 
 	ofc_parse_implicit_do_t* copy
-		= (ofc_parse_implicit_do_t*)malloc(
+		= (ofc_parse_implicit_do_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_implicit_do_t));
 	if (!copy) return NULL;
 
@@ -145,7 +145,7 @@ void ofc_parse_implicit_do_delete(
 	ofc_parse_assign_delete(id->init);
 	ofc_parse_expr_delete(id->limit);
 	ofc_parse_expr_delete(id->step);
-	free(id);
+	ofc_parse_free(id);
 }
 
 bool ofc_parse_implicit_do_print(
@@ -168,3 +168,50 @@ bool ofc_parse_implicit_do_print(
 
 	return ofc_colstr_atomic_writef(cs, ")");
 }
+
+bool ofc_parse_implicit_do_serialize(
+	ofc_serial_t* serial, const ofc_parse_implicit_do_t* id)
+{
+	if (!ofc_serial_write_bool(serial, (id != NULL)))
+		return false;
+
+	return (!id
+		|| (ofc_parse_lhs_serialize(serial, id->dlist)
+			&& ofc_parse_assign_serialize(serial, id->init)
+			&& ofc_parse_expr_serialize(serial, id->limit)
+			&& ofc_parse_expr_serialize(serial, id->step)));
+}
+
+bool ofc_parse_implicit_do_deserialize(
+	ofc_serial_t* serial, ofc_parse_implicit_do_t** id)
+{
+	bool present;
+	if (!id || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*id = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_implicit_do_t* n
+		= (ofc_parse_implicit_do_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_implicit_do_t));
+	if (!n) return false;
+
+	n->dlist = NULL;
+	n->init  = NULL;
+	n->limit = NULL;
+	n->step  = NULL;
+
+	if (!ofc_parse_lhs_deserialize(serial, &n->dlist)
+		|| !ofc_parse_assign_deserialize(serial, &n->init)
+		|| !ofc_parse_expr_deserialize(serial, &n->limit)
+		|| !ofc_parse_expr_deserialize(serial, &n->step))
+	{
+		ofc_parse_implicit_do_delete(n);
+		return false;
+	}
+
+	*id = n;
+	return true;
+}
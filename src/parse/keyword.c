@@ -15,97 +15,137 @@
 
 #include <ofc/parse.h>
 #include <string.h>
+#include <stdlib.h>
 #include <ctype.h>
+#include <pthread.h>
 
 
 
-static const char* ofc_parse_keyword__name[] =
+/* Keywords are matched without their spaces, space marks where
+   the space goes in the name of a spaced keyword. */
+typedef struct
 {
-	"INCLUDE",
-
-	"PROGRAM",
-	"SUBROUTINE",
-	"FUNCTION",
-	"BLOCK DATA",
-
-	"STRUCTURE",
-	"UNION",
-	"MAP",
-	"RECORD",
-
-	"IF",
-	"THEN",
-	"ELSE",
-	"GO TO",
-	"DO",
-	"WHILE",
-	"CONTINUE",
-	"STOP",
-	"PAUSE",
-	"CYCLE",
-	"EXIT",
-
-	"LOGICAL",
-	"CHARACTER",
-	"INTEGER",
-	"REAL",
-	"COMPLEX",
-	"BYTE",
-	"DOUBLE PRECISION",
-	"DOUBLE COMPLEX",
-
-	"TRUE",
-	"FALSE",
-
-	"IMPLICIT",
-	"IMPLICIT NONE",
-
-	"COMMON",
-	"NAMELIST",
-	"DIMENSION",
-	"VIRTUAL",
-	"EQUIVALENCE",
-
-	"KIND",
-
-	"ASSIGN",
-	"TO",
-
-	"CALL",
-	"ENTRY",
-	"RETURN",
-
-	"EXTERNAL",
-	"INTRINSIC",
-	"AUTOMATIC",
-	"STATIC",
-	"VOLATILE",
-	"POINTER",
-
-	"DATA",
-	"PARAMETER",
-	"SAVE",
-
-	"FORMAT",
-
-	"OPEN",
-	"INQUIRE",
-	"REWIND",
-	"BACKSPACE",
-	"READ",
-	"WRITE",
-	"END FILE",
-	"CLOSE",
-	"PRINT",
-	"TYPE",
-	"ENCODE",
-	"DECODE",
-	"ACCEPT",
-	"DEFINE FILE",
-
-	NULL
+	const char* name;
+	const char* match;
+	unsigned    len, space;
+} ofc_parse_keyword__t;
+
+#define OFC_PARSE_KEYWORD__PLAIN(n) { n, n, (sizeof(n) - 1), 0 }
+#define OFC_PARSE_KEYWORD__SPACED(a, b) \
+	{ a " " b, a b, (sizeof(a b) - 1), (sizeof(a) - 1) }
+
+static const ofc_parse_keyword__t ofc_parse_keyword__table[OFC_PARSE_KEYWORD_COUNT] =
+{
+	OFC_PARSE_KEYWORD__PLAIN("INCLUDE"),
+
+	OFC_PARSE_KEYWORD__PLAIN("PROGRAM"),
+	OFC_PARSE_KEYWORD__PLAIN("SUBROUTINE"),
+	OFC_PARSE_KEYWORD__PLAIN("FUNCTION"),
+	OFC_PARSE_KEYWORD__SPACED("BLOCK", "DATA"),
+
+	OFC_PARSE_KEYWORD__PLAIN("STRUCTURE"),
+	OFC_PARSE_KEYWORD__PLAIN("UNION"),
+	OFC_PARSE_KEYWORD__PLAIN("MAP"),
+	OFC_PARSE_KEYWORD__PLAIN("RECORD"),
+
+	OFC_PARSE_KEYWORD__PLAIN("IF"),
+	OFC_PARSE_KEYWORD__PLAIN("THEN"),
+	OFC_PARSE_KEYWORD__PLAIN("ELSE"),
+	OFC_PARSE_KEYWORD__SPACED("GO", "TO"),
+	OFC_PARSE_KEYWORD__PLAIN("DO"),
+	OFC_PARSE_KEYWORD__PLAIN("WHILE"),
+	OFC_PARSE_KEYWORD__PLAIN("CONTINUE"),
+	OFC_PARSE_KEYWORD__PLAIN("STOP"),
+	OFC_PARSE_KEYWORD__PLAIN("PAUSE"),
+	OFC_PARSE_KEYWORD__PLAIN("CYCLE"),
+	OFC_PARSE_KEYWORD__PLAIN("EXIT"),
+
+	OFC_PARSE_KEYWORD__PLAIN("LOGICAL"),
+	OFC_PARSE_KEYWORD__PLAIN("CHARACTER"),
+	OFC_PARSE_KEYWORD__PLAIN("INTEGER"),
+	OFC_PARSE_KEYWORD__PLAIN("REAL"),
+	OFC_PARSE_KEYWORD__PLAIN("COMPLEX"),
+	OFC_PARSE_KEYWORD__PLAIN("BYTE"),
+	OFC_PARSE_KEYWORD__SPACED("DOUBLE", "PRECISION"),
+	OFC_PARSE_KEYWORD__SPACED("DOUBLE", "COMPLEX"),
+
+	OFC_PARSE_KEYWORD__PLAIN("TRUE"),
+	OFC_PARSE_KEYWORD__PLAIN("FALSE"),
+
+	OFC_PARSE_KEYWORD__PLAIN("IMPLICIT"),
+	OFC_PARSE_KEYWORD__SPACED("IMPLICIT", "NONE"),
+
+	OFC_PARSE_KEYWORD__PLAIN("COMMON"),
+	OFC_PARSE_KEYWORD__PLAIN("NAMELIST"),
+	OFC_PARSE_KEYWORD__PLAIN("DIMENSION"),
+	OFC_PARSE_KEYWORD__PLAIN("VIRTUAL"),
+	OFC_PARSE_KEYWORD__PLAIN("EQUIVALENCE"),
+
+	OFC_PARSE_KEYWORD__PLAIN("KIND"),
+
+	OFC_PARSE_KEYWORD__PLAIN("ASSIGN"),
+	OFC_PARSE_KEYWORD__PLAIN("TO"),
+
+	OFC_PARSE_KEYWORD__PLAIN("CALL"),
+	OFC_PARSE_KEYWORD__PLAIN("ENTRY"),
+	OFC_PARSE_KEYWORD__PLAIN("RETURN"),
+
+	OFC_PARSE_KEYWORD__PLAIN("EXTERNAL"),
+	OFC_PARSE_KEYWORD__PLAIN("INTRINSIC"),
+	OFC_PARSE_KEYWORD__PLAIN("AUTOMATIC"),
+	OFC_PARSE_KEYWORD__PLAIN("STATIC"),
+	OFC_PARSE_KEYWORD__PLAIN("VOLATILE"),
+	OFC_PARSE_KEYWORD__PLAIN("POINTER"),
+
+	OFC_PARSE_KEYWORD__PLAIN("DATA"),
+	OFC_PARSE_KEYWORD__PLAIN("PARAMETER"),
+	OFC_PARSE_KEYWORD__PLAIN("SAVE"),
+
+	OFC_PARSE_KEYWORD__PLAIN("FORMAT"),
+
+	OFC_PARSE_KEYWORD__PLAIN("OPEN"),
+	OFC_PARSE_KEYWORD__PLAIN("INQUIRE"),
+	OFC_PARSE_KEYWORD__PLAIN("REWIND"),
+	OFC_PARSE_KEYWORD__PLAIN("BACKSPACE"),
+	OFC_PARSE_KEYWORD__PLAIN("READ"),
+	OFC_PARSE_KEYWORD__PLAIN("WRITE"),
+	OFC_PARSE_KEYWORD__SPACED("END", "FILE"),
+	OFC_PARSE_KEYWORD__PLAIN("CLOSE"),
+	OFC_PARSE_KEYWORD__PLAIN("PRINT"),
+	OFC_PARSE_KEYWORD__PLAIN("TYPE"),
+	OFC_PARSE_KEYWORD__PLAIN("ENCODE"),
+	OFC_PARSE_KEYWORD__PLAIN("DECODE"),
+	OFC_PARSE_KEYWORD__PLAIN("ACCEPT"),
+	OFC_PARSE_KEYWORD__SPACED("DEFINE", "FILE"),
 };
 
+/* The keywords ordered by their match strings, so that every keyword
+   which shares a prefix is in a single run, this works like a trie.
+   It's sorted from the table on first use so it can't fall out of step. */
+static ofc_parse_keyword_e ofc_parse_keyword__sorted[OFC_PARSE_KEYWORD_COUNT];
+static pthread_once_t ofc_parse_keyword__sorted_once = PTHREAD_ONCE_INIT;
+
+static int ofc_parse_keyword__sorted_compare(
+	const void* a, const void* b)
+{
+	const ofc_parse_keyword_e* ka = (const ofc_parse_keyword_e*)a;
+	const ofc_parse_keyword_e* kb = (const ofc_parse_keyword_e*)b;
+	return strcmp(
+		ofc_parse_keyword__table[*ka].match,
+		ofc_parse_keyword__table[*kb].match);
+}
+
+static void ofc_parse_keyword__sorted_init(void)
+{
+	unsigned i;
+	for (i = 0; i < OFC_PARSE_KEYWORD_COUNT; i++)
+		ofc_parse_keyword__sorted[i] = (ofc_parse_keyword_e)i;
+
+	qsort(ofc_parse_keyword__sorted, OFC_PARSE_KEYWORD_COUNT,
+		sizeof(ofc_parse_keyword__sorted[0]),
+		ofc_parse_keyword__sorted_compare);
+}
+
 
 
 unsigned ofc_parse_ident(
@@ -128,7 +168,7 @@ unsigned ofc_parse_ident(
 			i, ptr);
 	}
 
-	if (ident) *ident = ofc_str_ref(ptr, i);
+	if (ident) *ident = ofc_str_ref_intern(ptr, i);
 	return i;
 }
 
@@ -158,7 +198,7 @@ ofc_str_ref_t* ofc_parse_name_alloc(
 	if (i == 0) return NULL;
 
 	ofc_str_ref_t* aname
-		= (ofc_str_ref_t*)malloc(
+		= (ofc_str_ref_t*)ofc_parse_alloc(
 			sizeof(ofc_str_ref_t));
 	if (!aname) return NULL;
 	*aname = name;
@@ -173,7 +213,70 @@ const char* ofc_parse_keyword_name(
 {
 	if (keyword >= OFC_PARSE_KEYWORD_COUNT)
 		return NULL;
-	return ofc_parse_keyword__name[keyword];
+	return ofc_parse_keyword__table[keyword].name;
+}
+
+unsigned ofc_parse_keyword_match(
+	const char* ptr,
+	ofc_parse_keyword_e* keyword, unsigned max)
+{
+	pthread_once(&ofc_parse_keyword__sorted_once,
+		ofc_parse_keyword__sorted_init);
+
+	unsigned lo = 0;
+	unsigned hi = OFC_PARSE_KEYWORD_COUNT;
+
+	unsigned count = 0;
+	unsigned i;
+	for (i = 0; lo < hi; i++)
+	{
+		/* Keywords which end here sort first in the run. */
+		while ((lo < hi) && (ofc_parse_keyword__table[
+			ofc_parse_keyword__sorted[lo]].len == i))
+		{
+			if (keyword && (count < max))
+				keyword[count] = ofc_parse_keyword__sorted[lo];
+			count++;
+			lo++;
+		}
+
+		char c = toupper(ptr[i]);
+		if (c == '\0') break;
+
+		while ((lo < hi) && (ofc_parse_keyword__table[
+			ofc_parse_keyword__sorted[lo]].match[i] < c))
+			lo++;
+
+		unsigned end;
+		for (end = lo; (end < hi) && (ofc_parse_keyword__table[
+			ofc_parse_keyword__sorted[end]].match[i] == c); end++);
+		hi = end;
+	}
+
+	return count;
+}
+
+static bool ofc_parse_keyword__match(
+	const char* ptr, const char* match, unsigned len)
+{
+	unsigned i;
+	for (i = 0; i < len; i++)
+	{
+		if (toupper(ptr[i]) != match[i])
+			return false;
+	}
+	return true;
+}
+
+/* Checks a range relative to ptr against the sequential run length
+   from ptr, only looking it up again if it starts past that run. */
+static bool ofc_parse_keyword__sequential(
+	const ofc_sparse_t* src, const char* ptr, unsigned run,
+	unsigned offset, unsigned size)
+{
+	if (offset < run)
+		return ((offset + size) <= run);
+	return ofc_sparse_sequential(src, &ptr[offset], size);
 }
 
 unsigned ofc_parse_keyword_named(
@@ -185,68 +288,26 @@ unsigned ofc_parse_keyword_named(
 	if (keyword >= OFC_PARSE_KEYWORD_COUNT)
 		return 0;
 
-	const char* kwstr = ofc_parse_keyword__name[keyword];
-
-	/* TODO - Make handling spaced keywords less manual. */
-	unsigned space = 0;
-	/* Use this to make spaces in F90 keywords non-optional. */
-	bool space_optional = true;
-	switch (keyword)
-	{
-		case OFC_PARSE_KEYWORD_BLOCK_DATA:
-			kwstr = "BLOCKDATA";
-			space = 5;
-			break;
-		case OFC_PARSE_KEYWORD_GO_TO:
-			kwstr = "GOTO";
-			space = 2;
-			break;
-		case OFC_PARSE_KEYWORD_DOUBLE_PRECISION:
-			kwstr = "DOUBLEPRECISION";
-			space = 6;
-			break;
-		case OFC_PARSE_KEYWORD_DOUBLE_COMPLEX:
-			kwstr = "DOUBLECOMPLEX";
-			space = 6;
-			break;
-		case OFC_PARSE_KEYWORD_IMPLICIT_NONE:
-			kwstr = "IMPLICITNONE";
-			space = 8;
-			break;
-		case OFC_PARSE_KEYWORD_END_FILE:
-			kwstr = "ENDFILE";
-			space = 3;
-			break;
-		case OFC_PARSE_KEYWORD_DEFINE_FILE:
-			kwstr = "DEFINEFILE";
-			space = 6;
-			break;
-
-		default:
-			break;
-	}
+	const ofc_parse_keyword__t* kw
+		= &ofc_parse_keyword__table[keyword];
+	const char* kwstr = kw->match;
 
-	unsigned len = strlen(kwstr);
-	if (strncasecmp(ptr, kwstr, len) != 0)
+	unsigned len = kw->len;
+	if (!ofc_parse_keyword__match(ptr, kwstr, len))
 		return 0;
 
-	bool entirely_sequential
-		= ofc_sparse_sequential(src, ptr, len);
+	/* Every spacing diagnostic is answered from this one lookup,
+	   unless the keyword itself is split. */
+	unsigned run = ofc_sparse_sequential_len(src, ptr);
 
-	bool unexpected_space = !entirely_sequential;
-	if (space > 0)
+	bool unexpected_space = (len > run);
+	if (kw->space > 0)
 	{
+		unsigned space  = kw->space;
 		unsigned remain = (len - space);
-		unexpected_space = (!ofc_sparse_sequential(src, ptr, space)
-			|| !ofc_sparse_sequential(src, &ptr[space], remain));
-
-		if (entirely_sequential && !space_optional)
-		{
-			ofc_parse_debug_warning(debug,
-				ofc_sparse_ref(src, &ptr[space], 0),
-				"Expected a space between keywords '%.*s' and '%.*s'",
-				space, ptr, remain, &ptr[space]);
-		}
+		unexpected_space = ((space > run)
+			|| !ofc_parse_keyword__sequential(
+				src, ptr, run, space, remain));
 	}
 
 	if (unexpected_space)
@@ -261,8 +322,8 @@ unsigned ofc_parse_keyword_named(
 		unsigned nlen = ofc_parse_name(
 			src, &ptr[len], debug, name);
 
-		if ((nlen > 0) && ofc_sparse_sequential(
-			src, &ptr[len - 1], 2))
+		if ((nlen > 0) && ofc_parse_keyword__sequential(
+			src, ptr, run, (len - 1), 2))
 		{
 			ofc_parse_debug_warning(debug,
 				ofc_sparse_ref(src, &ptr[len], 0),
@@ -276,7 +337,8 @@ unsigned ofc_parse_keyword_named(
 	bool ofc_is_ident  = (isalpha(ptr[len]) || (ptr[len] == '_'));
 
 	if ((is_number || ofc_is_ident)
-		&& ofc_sparse_sequential(src, &ptr[len - 1], 2))
+		&& ofc_parse_keyword__sequential(
+			src, ptr, run, (len - 1), 2))
 	{
 		if (!name && (keyword == OFC_PARSE_KEYWORD_ELSE)
 			&& (strncasecmp(&ptr[len], "IF", 2) == 0))
@@ -352,9 +414,9 @@ unsigned ofc_parse_keyword_end_named(
 		ofc_parse_debug_warning(debug,
 			ofc_sparse_ref(src, kname.base, kname.size),
 			"END %s name '%.*s' doesn't match %s name '%.*s'",
-			ofc_parse_keyword__name[keyword],
+			ofc_parse_keyword__table[keyword].name,
 			kname.size, kname.base,
-			ofc_parse_keyword__name[keyword],
+			ofc_parse_keyword__table[keyword].name,
 			name->size, name->base);
 	}
 
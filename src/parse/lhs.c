@@ -51,7 +51,7 @@ static ofc_parse_lhs_t* ofc_parse_lhs__alloc(
 	ofc_parse_lhs_t lhs)
 {
 	ofc_parse_lhs_t* alhs
-		= (ofc_parse_lhs_t*)malloc(
+		= (ofc_parse_lhs_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_lhs_t));
 	if (!alhs) return NULL;
 
@@ -378,13 +378,42 @@ static ofc_parse_lhs_t* ofc_parse__lhs(
 	return alhs;
 }
 
+static ofc_parse_lhs_t* ofc_parse_lhs__memo(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug, bool allow_array,
+	bool star_len, ofc_parse_memo_e kind,
+	unsigned* len)
+{
+	void*    node;
+	unsigned i;
+	if (ofc_parse_memo_find(kind, ptr, &node, &i))
+	{
+		if (node && len) *len = i;
+		return (ofc_parse_lhs_t*)node;
+	}
+
+	unsigned dpos = ofc_parse_debug_position(debug);
+
+	i = 0;
+	ofc_parse_lhs_t* lhs = ofc_parse__lhs(
+		src, ptr, debug, allow_array, star_len, &i);
+
+	/* A shared result wouldn't raise its messages again. */
+	if (ofc_parse_debug_position(debug) == dpos)
+		ofc_parse_memo_add(kind, ptr, lhs, i);
+
+	if (lhs && len) *len = i;
+	return lhs;
+}
+
 ofc_parse_lhs_t* ofc_parse_lhs_star_len(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
 	unsigned* len)
 {
-	return ofc_parse__lhs(
-		src, ptr, debug, true , true, len);
+	return ofc_parse_lhs__memo(
+		src, ptr, debug, true , true,
+		OFC_PARSE_MEMO_LHS_STAR_LEN, len);
 }
 
 ofc_parse_lhs_t* ofc_parse_lhs_variable(
@@ -392,8 +421,9 @@ ofc_parse_lhs_t* ofc_parse_lhs_variable(
 	ofc_parse_debug_t* debug,
 	unsigned* len)
 {
-	return ofc_parse__lhs(
-		src, ptr, debug, false, false ,len);
+	return ofc_parse_lhs__memo(
+		src, ptr, debug, false, false,
+		OFC_PARSE_MEMO_LHS_VARIABLE, len);
 }
 
 ofc_parse_lhs_t* ofc_parse_lhs(
@@ -401,8 +431,9 @@ ofc_parse_lhs_t* ofc_parse_lhs(
 	ofc_parse_debug_t* debug,
 	unsigned* len)
 {
-	return ofc_parse__lhs(
-		src, ptr, debug, true, false ,len);
+	return ofc_parse_lhs__memo(
+		src, ptr, debug, true, false,
+		OFC_PARSE_MEMO_LHS, len);
 }
 
 
@@ -434,7 +465,7 @@ void ofc_parse_lhs_delete(
 		return;
 
 	ofc_parse_lhs__cleanup(*lhs);
-	free(lhs);
+	ofc_parse_free(lhs);
 }
 
 bool ofc_parse_lhs_print(
@@ -495,6 +526,123 @@ bool ofc_parse_lhs_print(
 	return false;
 }
 
+bool ofc_parse_lhs_serialize(
+	ofc_serial_t* serial, const ofc_parse_lhs_t* lhs)
+{
+	if (!ofc_serial_write_bool(serial, (lhs != NULL)))
+		return false;
+	if (!lhs)
+		return true;
+
+	if (!ofc_serial_write_uint(serial, lhs->type)
+		|| !ofc_serial_write_str_ref(serial, lhs->src))
+		return false;
+
+	switch (lhs->type)
+	{
+		case OFC_PARSE_LHS_VARIABLE:
+			return ofc_serial_write_str_ref(
+				serial, lhs->variable);
+		case OFC_PARSE_LHS_ARRAY:
+			return (ofc_parse_lhs_serialize(serial, lhs->parent)
+				&& ofc_parse_array_index_serialize(serial, lhs->array.index));
+		case OFC_PARSE_LHS_STAR_LEN:
+			return (ofc_parse_lhs_serialize(serial, lhs->parent)
+				&& ofc_parse_expr_serialize(serial, lhs->star_len.len)
+				&& ofc_serial_write_bool(serial, lhs->star_len.var));
+		case OFC_PARSE_LHS_MEMBER_TYPE:
+		case OFC_PARSE_LHS_MEMBER_STRUCTURE:
+			return (ofc_parse_lhs_serialize(serial, lhs->parent)
+				&& ofc_serial_write_str_ref(serial, lhs->member.name));
+		case OFC_PARSE_LHS_IMPLICIT_DO:
+			return ofc_parse_implicit_do_serialize(
+				serial, lhs->implicit_do);
+		default:
+			break;
+	}
+
+	return false;
+}
+
+bool ofc_parse_lhs_deserialize(
+	ofc_serial_t* serial, ofc_parse_lhs_t** lhs)
+{
+	bool present;
+	if (!lhs || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	if (!present)
+	{
+		*lhs = NULL;
+		return true;
+	}
+
+	unsigned type;
+	ofc_parse_lhs_t l;
+	if (!ofc_serial_read_unsigned(serial, &type)
+		|| !ofc_serial_read_str_ref(serial, &l.src))
+		return false;
+	l.type = type;
+
+	bool success = false;
+	switch (l.type)
+	{
+		case OFC_PARSE_LHS_VARIABLE:
+			success = ofc_serial_read_str_ref(
+				serial, &l.variable);
+			break;
+		case OFC_PARSE_LHS_ARRAY:
+			if (!ofc_parse_lhs_deserialize(serial, &l.parent))
+				break;
+			success = ofc_parse_array_index_deserialize(
+				serial, &l.array.index);
+			if (!success)
+				ofc_parse_lhs_delete(l.parent);
+			break;
+		case OFC_PARSE_LHS_STAR_LEN:
+			if (!ofc_parse_lhs_deserialize(serial, &l.parent))
+				break;
+			if (!ofc_parse_expr_deserialize(serial, &l.star_len.len))
+			{
+				ofc_parse_lhs_delete(l.parent);
+				break;
+			}
+			success = ofc_serial_read_bool(
+				serial, &l.star_len.var);
+			if (!success)
+			{
+				ofc_parse_expr_delete(l.star_len.len);
+				ofc_parse_lhs_delete(l.parent);
+			}
+			break;
+		case OFC_PARSE_LHS_MEMBER_TYPE:
+		case OFC_PARSE_LHS_MEMBER_STRUCTURE:
+			if (!ofc_parse_lhs_deserialize(serial, &l.parent))
+				break;
+			success = ofc_serial_read_str_ref(
+				serial, &l.member.name);
+			if (!success)
+				ofc_parse_lhs_delete(l.parent);
+			break;
+		case OFC_PARSE_LHS_IMPLICIT_DO:
+			success = ofc_parse_implicit_do_deserialize(
+				serial, &l.implicit_do);
+			break;
+		default:
+			break;
+	}
+	if (!success) return false;
+
+	*lhs = ofc_parse_lhs__alloc(l);
+	if (!*lhs)
+	{
+		ofc_parse_lhs__cleanup(l);
+		return false;
+	}
+	return true;
+}
+
+
 static bool ofc_parse_lhs_print__decl(
 	ofc_colstr_t* cs, const ofc_parse_lhs_t* lhs)
 {
@@ -565,7 +713,7 @@ ofc_parse_lhs_list_t* ofc_parse_lhs_list(
 	unsigned* len)
 {
 	ofc_parse_lhs_list_t* list
-		= (ofc_parse_lhs_list_t*)malloc(
+		= (ofc_parse_lhs_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_lhs_list_t));
 	if (!list) return NULL;
 
@@ -579,7 +727,7 @@ ofc_parse_lhs_list_t* ofc_parse_lhs_list(
 		(void*)ofc_parse_lhs_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -625,7 +773,7 @@ void ofc_parse_lhs_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->lhs,
 		(void*)ofc_parse_lhs_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_lhs_list_print(
@@ -647,3 +795,43 @@ bool ofc_parse_lhs_list_bracketed_print(
 		&& ofc_parse_lhs_list_print(cs, list, is_decl)
 		&& ofc_colstr_atomic_writef(cs, ")"));
 }
+
+bool ofc_parse_lhs_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_lhs_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->lhs,
+		(void*)ofc_parse_lhs_serialize));
+}
+
+bool ofc_parse_lhs_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_lhs_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_lhs_list_t* l
+		= (ofc_parse_lhs_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_lhs_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->lhs,
+		(void*)ofc_parse_lhs_deserialize,
+		(void*)ofc_parse_lhs_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
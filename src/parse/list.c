@@ -54,7 +54,7 @@ static unsigned ofc_parse_list__seperator_optional(
 			max_count <<= 1;
 			if (max_count == 0)
 				max_count = 4;
-			void** nelem = realloc(*elem,
+			void** nelem = ofc_parse_realloc(*elem,
 				(max_count * sizeof(void*)));
 			if (!nelem)
 			{
@@ -67,7 +67,7 @@ static unsigned ofc_parse_list__seperator_optional(
 
 				if (orig_count == 0)
 				{
-					free(*elem);
+					ofc_parse_free(*elem);
 					*elem = NULL;
 				}
 
@@ -117,7 +117,7 @@ bool ofc_parse_list_copy(
 	if (!elem_copy || !src || !dst || !dst_count)
 		return false;
 
-	void** copy = (void**)malloc(
+	void** copy = (void**)ofc_parse_alloc(
 		src_count * sizeof(void*));
 	if (!copy) return false;
 
@@ -133,7 +133,7 @@ bool ofc_parse_list_copy(
 				for (j = 0; j < i; j++)
 					elem_delete(copy[j]);
 			}
-			free(copy);
+			ofc_parse_free(copy);
 			return false;
 		}
 	}
@@ -153,7 +153,7 @@ void ofc_parse_list_delete(
 	unsigned i;
 	for (i = 0; i < elem_count; i++)
 		elem_delete(elem[i]);
-	free(elem);
+	ofc_parse_free(elem);
 }
 
 
@@ -177,3 +177,70 @@ bool ofc_parse_list_print(
 
 	return true;
 }
+
+
+bool ofc_parse_list_serialize(
+	ofc_serial_t* serial,
+	unsigned elem_count, const void** elem,
+	bool (*elem_serialize)(ofc_serial_t*, const void*))
+{
+	if (!elem_serialize || (!elem && (elem_count > 0)))
+		return false;
+
+	if (!ofc_serial_write_uint(serial, elem_count))
+		return false;
+
+	unsigned i;
+	for (i = 0; i < elem_count; i++)
+	{
+		if (!elem_serialize(serial, elem[i]))
+			return false;
+	}
+
+	return true;
+}
+
+bool ofc_parse_list_deserialize(
+	ofc_serial_t* serial,
+	unsigned* elem_count, void*** elem,
+	bool (*elem_deserialize)(ofc_serial_t*, void**),
+	void (*elem_delete)(void*))
+{
+	if (!elem_deserialize || !elem || !elem_count)
+		return false;
+
+	unsigned count;
+	if (!ofc_serial_read_unsigned(serial, &count))
+		return false;
+
+	if (count == 0)
+	{
+		*elem = NULL;
+		*elem_count = 0;
+		return true;
+	}
+
+	void** list = (void**)ofc_parse_alloc(
+		count * sizeof(void*));
+	if (!list) return false;
+
+	unsigned i;
+	for (i = 0; i < count; i++)
+	{
+		if (!elem_deserialize(serial, &list[i]))
+		{
+			if (elem_delete)
+			{
+				unsigned j;
+				for (j = 0; j < i; j++)
+					elem_delete(list[j]);
+			}
+			ofc_parse_free(list);
+			return false;
+		}
+	}
+
+	*elem = list;
+	*elem_count = count;
+	return true;
+}
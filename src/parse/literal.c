@@ -226,13 +226,16 @@ ofc_string_t* ofc_parse_hollerith(
 	if (toupper(ptr[i]) != 'H')
 		return NULL;
 
-	char s[holl_len + 1];
-
 	const char* pptr
 		= ofc_sparse_parent_pointer(src, &ptr[i]);
 	if (!pptr) return NULL;
 	i += 1;
 
+	/* The string is filled in place, rather than through a copy. */
+	ofc_string_t* string
+		= ofc_parse_string_create(NULL, holl_len);
+	if (!string) return NULL;
+
 	unsigned j, holl_pos;
 	for (j = 1, holl_pos = 0; holl_pos < holl_len; j++)
 	{
@@ -244,20 +247,11 @@ ofc_string_t* ofc_parse_hollerith(
 		if (ptr[i] == pptr[j])
 			i++;
 
-		s[holl_pos++] = pptr[j];
+		string->base[holl_pos++] = pptr[j];
 	}
 
-	if (holl_pos < holl_len)
-	{
-		while (holl_pos < holl_len)
-			s[holl_pos++] = ' ';
-	}
-
-	s[holl_pos] = '\0';
-
-	ofc_string_t* string
-		= ofc_string_create(s, holl_len);
-	if (!string) return NULL;
+	while (holl_pos < holl_len)
+		string->base[holl_pos++] = ' ';
 
 	if (len) *len = i;
 	return string;
@@ -371,7 +365,7 @@ ofc_string_t* ofc_parse_character(
 	unsigned str_pos = 0;
 	unsigned str_end = j;
 
-	ofc_string_t* string = ofc_string_create(NULL, str_len);
+	ofc_string_t* string = ofc_parse_string_create(NULL, str_len);
 	if (!string) return NULL;
 
 	for(j = 1, is_escaped = false; j < str_end; j++)
@@ -530,9 +524,9 @@ unsigned ofc_parse_literal_number(
 		{
 			for (; isdigit(ptr[j]); j++);
 
-			if (toupper(ptr[j]) == 'D')
+			if (toupper(ptr[i]) == 'D')
 				k = 8;
-			else if (toupper(ptr[j]) == 'Q')
+			else if (toupper(ptr[i]) == 'Q')
 				k = 16;
 
 			i = j;
@@ -585,6 +579,7 @@ unsigned ofc_parse_literal_integer(
 
 	literal->type = OFC_PARSE_LITERAL_NUMBER;
 	literal->kind = 0;
+	literal->src = ofc_str_ref(ptr, i);
 	literal->number = ofc_str_ref(ptr, i);
 	return i;
 }
@@ -672,7 +667,7 @@ void ofc_parse_literal_cleanup(
 	{
 		case OFC_PARSE_LITERAL_CHARACTER:
 		case OFC_PARSE_LITERAL_HOLLERITH:
-			ofc_string_delete(literal.string);
+			ofc_parse_string_delete(literal.string);
 			break;
 		default:
 			break;
@@ -690,7 +685,7 @@ bool ofc_parse_literal_clone(
 	{
 		case OFC_PARSE_LITERAL_CHARACTER:
 		case OFC_PARSE_LITERAL_HOLLERITH:
-			clone.string = ofc_string_copy(src->string);
+			clone.string = ofc_parse_string_copy(src->string);
 			if (ofc_string_empty(clone.string))
 				return false;
 			break;
@@ -703,6 +698,88 @@ bool ofc_parse_literal_clone(
 }
 
 
+bool ofc_parse_literal_serialize(
+	ofc_serial_t* serial, const ofc_parse_literal_t* literal)
+{
+	if (!literal)
+		return false;
+
+	if (!ofc_serial_write_uint(serial, literal->type)
+		|| !ofc_serial_write_uint(serial, literal->kind)
+		|| !ofc_serial_write_str_ref(serial, literal->src))
+		return false;
+
+	switch (literal->type)
+	{
+		case OFC_PARSE_LITERAL_BINARY:
+		case OFC_PARSE_LITERAL_OCTAL:
+		case OFC_PARSE_LITERAL_HEX:
+		case OFC_PARSE_LITERAL_NUMBER:
+			return ofc_serial_write_str_ref(
+				serial, literal->number);
+		case OFC_PARSE_LITERAL_HOLLERITH:
+		case OFC_PARSE_LITERAL_CHARACTER:
+			return ofc_serial_write_string(
+				serial, literal->string);
+		case OFC_PARSE_LITERAL_COMPLEX:
+			return (ofc_serial_write_str_ref(serial, literal->complex.real)
+				&& ofc_serial_write_str_ref(serial, literal->complex.imaginary));
+		case OFC_PARSE_LITERAL_LOGICAL:
+			return ofc_serial_write_bool(
+				serial, literal->logical);
+		default:
+			break;
+	}
+
+	return false;
+}
+
+bool ofc_parse_literal_deserialize(
+	ofc_serial_t* serial, ofc_parse_literal_t* literal)
+{
+	if (!literal)
+		return false;
+
+	unsigned type;
+	ofc_parse_literal_t l;
+	if (!ofc_serial_read_unsigned(serial, &type)
+		|| !ofc_serial_read_unsigned(serial, &l.kind)
+		|| !ofc_serial_read_str_ref(serial, &l.src))
+		return false;
+	l.type = type;
+
+	bool success = false;
+	switch (l.type)
+	{
+		case OFC_PARSE_LITERAL_BINARY:
+		case OFC_PARSE_LITERAL_OCTAL:
+		case OFC_PARSE_LITERAL_HEX:
+		case OFC_PARSE_LITERAL_NUMBER:
+			success = ofc_serial_read_str_ref(
+				serial, &l.number);
+			break;
+		case OFC_PARSE_LITERAL_HOLLERITH:
+		case OFC_PARSE_LITERAL_CHARACTER:
+			success = ofc_parse_string_deserialize(
+				serial, &l.string);
+			break;
+		case OFC_PARSE_LITERAL_COMPLEX:
+			success = (ofc_serial_read_str_ref(serial, &l.complex.real)
+				&& ofc_serial_read_str_ref(serial, &l.complex.imaginary));
+			break;
+		case OFC_PARSE_LITERAL_LOGICAL:
+			success = ofc_serial_read_bool(
+				serial, &l.logical);
+			break;
+		default:
+			break;
+	}
+	if (!success) return false;
+
+	*literal = l;
+	return true;
+}
+
 unsigned ofc_parse_unsigned(
 	const ofc_sparse_t* src, const char* ptr,
 	ofc_parse_debug_t* debug,
@@ -0,0 +1,226 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ofc/parse.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+
+
+typedef struct
+{
+	ofc_parse_memo_e kind;
+	const char*      ptr;
+	void*            node;
+	unsigned         len;
+
+	/* Arena position once the node was parsed. */
+	size_t position;
+
+	/* Previous entry in the same bucket, zero terminated. */
+	unsigned next;
+} ofc_parse_memo__entry_t;
+
+struct ofc_parse_memo_s
+{
+	unsigned                 count, max;
+	ofc_parse_memo__entry_t* entry;
+
+	/* Entry index plus one of the newest entry in each bucket,
+	   there are always at least twice as many buckets as entries. */
+	unsigned  bucket_mask;
+	unsigned* bucket;
+};
+
+
+static __thread ofc_parse_memo_t* ofc_parse_memo__current = NULL;
+
+
+ofc_parse_memo_t* ofc_parse_memo_create(void)
+{
+	ofc_parse_memo_t* memo
+		= (ofc_parse_memo_t*)malloc(
+			sizeof(ofc_parse_memo_t));
+	if (!memo) return NULL;
+
+	memo->count = 0;
+	memo->max   = 0;
+	memo->entry = NULL;
+
+	memo->bucket_mask = 0;
+	memo->bucket      = NULL;
+	return memo;
+}
+
+void ofc_parse_memo_delete(ofc_parse_memo_t* memo)
+{
+	if (!memo)
+		return;
+
+	free(memo->bucket);
+	free(memo->entry);
+	free(memo);
+}
+
+
+ofc_parse_memo_t* ofc_parse_memo_swap(ofc_parse_memo_t* memo)
+{
+	ofc_parse_memo_t* prev = ofc_parse_memo__current;
+	ofc_parse_memo__current = memo;
+	return prev;
+}
+
+
+static unsigned ofc_parse_memo__hash(
+	ofc_parse_memo_e kind, const char* ptr)
+{
+	uint64_t key = (((uintptr_t)ptr * OFC_PARSE_MEMO_COUNT) + kind);
+	return (unsigned)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static void ofc_parse_memo__pop(ofc_parse_memo_t* memo)
+{
+	const ofc_parse_memo__entry_t* entry
+		= &memo->entry[--memo->count];
+
+	/* Entries are only removed newest first,
+	   so this was the head of its bucket. */
+	unsigned b = ofc_parse_memo__hash(
+		entry->kind, entry->ptr) & memo->bucket_mask;
+	memo->bucket[b] = entry->next;
+}
+
+static void ofc_parse_memo__link(
+	ofc_parse_memo_t* memo, unsigned index)
+{
+	ofc_parse_memo__entry_t* entry
+		= &memo->entry[index];
+
+	unsigned b = ofc_parse_memo__hash(
+		entry->kind, entry->ptr) & memo->bucket_mask;
+	entry->next = memo->bucket[b];
+	memo->bucket[b] = (index + 1);
+}
+
+static bool ofc_parse_memo__grow(ofc_parse_memo_t* memo)
+{
+	unsigned max = (memo->max > 0 ? (memo->max << 1) : 64);
+	if ((max <= memo->max)
+		|| (max > (UINT_MAX / sizeof(ofc_parse_memo__entry_t)))
+		|| ((max << 1) < max))
+		return false;
+
+	ofc_parse_memo__entry_t* nentry
+		= (ofc_parse_memo__entry_t*)realloc(memo->entry,
+			(sizeof(ofc_parse_memo__entry_t) * max));
+	if (!nentry) return false;
+	memo->entry = nentry;
+	memo->max   = max;
+
+	unsigned* nbucket
+		= (unsigned*)calloc((max << 1), sizeof(unsigned));
+	if (!nbucket) return false;
+	free(memo->bucket);
+	memo->bucket      = nbucket;
+	memo->bucket_mask = ((max << 1) - 1);
+
+	/* Relinking oldest first rebuilds the same chains. */
+	unsigned i;
+	for (i = 0; i < memo->count; i++)
+		ofc_parse_memo__link(memo, i);
+	return true;
+}
+
+
+unsigned ofc_parse_memo_position(void)
+{
+	ofc_parse_memo_t* memo = ofc_parse_memo__current;
+	return (memo ? memo->count : 0);
+}
+
+void ofc_parse_memo_rewind(unsigned position)
+{
+	ofc_parse_memo_t* memo = ofc_parse_memo__current;
+	if (!memo) return;
+
+	while (memo->count > position)
+		ofc_parse_memo__pop(memo);
+}
+
+void ofc_parse_memo_release(size_t position)
+{
+	ofc_parse_memo_t* memo = ofc_parse_memo__current;
+	if (!memo) return;
+
+	/* Entries are added as parses complete so their
+	   arena positions never decrease. */
+	while ((memo->count > 0)
+		&& (memo->entry[memo->count - 1].position > position))
+		ofc_parse_memo__pop(memo);
+}
+
+
+bool ofc_parse_memo_find(
+	ofc_parse_memo_e kind, const char* ptr,
+	void** node, unsigned* len)
+{
+	ofc_parse_memo_t* memo = ofc_parse_memo__current;
+	if (!memo || (memo->count == 0))
+		return false;
+
+	unsigned i = memo->bucket[ofc_parse_memo__hash(
+		kind, ptr) & memo->bucket_mask];
+	while (i > 0)
+	{
+		const ofc_parse_memo__entry_t* entry
+			= &memo->entry[i - 1];
+		if ((entry->kind == kind)
+			&& (entry->ptr == ptr))
+		{
+			if (node) *node = entry->node;
+			if (len ) *len  = entry->len;
+			return true;
+		}
+		i = entry->next;
+	}
+
+	return false;
+}
+
+void ofc_parse_memo_add(
+	ofc_parse_memo_e kind, const char* ptr,
+	void* node, unsigned len)
+{
+	ofc_parse_memo_t* memo = ofc_parse_memo__current;
+	if (!memo || !ptr)
+		return;
+
+	/* Nodes which may be freed by their owner can't be shared. */
+	if (node && !ofc_parse_arena_owned(node))
+		return;
+
+	if ((memo->count >= memo->max)
+		&& !ofc_parse_memo__grow(memo))
+		return;
+
+	ofc_parse_memo__entry_t* entry
+		= &memo->entry[memo->count];
+	entry->kind     = kind;
+	entry->ptr      = ptr;
+	entry->node     = node;
+	entry->len      = (node ? len : 0);
+	entry->position = ofc_parse_arena_position();
+	ofc_parse_memo__link(memo, memo->count++);
+}
@@ -26,7 +26,7 @@ static ofc_parse_pointer_t* ofc_parse_pointer(
 		return NULL;
 
 	ofc_parse_pointer_t* pointer
-		= (ofc_parse_pointer_t*)malloc(
+		= (ofc_parse_pointer_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_pointer_t));
 	if (!pointer) return NULL;
 
@@ -36,14 +36,14 @@ static ofc_parse_pointer_t* ofc_parse_pointer(
 		src, &ptr[i], debug, &pointer->name);
 	if (l == 0)
 	{
-		free(pointer);
+		ofc_parse_free(pointer);
 		return NULL;
 	}
 	i += l;
 
 	if (ptr[i++] != ',')
 	{
-		free(pointer);
+		ofc_parse_free(pointer);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -52,7 +52,7 @@ static ofc_parse_pointer_t* ofc_parse_pointer(
 		src, &ptr[i], debug, &pointer->target);
 	if (l == 0)
 	{
-		free(pointer);
+		ofc_parse_free(pointer);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -60,7 +60,7 @@ static ofc_parse_pointer_t* ofc_parse_pointer(
 
 	if (ptr[i++] != ')')
 	{
-		free(pointer);
+		ofc_parse_free(pointer);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -89,7 +89,7 @@ ofc_parse_pointer_list_t* ofc_parse_pointer_list(
 	unsigned* len)
 {
 	ofc_parse_pointer_list_t* list
-		= (ofc_parse_pointer_list_t*)malloc(
+		= (ofc_parse_pointer_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_pointer_list_t));
 	if (!list) return NULL;
 
@@ -99,10 +99,10 @@ ofc_parse_pointer_list_t* ofc_parse_pointer_list(
 	unsigned i = ofc_parse_list(
 		src, ptr, debug, ',',
 		&list->count, (void***)&list->pointer,
-		(void*)ofc_parse_pointer, free);
+		(void*)ofc_parse_pointer, ofc_parse_free);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -118,8 +118,8 @@ void ofc_parse_pointer_list_delete(
 
 	ofc_parse_list_delete(
 		list->count, (void**)list->pointer,
-		free);
-	free(list);
+		ofc_parse_free);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_pointer_list_print(
@@ -129,3 +129,75 @@ bool ofc_parse_pointer_list_print(
 		cs, list->count, (const void**)list->pointer,
 		(void*)ofc_parse_pointer_print);
 }
+
+static bool ofc_parse_pointer_serialize(
+	ofc_serial_t* serial, const ofc_parse_pointer_t* pointer)
+{
+	if (!pointer)
+		return false;
+
+	return (ofc_serial_write_str_ref(serial, pointer->name)
+		&& ofc_serial_write_str_ref(serial, pointer->target));
+}
+
+static bool ofc_parse_pointer_deserialize(
+	ofc_serial_t* serial, ofc_parse_pointer_t** pointer)
+{
+	if (!pointer)
+		return false;
+
+	ofc_parse_pointer_t* n
+		= (ofc_parse_pointer_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_pointer_t));
+	if (!n) return false;
+
+	if (!ofc_serial_read_str_ref(serial, &n->name)
+		|| !ofc_serial_read_str_ref(serial, &n->target))
+	{
+		ofc_parse_free(n);
+		return false;
+	}
+
+	*pointer = n;
+	return true;
+}
+
+bool ofc_parse_pointer_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_pointer_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->pointer,
+		(void*)ofc_parse_pointer_serialize));
+}
+
+bool ofc_parse_pointer_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_pointer_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_pointer_list_t* l
+		= (ofc_parse_pointer_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_pointer_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->pointer,
+		(void*)ofc_parse_pointer_deserialize,
+		(void*)ofc_parse_free))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
@@ -26,7 +26,7 @@ static ofc_parse_record_t* ofc_parse_record(
 		return 0;
 
 	ofc_parse_record_t* record
-		= (ofc_parse_record_t*)malloc(
+		= (ofc_parse_record_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_record_t));
 	if (!record) return NULL;
 
@@ -37,14 +37,14 @@ static ofc_parse_record_t* ofc_parse_record(
 		&record->structure);
 	if (l == 0)
 	{
-		free(record);
+		ofc_parse_free(record);
 		return NULL;
 	}
 	i += l;
 
 	if (ptr[i++] != '/')
 	{
-		free(record);
+		ofc_parse_free(record);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -53,7 +53,7 @@ static ofc_parse_record_t* ofc_parse_record(
 		src, &ptr[i], debug, &l);
 	if (!record->name)
 	{
-		free(record);
+		ofc_parse_free(record);
 		ofc_parse_debug_rewind(debug, dpos);
 		return NULL;
 	}
@@ -70,7 +70,7 @@ static void ofc_parse_record_delete(
 		return;
 
 	ofc_parse_lhs_delete(record->name);
-	free(record);
+	ofc_parse_free(record);
 }
 
 static bool ofc_parse_record_print(
@@ -93,7 +93,7 @@ ofc_parse_record_list_t* ofc_parse_record_list(
 	unsigned* len)
 {
 	ofc_parse_record_list_t* list
-		= (ofc_parse_record_list_t*)malloc(
+		= (ofc_parse_record_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_record_list_t));
 	if (!list) return NULL;
 
@@ -107,7 +107,7 @@ ofc_parse_record_list_t* ofc_parse_record_list(
 		(void*)ofc_parse_record_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -124,7 +124,7 @@ void ofc_parse_record_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->record,
 		(void*)ofc_parse_record_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_record_list_print(
@@ -137,3 +137,77 @@ bool ofc_parse_record_list_print(
 		list->count, (const void**)list->record,
 		(void*)ofc_parse_record_print);
 }
+
+static bool ofc_parse_record_serialize(
+	ofc_serial_t* serial, const ofc_parse_record_t* record)
+{
+	if (!record)
+		return false;
+
+	return (ofc_serial_write_str_ref(serial, record->structure)
+		&& ofc_parse_lhs_serialize(serial, record->name));
+}
+
+static bool ofc_parse_record_deserialize(
+	ofc_serial_t* serial, ofc_parse_record_t** record)
+{
+	if (!record)
+		return false;
+
+	ofc_parse_record_t* n
+		= (ofc_parse_record_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_record_t));
+	if (!n) return false;
+
+	n->name = NULL;
+
+	if (!ofc_serial_read_str_ref(serial, &n->structure)
+		|| !ofc_parse_lhs_deserialize(serial, &n->name))
+	{
+		ofc_parse_record_delete(n);
+		return false;
+	}
+
+	*record = n;
+	return true;
+}
+
+bool ofc_parse_record_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_record_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->record,
+		(void*)ofc_parse_record_serialize));
+}
+
+bool ofc_parse_record_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_record_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_record_list_t* l
+		= (ofc_parse_record_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_record_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->record,
+		(void*)ofc_parse_record_deserialize,
+		(void*)ofc_parse_record_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
@@ -22,7 +22,7 @@ ofc_parse_save_t* ofc_parse_save(
 	unsigned* len)
 {
 	ofc_parse_save_t* save
-		= (ofc_parse_save_t*)malloc(
+		= (ofc_parse_save_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_save_t));
 	if (!save) return NULL;
 
@@ -36,14 +36,14 @@ ofc_parse_save_t* ofc_parse_save(
 			&save->common);
 		if (l == 0)
 		{
-			free(save);
+			ofc_parse_free(save);
 			return NULL;
 		}
 		i += l;
 
 		if (ptr[i++] != '/')
 		{
-			free(save);
+			ofc_parse_free(save);
 			return NULL;
 		}
 
@@ -55,7 +55,7 @@ ofc_parse_save_t* ofc_parse_save(
 			src, ptr, debug, &i);
 		if (!save->lhs)
 		{
-			free(save);
+			ofc_parse_free(save);
 			return NULL;
 		}
 		save->is_common = false;
@@ -73,7 +73,7 @@ void ofc_parse_save_delete(
 
 	if (!save->is_common)
 		ofc_parse_lhs_delete(save->lhs);
-	free(save);
+	ofc_parse_free(save);
 }
 
 bool ofc_parse_save_print(
@@ -98,7 +98,7 @@ ofc_parse_save_list_t* ofc_parse_save_list(
 	unsigned* len)
 {
 	ofc_parse_save_list_t* list
-		= (ofc_parse_save_list_t*)malloc(
+		= (ofc_parse_save_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_save_list_t));
 	if (!list) return NULL;
 
@@ -112,7 +112,7 @@ ofc_parse_save_list_t* ofc_parse_save_list(
 		(void*)ofc_parse_save_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -129,7 +129,7 @@ void ofc_parse_save_list_delete(
 	ofc_parse_list_delete(
 		list->count, (void**)list->save,
 		(void*)ofc_parse_save_delete);
-	free(list);
+	ofc_parse_free(list);
 }
 
 bool ofc_parse_save_list_print(
@@ -142,3 +142,81 @@ bool ofc_parse_save_list_print(
 		list->count, (const void**)list->save,
 		(void*)ofc_parse_save_print);
 }
+
+bool ofc_parse_save_serialize(
+	ofc_serial_t* serial, const ofc_parse_save_t* save)
+{
+	if (!save || !ofc_serial_write_bool(serial, save->is_common))
+		return false;
+
+	return (save->is_common
+		? ofc_serial_write_str_ref(serial, save->common)
+		: ofc_parse_lhs_serialize(serial, save->lhs));
+}
+
+bool ofc_parse_save_deserialize(
+	ofc_serial_t* serial, ofc_parse_save_t** save)
+{
+	if (!save)
+		return false;
+
+	ofc_parse_save_t* n
+		= (ofc_parse_save_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_save_t));
+	if (!n) return false;
+
+	n->is_common = false;
+	n->lhs       = NULL;
+
+	if (!ofc_serial_read_bool(serial, &n->is_common)
+		|| !(n->is_common
+			? ofc_serial_read_str_ref(serial, &n->common)
+			: ofc_parse_lhs_deserialize(serial, &n->lhs)))
+	{
+		ofc_parse_save_delete(n);
+		return false;
+	}
+
+	*save = n;
+	return true;
+}
+
+bool ofc_parse_save_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_save_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->save,
+		(void*)ofc_parse_save_serialize));
+}
+
+bool ofc_parse_save_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_save_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_save_list_t* l
+		= (ofc_parse_save_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_save_list_t));
+	if (!l) return false;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->save,
+		(void*)ofc_parse_save_deserialize,
+		(void*)ofc_parse_save_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
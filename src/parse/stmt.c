@@ -14,6 +14,7 @@
  */
 
 #include <ofc/parse.h>
+#include <ctype.h>
 
 unsigned ofc_parse_stmt_include(
 	const ofc_sparse_t* src, const char* ptr,
@@ -232,54 +233,54 @@ unsigned ofc_parse_stmt_io_define_file(
 
 
 static void ofc_parse_stmt__cleanup(
-	ofc_parse_stmt_t stmt)
+	const ofc_parse_stmt_t* stmt)
 {
-	switch (stmt.type)
+	switch (stmt->type)
 	{
 		case OFC_PARSE_STMT_INCLUDE:
-			ofc_parse_stmt_list_delete(stmt.include.include);
-			ofc_sparse_delete(stmt.include.src);
-			ofc_file_delete(stmt.include.file);
+			ofc_parse_stmt_list_delete(stmt->include.include);
+			ofc_sparse_delete(stmt->include.src);
+			ofc_file_delete(stmt->include.file);
 			break;
 		case OFC_PARSE_STMT_PROGRAM:
 		case OFC_PARSE_STMT_SUBROUTINE:
 		case OFC_PARSE_STMT_FUNCTION:
 		case OFC_PARSE_STMT_BLOCK_DATA:
-			ofc_parse_stmt_list_delete(stmt.program.body);
-			ofc_parse_call_arg_list_delete(stmt.program.args);
-			ofc_parse_type_delete(stmt.program.type);
+			ofc_parse_stmt_list_delete(stmt->program.body);
+			ofc_parse_call_arg_list_delete(stmt->program.args);
+			ofc_parse_type_delete(stmt->program.type);
 			break;
 		case OFC_PARSE_STMT_ASSIGNMENT:
-			ofc_parse_assign_delete(stmt.assignment);
+			ofc_parse_assign_delete(stmt->assignment);
 			break;
 		case OFC_PARSE_STMT_IMPLICIT:
-			ofc_parse_implicit_list_delete(stmt.implicit);
+			ofc_parse_implicit_list_delete(stmt->implicit);
 			break;
 		case OFC_PARSE_STMT_CALL:
 		case OFC_PARSE_STMT_ENTRY:
-			ofc_parse_call_arg_list_delete(stmt.call_entry.args);
+			ofc_parse_call_arg_list_delete(stmt->call_entry.args);
 			break;
 		case OFC_PARSE_STMT_DECL:
-			ofc_parse_type_delete(stmt.decl.type);
-			ofc_parse_decl_list_delete(stmt.decl.decl);
+			ofc_parse_type_delete(stmt->decl.type);
+			ofc_parse_decl_list_delete(stmt->decl.decl);
 			break;
 		case OFC_PARSE_STMT_COMMON:
 		case OFC_PARSE_STMT_NAMELIST:
-			ofc_parse_common_group_list_delete(stmt.common_namelist);
+			ofc_parse_common_group_list_delete(stmt->common_namelist);
 			break;
 		case OFC_PARSE_STMT_DIMENSION:
-			ofc_parse_lhs_list_delete(stmt.dimension);
+			ofc_parse_lhs_list_delete(stmt->dimension);
 			break;
 		case OFC_PARSE_STMT_EQUIVALENCE:
 			ofc_parse_list_delete(
-				stmt.equivalence.count,
-				(void**)stmt.equivalence.group,
+				stmt->equivalence.count,
+				(void**)stmt->equivalence.group,
 				(void*)ofc_parse_lhs_list_delete);
 			break;
 		case OFC_PARSE_STMT_STOP:
 		case OFC_PARSE_STMT_PAUSE:
 		case OFC_PARSE_STMT_RETURN:
-			ofc_parse_expr_delete(stmt.stop_pause_return.value);
+			ofc_parse_expr_delete(stmt->stop_pause_return.value);
 			break;
 		case OFC_PARSE_STMT_DECL_ATTR_EXTERNAL:
 		case OFC_PARSE_STMT_DECL_ATTR_INTRINSIC:
@@ -287,63 +288,63 @@ static void ofc_parse_stmt__cleanup(
 		case OFC_PARSE_STMT_DECL_ATTR_STATIC:
 		case OFC_PARSE_STMT_DECL_ATTR_VOLATILE:
 			ofc_parse_list_delete(
-				stmt.decl_attr.count,
-				(void**)stmt.decl_attr.name,
-				free);
+				stmt->decl_attr.count,
+				(void**)stmt->decl_attr.name,
+				ofc_parse_free);
 			break;
 		case OFC_PARSE_STMT_POINTER:
 			ofc_parse_pointer_list_delete(
-				stmt.pointer);
+				stmt->pointer);
 			break;
 		case OFC_PARSE_STMT_GO_TO:
-			ofc_parse_expr_delete(stmt.go_to.label);
+			ofc_parse_expr_delete(stmt->go_to.label);
 			break;
 		case OFC_PARSE_STMT_GO_TO_ASSIGNED:
 		case OFC_PARSE_STMT_GO_TO_COMPUTED:
-			ofc_parse_expr_delete(stmt.go_to_list.cond);
-			ofc_parse_expr_list_delete(stmt.go_to_list.label);
+			ofc_parse_expr_delete(stmt->go_to_list.cond);
+			ofc_parse_expr_list_delete(stmt->go_to_list.label);
 			break;
 		case OFC_PARSE_STMT_IF_COMPUTED:
-			ofc_parse_expr_delete(stmt.if_comp.cond);
-			ofc_parse_expr_list_delete(stmt.if_comp.label);
+			ofc_parse_expr_delete(stmt->if_comp.cond);
+			ofc_parse_expr_list_delete(stmt->if_comp.label);
 			break;
 		case OFC_PARSE_STMT_IF_STATEMENT:
-			ofc_parse_expr_delete(stmt.if_stmt.cond);
-			ofc_parse_stmt_delete(stmt.if_stmt.stmt);
+			ofc_parse_expr_delete(stmt->if_stmt.cond);
+			ofc_parse_stmt_delete(stmt->if_stmt.stmt);
 			break;
 		case OFC_PARSE_STMT_IF_THEN:
-			ofc_parse_expr_delete(stmt.if_then.cond);
-			ofc_parse_stmt_list_delete(stmt.if_then.block_then);
-			ofc_parse_stmt_list_delete(stmt.if_then.block_else);
+			ofc_parse_expr_delete(stmt->if_then.cond);
+			ofc_parse_stmt_list_delete(stmt->if_then.block_then);
+			ofc_parse_stmt_list_delete(stmt->if_then.block_else);
 			break;
 		case OFC_PARSE_STMT_DO_LABEL:
-			ofc_parse_expr_delete(stmt.do_label.end_label);
-			ofc_parse_assign_delete(stmt.do_label.init);
-			ofc_parse_expr_delete(stmt.do_label.last);
-			ofc_parse_expr_delete(stmt.do_label.step);
+			ofc_parse_expr_delete(stmt->do_label.end_label);
+			ofc_parse_assign_delete(stmt->do_label.init);
+			ofc_parse_expr_delete(stmt->do_label.last);
+			ofc_parse_expr_delete(stmt->do_label.step);
 			break;
 		case OFC_PARSE_STMT_DO_BLOCK:
-			ofc_parse_assign_delete(stmt.do_block.init);
-			ofc_parse_expr_delete(stmt.do_block.last);
-			ofc_parse_expr_delete(stmt.do_block.step);
-			ofc_parse_stmt_list_delete(stmt.do_block.block);
+			ofc_parse_assign_delete(stmt->do_block.init);
+			ofc_parse_expr_delete(stmt->do_block.last);
+			ofc_parse_expr_delete(stmt->do_block.step);
+			ofc_parse_stmt_list_delete(stmt->do_block.block);
 			break;
 		case OFC_PARSE_STMT_DO_WHILE:
-			ofc_parse_expr_delete(stmt.do_label.end_label);
-			ofc_parse_expr_delete(stmt.do_while.cond);
+			ofc_parse_expr_delete(stmt->do_label.end_label);
+			ofc_parse_expr_delete(stmt->do_while.cond);
 			break;
 		case OFC_PARSE_STMT_DO_WHILE_BLOCK:
-			ofc_parse_expr_delete(stmt.do_while_block.cond);
-			ofc_parse_stmt_list_delete(stmt.do_while_block.block);
+			ofc_parse_expr_delete(stmt->do_while_block.cond);
+			ofc_parse_stmt_list_delete(stmt->do_while_block.block);
 			break;
 		case OFC_PARSE_STMT_TYPE:
 		case OFC_PARSE_STMT_STRUCTURE:
 		case OFC_PARSE_STMT_UNION:
 		case OFC_PARSE_STMT_MAP:
-			ofc_parse_stmt_list_delete(stmt.structure.block);
+			ofc_parse_stmt_list_delete(stmt->structure.block);
 			break;
 		case OFC_PARSE_STMT_RECORD:
-			ofc_parse_record_list_delete(stmt.record);
+			ofc_parse_record_list_delete(stmt->record);
 			break;
 		case OFC_PARSE_STMT_IO_REWIND:
 		case OFC_PARSE_STMT_IO_BACKSPACE:
@@ -355,202 +356,396 @@ static void ofc_parse_stmt__cleanup(
 		case OFC_PARSE_STMT_IO_INQUIRE:
 		case OFC_PARSE_STMT_IO_ENCODE:
 		case OFC_PARSE_STMT_IO_DECODE:
-			ofc_parse_call_arg_list_delete(stmt.io.params);
-			ofc_parse_expr_list_delete(stmt.io.iolist);
+			ofc_parse_call_arg_list_delete(stmt->io.params);
+			ofc_parse_expr_list_delete(stmt->io.iolist);
 			break;
 		case OFC_PARSE_STMT_IO_PRINT:
 		case OFC_PARSE_STMT_IO_TYPE:
 		case OFC_PARSE_STMT_IO_ACCEPT:
-			ofc_parse_expr_delete(stmt.io_print.format);
-			ofc_parse_expr_list_delete(stmt.io_print.iolist);
+			ofc_parse_expr_delete(stmt->io_print.format);
+			ofc_parse_expr_list_delete(stmt->io_print.iolist);
 			break;
 		case OFC_PARSE_STMT_IO_DEFINE_FILE:
-			ofc_parse_define_file_arg_list_delete(stmt.io_define_file.args);
+			ofc_parse_define_file_arg_list_delete(stmt->io_define_file.args);
 			break;
 		case OFC_PARSE_STMT_FORMAT:
-			ofc_parse_format_desc_list_delete(stmt.format);
+			ofc_parse_format_desc_list_delete(stmt->format);
 			break;
 		case OFC_PARSE_STMT_DATA:
-			ofc_parse_data_list_delete(stmt.data);
+			ofc_parse_data_list_delete(stmt->data);
 			break;
 		case OFC_PARSE_STMT_SAVE:
-			ofc_parse_save_list_delete(stmt.save.list);
+			ofc_parse_save_list_delete(stmt->save.list);
 			break;
 		case OFC_PARSE_STMT_PARAMETER:
-			ofc_parse_assign_list_delete(stmt.parameter.list);
+			ofc_parse_assign_list_delete(stmt->parameter.list);
+			break;
+		default:
 			break;
+	}
+}
+
+#define OFC_PARSE_STMT__SIZE(member) \
+	(offsetof(ofc_parse_stmt_t, member) \
+		+ sizeof(((ofc_parse_stmt_t*)NULL)->member))
+
+/* The most common statements only use a pointer or two of the union,
+   so they get a node of their own size, anything else gets the lot. */
+static size_t ofc_parse_stmt__size(
+	ofc_parse_stmt_e type)
+{
+	switch (type)
+	{
+		case OFC_PARSE_STMT_CONTINUE:
+			return offsetof(ofc_parse_stmt_t, assignment);
+		case OFC_PARSE_STMT_ASSIGNMENT:
+			return OFC_PARSE_STMT__SIZE(assignment);
+		case OFC_PARSE_STMT_STOP:
+		case OFC_PARSE_STMT_PAUSE:
+		case OFC_PARSE_STMT_RETURN:
+			return OFC_PARSE_STMT__SIZE(stop_pause_return);
+		case OFC_PARSE_STMT_GO_TO:
+			return OFC_PARSE_STMT__SIZE(go_to);
+		case OFC_PARSE_STMT_IF_STATEMENT:
+			return OFC_PARSE_STMT__SIZE(if_stmt);
+		case OFC_PARSE_STMT_DECL:
+			return OFC_PARSE_STMT__SIZE(decl);
 		default:
 			break;
 	}
+
+	return sizeof(ofc_parse_stmt_t);
 }
 
 static ofc_parse_stmt_t* ofc_parse_stmt__alloc(
-	ofc_parse_stmt_t stmt)
+	const ofc_parse_stmt_t* stmt)
 {
+	size_t size = ofc_parse_stmt__size(stmt->type);
 	ofc_parse_stmt_t* astmt
-		= (ofc_parse_stmt_t*)malloc(
-			sizeof(ofc_parse_stmt_t));
+		= (ofc_parse_stmt_t*)ofc_parse_alloc(size);
 	if (!astmt) return NULL;
 
-	*astmt = stmt;
+	/* An include holds references outside of the arena,
+	   so they must be released along with it. */
+	if ((stmt->type == OFC_PARSE_STMT_INCLUDE)
+		&& ofc_parse_arena_owned(astmt)
+		&& !ofc_parse_arena_cleanup(
+			(void*)ofc_parse_stmt__cleanup, astmt))
+		return NULL;
+
+	memcpy(astmt, stmt, size);
 	return astmt;
 }
 
 
 
-ofc_parse_stmt_t* ofc_parse_stmt(
-	const ofc_sparse_t* src, const char* ptr,
-	ofc_parse_debug_t* debug,
-	unsigned* len)
+typedef enum
 {
-	if (ptr[0] == '\0')
-		return NULL;
-
-	ofc_parse_stmt_t stmt;
-	stmt.type  = OFC_PARSE_STMT_EMPTY;
+	OFC_PARSE_STMT__CLASS_AMBIGUOUS = 0,
+	OFC_PARSE_STMT__CLASS_ASSIGNMENT,
+	OFC_PARSE_STMT__CLASS_KEYWORD,
+} ofc_parse_stmt__class_e;
+
+/* Whether a keyword could be run together with the name of an assigned
+   variable, DO is excluded since it always has a top-level comma. */
+static bool ofc_parse_stmt__keyword_prefix(const char* ptr)
+{
+	ofc_parse_keyword_e keyword[4];
+	unsigned count = ofc_parse_keyword_match(ptr, keyword, 4);
+	if (count > 4) return true;
 
-	/* TODO - Allow handling of label 0? */
-	stmt.label = 0;
-	ofc_sparse_label_find(src, ptr, &stmt.label);
+	unsigned k;
+	for (k = 0; k < count; k++)
+	{
+		switch (keyword[k])
+		{
+			case OFC_PARSE_KEYWORD_THEN:
+			case OFC_PARSE_KEYWORD_ELSE:
+			case OFC_PARSE_KEYWORD_DO:
+			case OFC_PARSE_KEYWORD_WHILE:
+			case OFC_PARSE_KEYWORD_TRUE:
+			case OFC_PARSE_KEYWORD_FALSE:
+			case OFC_PARSE_KEYWORD_KIND:
+			case OFC_PARSE_KEYWORD_TO:
+				break;
+			default:
+				return true;
+		}
+	}
+	return false;
+}
 
-	unsigned dpos = ofc_parse_debug_position(debug);
+/* A cheap scan of the statement for a top-level '=' and commas,
+   so we can skip the parsers which can't possibly match.
+   Anything we're not sure about is left ambiguous. */
+static ofc_parse_stmt__class_e ofc_parse_stmt__classify(
+	const char* ptr)
+{
+	unsigned name = 0;
+	if (isalpha(ptr[0]) || (ptr[0] == '_'))
+	{
+		for (name = 1; ofc_is_ident(ptr[name]); name++);
+	}
 
-	unsigned i = 0;
+	/* Whether what comes before the '=' is just a name
+	   followed by subscripts or substrings. */
+	bool simple = (name > 0);
 
-	if (i == 0) i = ofc_parse_stmt_function(src, ptr, debug, &stmt);
-	if (i == 0) i = ofc_parse_stmt_decl(src, ptr, debug, &stmt);
+	unsigned depth  = 0;
+	bool     equals = false;
+	bool     comma  = false;
 
-	/* Drop incomplete statements. */
-	if ((i > 0) && (stmt.type != OFC_PARSE_STMT_ERROR)
-		&& !ofc_is_end_statement(&ptr[i], NULL))
+	unsigned i;
+	for (i = 0; !ofc_is_end_statement(&ptr[i], NULL); i++)
 	{
-		ofc_parse_stmt__cleanup(stmt);
-		i = 0;
-		ofc_parse_debug_rewind(debug, dpos);
+		char c = ptr[i];
+
+		if ((c == '\'') || (c == '\"'))
+		{
+			if ((depth == 0) && !equals)
+				simple = false;
+
+			for (i++; ptr[i] != c; i++)
+			{
+				if (ofc_is_end_statement(&ptr[i], NULL))
+					return OFC_PARSE_STMT__CLASS_AMBIGUOUS;
+			}
+
+			/* An escaped quote is just two strings in a row here. */
+			continue;
+		}
+
+		/* Holleriths can contain anything, so give up on them. */
+		if (isdigit(c) && ((i == 0) || !ofc_is_ident(ptr[i - 1])))
+		{
+			unsigned j;
+			for (j = i; isdigit(ptr[j]); j++);
+			if (toupper(ptr[j]) == 'H')
+				return OFC_PARSE_STMT__CLASS_AMBIGUOUS;
+		}
+
+		if (c == '(')
+		{
+			depth++;
+		}
+		else if (c == ')')
+		{
+			if (depth == 0)
+				return OFC_PARSE_STMT__CLASS_AMBIGUOUS;
+			depth--;
+		}
+		else if (depth == 0)
+		{
+			if (c == ',')
+			{
+				comma = true;
+			}
+			else if ((c == '=') && !equals)
+			{
+				equals = true;
+				if ((ptr[i + 1] == '=')
+					|| (ptr[i + 1] == '>'))
+					simple = false;
+			}
+			else if (!equals && (i >= name))
+			{
+				simple = false;
+			}
+		}
 	}
 
+	if (depth != 0)
+		return OFC_PARSE_STMT__CLASS_AMBIGUOUS;
+
+	/* An assignment always has a top-level '='. */
+	if (!equals)
+		return OFC_PARSE_STMT__CLASS_KEYWORD;
+
+	if (simple && !comma
+		&& !ofc_parse_stmt__keyword_prefix(ptr))
+		return OFC_PARSE_STMT__CLASS_ASSIGNMENT;
+
+	return OFC_PARSE_STMT__CLASS_AMBIGUOUS;
+}
+
+static unsigned ofc_parse_stmt__keyword(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	ofc_parse_stmt_t* stmt)
+{
+	unsigned i = 0;
 	switch (toupper(ptr[0]))
 	{
 		case 'A':
-			if (i == 0) i = ofc_parse_stmt_assign(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_decl_attr_automatic(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_accept(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_assign(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_decl_attr_automatic(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_accept(src, ptr, debug, stmt);
 			break;
 
 		case 'B':
-			if (i == 0) i = ofc_parse_stmt_io_backspace(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_block_data(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_io_backspace(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_block_data(src, ptr, debug, stmt);
 			break;
 
 		case 'C':
-			if (i == 0) i = ofc_parse_stmt_continue(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_cycle(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_call(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_common(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_close(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_continue(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_cycle(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_call(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_common(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_close(src, ptr, debug, stmt);
 			break;
 
 		case 'D':
-			if (i == 0) i = ofc_parse_stmt_do(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_data(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_dimension(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_decode(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_define_file(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_do(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_data(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_dimension(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_decode(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_define_file(src, ptr, debug, stmt);
 			break;
 
 		case 'E':
-			if (i == 0) i = ofc_parse_stmt_equivalence(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_exit(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_end_file(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_decl_attr_external(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_entry(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_encode(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_equivalence(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_exit(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_end_file(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_decl_attr_external(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_entry(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_encode(src, ptr, debug, stmt);
 			break;
 
 		case 'F':
-			if (i == 0) i = ofc_parse_stmt_format(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_format(src, ptr, debug, stmt);
 			break;
 
 		case 'G':
-			if (i == 0) i = ofc_parse_stmt_go_to(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_go_to(src, ptr, debug, stmt);
 			break;
 
 		case 'I':
-			if (i == 0) i = ofc_parse_stmt_implicit(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_if(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_decl_attr_intrinsic(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_inquire(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_include(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_implicit(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_if(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_decl_attr_intrinsic(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_inquire(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_include(src, ptr, debug, stmt);
 			break;
 
 		case 'M':
-			if (i == 0) i = ofc_parse_stmt_map(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_map(src, ptr, debug, stmt);
 			break;
 
 		case 'N':
-			if (i == 0) i = ofc_parse_stmt_namelist(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_namelist(src, ptr, debug, stmt);
 			break;
 
 		case 'O':
-			if (i == 0) i = ofc_parse_stmt_io_open(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_io_open(src, ptr, debug, stmt);
 			break;
 
 		case 'P':
-			if (i == 0) i = ofc_parse_stmt_parameter(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_program(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_pause(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_print_type(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_pointer(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_parameter(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_program(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_pause(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_print_type(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_pointer(src, ptr, debug, stmt);
 			break;
 
 		case 'R':
-			if (i == 0) i = ofc_parse_stmt_return(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_read(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_rewind(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_record(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_return(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_read(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_rewind(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_record(src, ptr, debug, stmt);
 			break;
 
 		case 'S':
-			if (i == 0) i = ofc_parse_stmt_subroutine(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_stop(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_save(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_decl_attr_static(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_structure(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_subroutine(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_stop(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_save(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_decl_attr_static(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_structure(src, ptr, debug, stmt);
 			break;
 
 		case 'T':
-			if (i == 0) i = ofc_parse_stmt_type(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_io_print_type(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_type(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_io_print_type(src, ptr, debug, stmt);
 			break;
 
 		case 'U':
-			if (i == 0) i = ofc_parse_stmt_union(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_union(src, ptr, debug, stmt);
 			break;
 
 		case 'V':
-			if (i == 0) i = ofc_parse_stmt_virtual(src, ptr, debug, &stmt);
-			if (i == 0) i = ofc_parse_stmt_decl_attr_volatile(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_virtual(src, ptr, debug, stmt);
+			if (i == 0) i = ofc_parse_stmt_decl_attr_volatile(src, ptr, debug, stmt);
 			break;
 
 		case 'W':
-			if (i == 0) i = ofc_parse_stmt_io_write(src, ptr, debug, &stmt);
+			if (i == 0) i = ofc_parse_stmt_io_write(src, ptr, debug, stmt);
 			break;
 
 		default:
 			break;
 	}
 
+	return i;
+}
+
+static ofc_parse_stmt_t* ofc_parse__stmt(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	unsigned* len)
+{
+	if (ptr[0] == '\0')
+		return NULL;
+
+	ofc_parse_stmt_t stmt;
+	stmt.type  = OFC_PARSE_STMT_EMPTY;
+
+	/* TODO - Allow handling of label 0? */
+	stmt.label = 0;
+	ofc_sparse_label_find(src, ptr, &stmt.label);
+
+	unsigned dpos = ofc_parse_debug_position(debug);
+	size_t   apos = ofc_parse_arena_position();
+
+	ofc_parse_stmt__class_e class
+		= ofc_parse_stmt__classify(ptr);
+
+	unsigned i = 0;
+
+	if (class != OFC_PARSE_STMT__CLASS_ASSIGNMENT)
+	{
+		if (i == 0) i = ofc_parse_stmt_function(src, ptr, debug, &stmt);
+		if (i == 0) i = ofc_parse_stmt_decl(src, ptr, debug, &stmt);
+
+		/* Drop incomplete statements. */
+		if ((i > 0) && (stmt.type != OFC_PARSE_STMT_ERROR)
+			&& !ofc_is_end_statement(&ptr[i], NULL))
+		{
+			ofc_parse_stmt__cleanup(&stmt);
+			i = 0;
+			ofc_parse_debug_rewind(debug, dpos);
+		}
+
+		/* Nothing from a failed attempt is referenced, so release it. */
+		if (i == 0)
+		{
+			ofc_parse_arena_rewind(apos);
+			i = ofc_parse_stmt__keyword(src, ptr, debug, &stmt);
+		}
+	}
+
 	/* Drop incomplete statements, they may be an assignment. */
 	if ((i > 0) && (stmt.type != OFC_PARSE_STMT_ERROR)
 		&& !ofc_is_end_statement(&ptr[i], NULL))
 	{
-		ofc_parse_stmt__cleanup(stmt);
+		ofc_parse_stmt__cleanup(&stmt);
 		i = 0;
 		ofc_parse_debug_rewind(debug, dpos);
 	}
 
-	if (i == 0)
+	if ((i == 0) && (class != OFC_PARSE_STMT__CLASS_KEYWORD))
 	{
+		ofc_parse_arena_rewind(apos);
+
 		stmt.assignment = ofc_parse_assign(src, ptr, debug, &i);
 		if (stmt.assignment)
 		{
@@ -573,13 +768,15 @@ ofc_parse_stmt_t* ofc_parse_stmt(
 		if (i == 0)
 		{
 			ofc_parse_debug_rewind(debug, dpos);
+			ofc_parse_arena_rewind(apos);
 			return NULL;
 		}
 
 		ofc_parse_debug_warning(debug,
 			ofc_sparse_ref(src, &ptr[i], 0),
 			"Expected newline or semicolon after statement");
-		ofc_parse_stmt__cleanup(stmt);
+		ofc_parse_stmt__cleanup(&stmt);
+		ofc_parse_arena_rewind(apos);
 		return NULL;
 	}
 	i += l;
@@ -587,10 +784,11 @@ ofc_parse_stmt_t* ofc_parse_stmt(
 	stmt.src = ofc_sparse_ref(src, ptr, i);
 
 	ofc_parse_stmt_t* astmt
-		= ofc_parse_stmt__alloc(stmt);
+		= ofc_parse_stmt__alloc(&stmt);
 	if (!astmt)
 	{
-		ofc_parse_stmt__cleanup(stmt);
+		ofc_parse_stmt__cleanup(&stmt);
+		ofc_parse_arena_rewind(apos);
 		return NULL;
 	}
 
@@ -598,14 +796,29 @@ ofc_parse_stmt_t* ofc_parse_stmt(
 	return astmt;
 }
 
+ofc_parse_stmt_t* ofc_parse_stmt(
+	const ofc_sparse_t* src, const char* ptr,
+	ofc_parse_debug_t* debug,
+	unsigned* len)
+{
+	unsigned mpos = ofc_parse_memo_position();
+	ofc_parse_stmt_t* stmt = ofc_parse__stmt(
+		src, ptr, debug, len);
+
+	/* Once a statement is parsed nothing will be
+	   tried at the positions it covers again. */
+	ofc_parse_memo_rewind(mpos);
+	return stmt;
+}
+
 void ofc_parse_stmt_delete(
 	ofc_parse_stmt_t* stmt)
 {
-	if (!stmt)
+	if (!stmt || ofc_parse_arena_owned(stmt))
 		return;
 
-	ofc_parse_stmt__cleanup(*stmt);
-	free(stmt);
+	ofc_parse_stmt__cleanup(stmt);
+	ofc_parse_free(stmt);
 }
 
 
@@ -837,12 +1050,14 @@ ofc_parse_stmt_list_t* ofc_parse_stmt_list(
 	unsigned* len)
 {
 	ofc_parse_stmt_list_t* list
-		= (ofc_parse_stmt_list_t*)malloc(
+		= (ofc_parse_stmt_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_stmt_list_t));
 	if (!list) return NULL;
 
 	list->count = 0;
-	list->stmt = NULL;
+	list->stmt  = NULL;
+	list->arena = NULL;
+	list->ref   = 0;
 
 	unsigned i = ofc_parse_list(
 		src, ptr, debug, '\0',
@@ -851,7 +1066,7 @@ ofc_parse_stmt_list_t* ofc_parse_stmt_list(
 		(void*)ofc_parse_stmt_delete);
 	if (i == 0)
 	{
-		free(list);
+		ofc_parse_free(list);
 		return NULL;
 	}
 
@@ -873,7 +1088,7 @@ ofc_parse_stmt_list_t* ofc_parse_stmt_list(
 			list->count = (j + 1);
 
 			ofc_parse_stmt_t** nstmt
-				= (ofc_parse_stmt_t**)realloc(list->stmt,
+				= (ofc_parse_stmt_t**)ofc_parse_realloc(list->stmt,
 					(sizeof(ofc_parse_stmt_t*) * list->count));
 			if (nstmt) list->stmt = nstmt;
 		}
@@ -885,16 +1100,44 @@ ofc_parse_stmt_list_t* ofc_parse_stmt_list(
 
 
 
+bool ofc_parse_stmt_list_reference(
+	ofc_parse_stmt_list_t* list)
+{
+	if (!list || !list->arena)
+		return false;
+
+	/* References may be taken and released from any thread. */
+	if (__atomic_add_fetch(&list->ref, 1, __ATOMIC_RELAXED) == 0)
+	{
+		__atomic_sub_fetch(&list->ref, 1, __ATOMIC_RELAXED);
+		return false;
+	}
+	return true;
+}
+
 void ofc_parse_stmt_list_delete(
 	ofc_parse_stmt_list_t* list)
 {
 	if (!list)
 		return;
 
-	ofc_parse_list_delete(
-		list->count, (void**)list->stmt,
-		(void*)ofc_parse_stmt_delete);
-	free(list);
+	/* Only the last release sees the count already at zero. */
+	if (list->arena && (__atomic_fetch_sub(
+		&list->ref, 1, __ATOMIC_ACQ_REL) > 0))
+		return;
+
+	ofc_arena_t* arena = list->arena;
+
+	if (!ofc_parse_arena_owned(list))
+	{
+		ofc_parse_list_delete(
+			list->count, (void**)list->stmt,
+			(void*)ofc_parse_stmt_delete);
+		ofc_parse_free(list);
+	}
+
+	/* The root list releases the whole tree at once. */
+	ofc_arena_delete(arena);
 }
 
 
@@ -935,3 +1178,576 @@ bool ofc_parse_stmt_list_contains_error(
 
 	return false;
 }
+
+
+
+static bool ofc_parse_stmt__decl_attr_name_serialize(
+	ofc_serial_t* serial, const ofc_str_ref_t* name)
+{
+	return (name && ofc_serial_write_str_ref(serial, *name));
+}
+
+static bool ofc_parse_stmt__decl_attr_name_deserialize(
+	ofc_serial_t* serial, ofc_str_ref_t** name)
+{
+	if (!name)
+		return false;
+
+	ofc_str_ref_t* n
+		= (ofc_str_ref_t*)ofc_parse_alloc(
+			sizeof(ofc_str_ref_t));
+	if (!n) return false;
+
+	if (!ofc_serial_read_str_ref(serial, n))
+	{
+		ofc_parse_free(n);
+		return false;
+	}
+
+	*name = n;
+	return true;
+}
+
+/* An included list is a root list, with its own arena. */
+static bool ofc_parse_stmt__root_serialize(
+	ofc_serial_t* serial, const ofc_sparse_t* src,
+	const ofc_parse_stmt_list_t* list)
+{
+	const ofc_sparse_t* prev
+		= ofc_serial_sparse_swap(serial, src);
+	bool success = ofc_parse_stmt_list_serialize(serial, list);
+	ofc_serial_sparse_swap(serial, prev);
+	return success;
+}
+
+static ofc_parse_stmt_list_t* ofc_parse_stmt__root_deserialize(
+	ofc_serial_t* serial, const ofc_sparse_t* src)
+{
+	ofc_arena_t* arena = ofc_arena_create();
+	if (!arena) return NULL;
+
+	ofc_arena_t* outer = ofc_parse_arena_swap(arena);
+	const ofc_sparse_t* prev
+		= ofc_serial_sparse_swap(serial, src);
+
+	ofc_parse_stmt_list_t* list = NULL;
+	bool success = ofc_parse_stmt_list_deserialize(serial, &list);
+
+	ofc_serial_sparse_swap(serial, prev);
+	ofc_parse_arena_swap(outer);
+
+	if (!success || !list)
+	{
+		ofc_parse_stmt_list_delete(list);
+		ofc_arena_delete(arena);
+		return NULL;
+	}
+
+	list->arena = arena;
+	return list;
+}
+
+/* Each included file is written once along with its source, later
+   includes of it refer back to it through the object table. */
+static bool ofc_parse_stmt__include_serialize(
+	ofc_serial_t* serial, const ofc_parse_stmt_t* stmt)
+{
+	ofc_file_t* file = stmt->include.file;
+	if (!file)
+		return false;
+
+	unsigned index;
+	if (ofc_serial_object_find(serial, file, &index))
+		return ofc_serial_write_uint(serial, (index + 1));
+
+	const char* path    = ofc_file_get_path(file);
+	const char* include = ofc_file_get_include(file);
+	const char* strz    = ofc_file_get_strz(file);
+	if (!path || !strz)
+		return false;
+
+	ofc_string_t spath = { .base = (char*)path, .size = strlen(path) };
+	ofc_string_t sinclude = { .base = (char*)include,
+		.size = (include ? strlen(include) : 0) };
+	ofc_string_t source = { .base = (char*)strz,
+		.size = ofc_file_get_size(file) };
+
+	return (ofc_serial_write_uint(serial, 0)
+		&& ofc_serial_write_string(serial, &spath)
+		&& ofc_serial_write_string(serial, (include ? &sinclude : NULL))
+		&& ofc_serial_write_lang_opts(serial, ofc_file_get_lang_opts(file))
+		&& ofc_serial_write_string(serial, &source)
+		&& ofc_sparse_serialize(serial, stmt->include.src)
+		&& ofc_parse_stmt__root_serialize(serial,
+			stmt->include.src, stmt->include.include)
+		&& ofc_serial_object_add(serial, file)
+		&& ofc_serial_object_add(serial, stmt->include.src)
+		&& ofc_serial_object_add(serial, stmt->include.include));
+}
+
+/* Included files are read again and must match what was written,
+   so that a changed include is never replaced by a stale tree. */
+static ofc_file_t* ofc_parse_stmt__include_file_deserialize(
+	ofc_serial_t* serial)
+{
+	const char* path;
+	const char* include;
+	const char* source;
+	unsigned    path_size, include_size, source_size;
+	ofc_lang_opts_t opts;
+	if (!ofc_serial_read_string(serial, &path, &path_size)
+		|| !path
+		|| !ofc_serial_read_string(serial, &include, &include_size)
+		|| !ofc_serial_read_lang_opts(serial, &opts)
+		|| !ofc_serial_read_string(serial, &source, &source_size)
+		|| !source)
+		return NULL;
+
+	char spath[path_size + 1];
+	memcpy(spath, path, path_size);
+	spath[path_size] = '\0';
+
+	char sinclude[include_size + 1];
+	if (include)
+	{
+		memcpy(sinclude, include, include_size);
+		sinclude[include_size] = '\0';
+	}
+
+	ofc_file_t* file = ofc_file_create_include(
+		spath, opts, (include ? sinclude : NULL));
+	if (!file) return NULL;
+
+	const char* strz = ofc_file_get_strz(file);
+	if (!strz || (ofc_file_get_size(file) != source_size)
+		|| (memcmp(strz, source, source_size) != 0))
+	{
+		ofc_file_delete(file);
+		return NULL;
+	}
+
+	return file;
+}
+
+static bool ofc_parse_stmt__include_deserialize(
+	ofc_serial_t* serial, ofc_parse_stmt_t* stmt)
+{
+	unsigned index;
+	if (!ofc_serial_read_unsigned(serial, &index))
+		return false;
+
+	if (index > 0)
+	{
+		ofc_file_t*            file = ofc_serial_object(serial, (index - 1));
+		ofc_sparse_t*          src  = ofc_serial_object(serial, index);
+		ofc_parse_stmt_list_t* list = ofc_serial_object(serial, (index + 1));
+		if (!file || !src || !list)
+			return false;
+
+		if (!ofc_file_reference(file))
+			return false;
+		stmt->include.file = file;
+
+		if (!ofc_sparse_reference(src))
+			return false;
+		stmt->include.src = src;
+
+		if (!ofc_parse_stmt_list_reference(list))
+			return false;
+		stmt->include.include = list;
+		return true;
+	}
+
+	stmt->include.file = ofc_parse_stmt__include_file_deserialize(serial);
+	if (!stmt->include.file) return false;
+
+	stmt->include.src = ofc_sparse_deserialize(
+		serial, stmt->include.file);
+	if (!stmt->include.src) return false;
+
+	stmt->include.include = ofc_parse_stmt__root_deserialize(
+		serial, stmt->include.src);
+	return (stmt->include.include
+		&& ofc_serial_object_add(serial, stmt->include.file)
+		&& ofc_serial_object_add(serial, stmt->include.src)
+		&& ofc_serial_object_add(serial, stmt->include.include));
+}
+
+bool ofc_parse_stmt_serialize(
+	ofc_serial_t* serial, const ofc_parse_stmt_t* stmt)
+{
+	if (!ofc_serial_write_bool(serial, (stmt != NULL)))
+		return false;
+	if (!stmt)
+		return true;
+
+	if (!ofc_serial_write_uint(serial, stmt->type)
+		|| !ofc_serial_write_uint(serial, stmt->label))
+		return false;
+
+	if ((stmt->src.sparse != ofc_serial_sparse(serial))
+		|| !ofc_serial_write_str_ref(serial, stmt->src.string))
+		return false;
+
+	switch (stmt->type)
+	{
+		case OFC_PARSE_STMT_EMPTY:
+		case OFC_PARSE_STMT_ERROR:
+		case OFC_PARSE_STMT_IMPLICIT_NONE:
+		case OFC_PARSE_STMT_CONTINUE:
+		case OFC_PARSE_STMT_CYCLE:
+		case OFC_PARSE_STMT_EXIT:
+			return true;
+		case OFC_PARSE_STMT_INCLUDE:
+			return ofc_parse_stmt__include_serialize(serial, stmt);
+		case OFC_PARSE_STMT_PROGRAM:
+		case OFC_PARSE_STMT_SUBROUTINE:
+		case OFC_PARSE_STMT_FUNCTION:
+		case OFC_PARSE_STMT_BLOCK_DATA:
+			return (ofc_parse_type_serialize(serial, stmt->program.type)
+				&& ofc_serial_write_str_ref(serial, stmt->program.name)
+				&& ofc_parse_call_arg_list_serialize(serial, stmt->program.args)
+				&& ofc_parse_stmt_list_serialize(serial, stmt->program.body));
+		case OFC_PARSE_STMT_ASSIGNMENT:
+			return ofc_parse_assign_serialize(serial, stmt->assignment);
+		case OFC_PARSE_STMT_IMPLICIT:
+			return ofc_parse_implicit_list_serialize(serial, stmt->implicit);
+		case OFC_PARSE_STMT_CALL:
+		case OFC_PARSE_STMT_ENTRY:
+			return (ofc_serial_write_str_ref(serial, stmt->call_entry.name)
+				&& ofc_parse_call_arg_list_serialize(serial, stmt->call_entry.args));
+		case OFC_PARSE_STMT_DECL:
+			return (ofc_parse_type_serialize(serial, stmt->decl.type)
+				&& ofc_parse_decl_list_serialize(serial, stmt->decl.decl));
+		case OFC_PARSE_STMT_COMMON:
+		case OFC_PARSE_STMT_NAMELIST:
+			return ofc_parse_common_group_list_serialize(
+				serial, stmt->common_namelist);
+		case OFC_PARSE_STMT_DIMENSION:
+			return ofc_parse_lhs_list_serialize(serial, stmt->dimension);
+		case OFC_PARSE_STMT_EQUIVALENCE:
+			return ofc_parse_list_serialize(serial,
+				stmt->equivalence.count,
+				(const void**)stmt->equivalence.group,
+				(void*)ofc_parse_lhs_list_serialize);
+		case OFC_PARSE_STMT_STOP:
+		case OFC_PARSE_STMT_PAUSE:
+		case OFC_PARSE_STMT_RETURN:
+			return ofc_parse_expr_serialize(
+				serial, stmt->stop_pause_return.value);
+		case OFC_PARSE_STMT_DECL_ATTR_EXTERNAL:
+		case OFC_PARSE_STMT_DECL_ATTR_INTRINSIC:
+		case OFC_PARSE_STMT_DECL_ATTR_AUTOMATIC:
+		case OFC_PARSE_STMT_DECL_ATTR_STATIC:
+		case OFC_PARSE_STMT_DECL_ATTR_VOLATILE:
+			return ofc_parse_list_serialize(serial,
+				stmt->decl_attr.count,
+				(const void**)stmt->decl_attr.name,
+				(void*)ofc_parse_stmt__decl_attr_name_serialize);
+		case OFC_PARSE_STMT_POINTER:
+			return ofc_parse_pointer_list_serialize(serial, stmt->pointer);
+		case OFC_PARSE_STMT_GO_TO:
+			return ofc_parse_expr_serialize(serial, stmt->go_to.label);
+		case OFC_PARSE_STMT_GO_TO_ASSIGNED:
+		case OFC_PARSE_STMT_GO_TO_COMPUTED:
+			return (ofc_parse_expr_serialize(serial, stmt->go_to_list.cond)
+				&& ofc_parse_expr_list_serialize(serial, stmt->go_to_list.label));
+		case OFC_PARSE_STMT_IF_COMPUTED:
+			return (ofc_parse_expr_serialize(serial, stmt->if_comp.cond)
+				&& ofc_parse_expr_list_serialize(serial, stmt->if_comp.label));
+		case OFC_PARSE_STMT_IF_STATEMENT:
+			return (ofc_parse_expr_serialize(serial, stmt->if_stmt.cond)
+				&& ofc_parse_stmt_serialize(serial, stmt->if_stmt.stmt));
+		case OFC_PARSE_STMT_IF_THEN:
+			return (ofc_parse_expr_serialize(serial, stmt->if_then.cond)
+				&& ofc_parse_stmt_list_serialize(serial, stmt->if_then.block_then)
+				&& ofc_parse_stmt_list_serialize(serial, stmt->if_then.block_else));
+		case OFC_PARSE_STMT_DO_LABEL:
+			return (ofc_parse_expr_serialize(serial, stmt->do_label.end_label)
+				&& ofc_parse_assign_serialize(serial, stmt->do_label.init)
+				&& ofc_parse_expr_serialize(serial, stmt->do_label.last)
+				&& ofc_parse_expr_serialize(serial, stmt->do_label.step));
+		case OFC_PARSE_STMT_DO_BLOCK:
+			return (ofc_parse_assign_serialize(serial, stmt->do_block.init)
+				&& ofc_parse_expr_serialize(serial, stmt->do_block.last)
+				&& ofc_parse_expr_serialize(serial, stmt->do_block.step)
+				&& ofc_parse_stmt_list_serialize(serial, stmt->do_block.block));
+		case OFC_PARSE_STMT_DO_WHILE:
+			return (ofc_parse_expr_serialize(serial, stmt->do_while.end_label)
+				&& ofc_parse_expr_serialize(serial, stmt->do_while.cond));
+		case OFC_PARSE_STMT_DO_WHILE_BLOCK:
+			return (ofc_parse_expr_serialize(serial, stmt->do_while_block.cond)
+				&& ofc_parse_stmt_list_serialize(serial, stmt->do_while_block.block));
+		case OFC_PARSE_STMT_TYPE:
+		case OFC_PARSE_STMT_STRUCTURE:
+		case OFC_PARSE_STMT_UNION:
+		case OFC_PARSE_STMT_MAP:
+			return (ofc_serial_write_str_ref(serial, stmt->structure.name)
+				&& ofc_parse_stmt_list_serialize(serial, stmt->structure.block));
+		case OFC_PARSE_STMT_RECORD:
+			return ofc_parse_record_list_serialize(serial, stmt->record);
+		case OFC_PARSE_STMT_IO_REWIND:
+		case OFC_PARSE_STMT_IO_BACKSPACE:
+		case OFC_PARSE_STMT_IO_READ:
+		case OFC_PARSE_STMT_IO_WRITE:
+		case OFC_PARSE_STMT_IO_END_FILE:
+		case OFC_PARSE_STMT_IO_CLOSE:
+		case OFC_PARSE_STMT_IO_OPEN:
+		case OFC_PARSE_STMT_IO_INQUIRE:
+		case OFC_PARSE_STMT_IO_ENCODE:
+		case OFC_PARSE_STMT_IO_DECODE:
+			return (ofc_parse_call_arg_list_serialize(serial, stmt->io.params)
+				&& ofc_serial_write_bool(serial, stmt->io.has_brakets)
+				&& ofc_parse_expr_list_serialize(serial, stmt->io.iolist));
+		case OFC_PARSE_STMT_IO_PRINT:
+		case OFC_PARSE_STMT_IO_TYPE:
+		case OFC_PARSE_STMT_IO_ACCEPT:
+			return (ofc_parse_expr_serialize(serial, stmt->io_print.format)
+				&& ofc_serial_write_bool(serial, stmt->io_print.format_asterisk)
+				&& ofc_parse_expr_list_serialize(serial, stmt->io_print.iolist));
+		case OFC_PARSE_STMT_IO_DEFINE_FILE:
+			return ofc_parse_define_file_arg_list_serialize(
+				serial, stmt->io_define_file.args);
+		case OFC_PARSE_STMT_FORMAT:
+			return ofc_parse_format_desc_list_serialize(serial, stmt->format);
+		case OFC_PARSE_STMT_DATA:
+			return ofc_parse_data_list_serialize(serial, stmt->data);
+		case OFC_PARSE_STMT_SAVE:
+			return ofc_parse_save_list_serialize(serial, stmt->save.list);
+		case OFC_PARSE_STMT_PARAMETER:
+			return ofc_parse_assign_list_serialize(serial, stmt->parameter.list);
+		case OFC_PARSE_STMT_ASSIGN:
+			return (ofc_serial_write_uint(serial, stmt->assign.label)
+				&& ofc_serial_write_str_ref(serial, stmt->assign.variable));
+		default:
+			break;
+	}
+
+	return false;
+}
+
+static bool ofc_parse_stmt__deserialize(
+	ofc_serial_t* serial, ofc_parse_stmt_t* stmt)
+{
+	switch (stmt->type)
+	{
+		case OFC_PARSE_STMT_EMPTY:
+		case OFC_PARSE_STMT_ERROR:
+		case OFC_PARSE_STMT_IMPLICIT_NONE:
+		case OFC_PARSE_STMT_CONTINUE:
+		case OFC_PARSE_STMT_CYCLE:
+		case OFC_PARSE_STMT_EXIT:
+			return true;
+		case OFC_PARSE_STMT_INCLUDE:
+			return ofc_parse_stmt__include_deserialize(serial, stmt);
+		case OFC_PARSE_STMT_PROGRAM:
+		case OFC_PARSE_STMT_SUBROUTINE:
+		case OFC_PARSE_STMT_FUNCTION:
+		case OFC_PARSE_STMT_BLOCK_DATA:
+			return (ofc_parse_type_deserialize(serial, &stmt->program.type)
+				&& ofc_serial_read_str_ref(serial, &stmt->program.name)
+				&& ofc_parse_call_arg_list_deserialize(serial, &stmt->program.args)
+				&& ofc_parse_stmt_list_deserialize(serial, &stmt->program.body));
+		case OFC_PARSE_STMT_ASSIGNMENT:
+			return ofc_parse_assign_deserialize(serial, &stmt->assignment);
+		case OFC_PARSE_STMT_IMPLICIT:
+			return ofc_parse_implicit_list_deserialize(serial, &stmt->implicit);
+		case OFC_PARSE_STMT_CALL:
+		case OFC_PARSE_STMT_ENTRY:
+			return (ofc_serial_read_str_ref(serial, &stmt->call_entry.name)
+				&& ofc_parse_call_arg_list_deserialize(serial, &stmt->call_entry.args));
+		case OFC_PARSE_STMT_DECL:
+			return (ofc_parse_type_deserialize(serial, &stmt->decl.type)
+				&& ofc_parse_decl_list_deserialize(serial, &stmt->decl.decl));
+		case OFC_PARSE_STMT_COMMON:
+		case OFC_PARSE_STMT_NAMELIST:
+			return ofc_parse_common_group_list_deserialize(
+				serial, &stmt->common_namelist);
+		case OFC_PARSE_STMT_DIMENSION:
+			return ofc_parse_lhs_list_deserialize(serial, &stmt->dimension);
+		case OFC_PARSE_STMT_EQUIVALENCE:
+			return ofc_parse_list_deserialize(serial,
+				&stmt->equivalence.count,
+				(void***)&stmt->equivalence.group,
+				(void*)ofc_parse_lhs_list_deserialize,
+				(void*)ofc_parse_lhs_list_delete);
+		case OFC_PARSE_STMT_STOP:
+		case OFC_PARSE_STMT_PAUSE:
+		case OFC_PARSE_STMT_RETURN:
+			return ofc_parse_expr_deserialize(
+				serial, &stmt->stop_pause_return.value);
+		case OFC_PARSE_STMT_DECL_ATTR_EXTERNAL:
+		case OFC_PARSE_STMT_DECL_ATTR_INTRINSIC:
+		case OFC_PARSE_STMT_DECL_ATTR_AUTOMATIC:
+		case OFC_PARSE_STMT_DECL_ATTR_STATIC:
+		case OFC_PARSE_STMT_DECL_ATTR_VOLATILE:
+			return ofc_parse_list_deserialize(serial,
+				&stmt->decl_attr.count,
+				(void***)&stmt->decl_attr.name,
+				(void*)ofc_parse_stmt__decl_attr_name_deserialize,
+				ofc_parse_free);
+		case OFC_PARSE_STMT_POINTER:
+			return ofc_parse_pointer_list_deserialize(serial, &stmt->pointer);
+		case OFC_PARSE_STMT_GO_TO:
+			return ofc_parse_expr_deserialize(serial, &stmt->go_to.label);
+		case OFC_PARSE_STMT_GO_TO_ASSIGNED:
+		case OFC_PARSE_STMT_GO_TO_COMPUTED:
+			return (ofc_parse_expr_deserialize(serial, &stmt->go_to_list.cond)
+				&& ofc_parse_expr_list_deserialize(serial, &stmt->go_to_list.label));
+		case OFC_PARSE_STMT_IF_COMPUTED:
+			return (ofc_parse_expr_deserialize(serial, &stmt->if_comp.cond)
+				&& ofc_parse_expr_list_deserialize(serial, &stmt->if_comp.label));
+		case OFC_PARSE_STMT_IF_STATEMENT:
+			return (ofc_parse_expr_deserialize(serial, &stmt->if_stmt.cond)
+				&& ofc_parse_stmt_deserialize(serial, &stmt->if_stmt.stmt));
+		case OFC_PARSE_STMT_IF_THEN:
+			return (ofc_parse_expr_deserialize(serial, &stmt->if_then.cond)
+				&& ofc_parse_stmt_list_deserialize(serial, &stmt->if_then.block_then)
+				&& ofc_parse_stmt_list_deserialize(serial, &stmt->if_then.block_else));
+		case OFC_PARSE_STMT_DO_LABEL:
+			return (ofc_parse_expr_deserialize(serial, &stmt->do_label.end_label)
+				&& ofc_parse_assign_deserialize(serial, &stmt->do_label.init)
+				&& ofc_parse_expr_deserialize(serial, &stmt->do_label.last)
+				&& ofc_parse_expr_deserialize(serial, &stmt->do_label.step));
+		case OFC_PARSE_STMT_DO_BLOCK:
+			return (ofc_parse_assign_deserialize(serial, &stmt->do_block.init)
+				&& ofc_parse_expr_deserialize(serial, &stmt->do_block.last)
+				&& ofc_parse_expr_deserialize(serial, &stmt->do_block.step)
+				&& ofc_parse_stmt_list_deserialize(serial, &stmt->do_block.block));
+		case OFC_PARSE_STMT_DO_WHILE:
+			return (ofc_parse_expr_deserialize(serial, &stmt->do_while.end_label)
+				&& ofc_parse_expr_deserialize(serial, &stmt->do_while.cond));
+		case OFC_PARSE_STMT_DO_WHILE_BLOCK:
+			return (ofc_parse_expr_deserialize(serial, &stmt->do_while_block.cond)
+				&& ofc_parse_stmt_list_deserialize(serial, &stmt->do_while_block.block));
+		case OFC_PARSE_STMT_TYPE:
+		case OFC_PARSE_STMT_STRUCTURE:
+		case OFC_PARSE_STMT_UNION:
+		case OFC_PARSE_STMT_MAP:
+			return (ofc_serial_read_str_ref(serial, &stmt->structure.name)
+				&& ofc_parse_stmt_list_deserialize(serial, &stmt->structure.block));
+		case OFC_PARSE_STMT_RECORD:
+			return ofc_parse_record_list_deserialize(serial, &stmt->record);
+		case OFC_PARSE_STMT_IO_REWIND:
+		case OFC_PARSE_STMT_IO_BACKSPACE:
+		case OFC_PARSE_STMT_IO_READ:
+		case OFC_PARSE_STMT_IO_WRITE:
+		case OFC_PARSE_STMT_IO_END_FILE:
+		case OFC_PARSE_STMT_IO_CLOSE:
+		case OFC_PARSE_STMT_IO_OPEN:
+		case OFC_PARSE_STMT_IO_INQUIRE:
+		case OFC_PARSE_STMT_IO_ENCODE:
+		case OFC_PARSE_STMT_IO_DECODE:
+			return (ofc_parse_call_arg_list_deserialize(serial, &stmt->io.params)
+				&& ofc_serial_read_bool(serial, &stmt->io.has_brakets)
+				&& ofc_parse_expr_list_deserialize(serial, &stmt->io.iolist));
+		case OFC_PARSE_STMT_IO_PRINT:
+		case OFC_PARSE_STMT_IO_TYPE:
+		case OFC_PARSE_STMT_IO_ACCEPT:
+			return (ofc_parse_expr_deserialize(serial, &stmt->io_print.format)
+				&& ofc_serial_read_bool(serial, &stmt->io_print.format_asterisk)
+				&& ofc_parse_expr_list_deserialize(serial, &stmt->io_print.iolist));
+		case OFC_PARSE_STMT_IO_DEFINE_FILE:
+			return ofc_parse_define_file_arg_list_deserialize(
+				serial, &stmt->io_define_file.args);
+		case OFC_PARSE_STMT_FORMAT:
+			return ofc_parse_format_desc_list_deserialize(serial, &stmt->format);
+		case OFC_PARSE_STMT_DATA:
+			return ofc_parse_data_list_deserialize(serial, &stmt->data);
+		case OFC_PARSE_STMT_SAVE:
+			return ofc_parse_save_list_deserialize(serial, &stmt->save.list);
+		case OFC_PARSE_STMT_PARAMETER:
+			return ofc_parse_assign_list_deserialize(serial, &stmt->parameter.list);
+		case OFC_PARSE_STMT_ASSIGN:
+			return (ofc_serial_read_unsigned(serial, &stmt->assign.label)
+				&& ofc_serial_read_str_ref(serial, &stmt->assign.variable));
+		default:
+			break;
+	}
+
+	return false;
+}
+
+bool ofc_parse_stmt_deserialize(
+	ofc_serial_t* serial, ofc_parse_stmt_t** stmt)
+{
+	bool present;
+	if (!stmt || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*stmt = NULL;
+	if (!present)
+		return true;
+
+	/* Everything is cleared so a partial statement can be cleaned up. */
+	ofc_parse_stmt_t s;
+	memset(&s, 0x00, sizeof(s));
+
+	unsigned type;
+	if (!ofc_serial_read_unsigned(serial, &type)
+		|| (type > OFC_PARSE_STMT_ASSIGN)
+		|| !ofc_serial_read_unsigned(serial, &s.label))
+		return false;
+	s.type = type;
+
+	s.src.sparse = ofc_serial_sparse(serial);
+	if (!ofc_serial_read_str_ref(serial, &s.src.string))
+		return false;
+
+	if (!ofc_parse_stmt__deserialize(serial, &s))
+	{
+		ofc_parse_stmt__cleanup(&s);
+		return false;
+	}
+
+	*stmt = ofc_parse_stmt__alloc(&s);
+	if (!*stmt)
+	{
+		ofc_parse_stmt__cleanup(&s);
+		return false;
+	}
+	return true;
+}
+
+bool ofc_parse_stmt_list_serialize(
+	ofc_serial_t* serial, const ofc_parse_stmt_list_t* list)
+{
+	if (!ofc_serial_write_bool(serial, (list != NULL)))
+		return false;
+
+	return (!list || ofc_parse_list_serialize(
+		serial, list->count, (const void**)list->stmt,
+		(void*)ofc_parse_stmt_serialize));
+}
+
+bool ofc_parse_stmt_list_deserialize(
+	ofc_serial_t* serial, ofc_parse_stmt_list_t** list)
+{
+	bool present;
+	if (!list || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*list = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_stmt_list_t* l
+		= (ofc_parse_stmt_list_t*)ofc_parse_alloc(
+			sizeof(ofc_parse_stmt_list_t));
+	if (!l) return false;
+
+	l->arena = NULL;
+	l->ref   = 0;
+
+	if (!ofc_parse_list_deserialize(
+		serial, &l->count, (void***)&l->stmt,
+		(void*)ofc_parse_stmt_deserialize,
+		(void*)ofc_parse_stmt_delete))
+	{
+		ofc_parse_free(l);
+		return false;
+	}
+
+	*list = l;
+	return true;
+}
@@ -36,7 +36,7 @@ static unsigned ofc_parse_stmt__decl_attr(
 		&stmt->decl_attr.count,
 		(void***)&stmt->decl_attr.name,
 		(void*)ofc_parse_name_alloc,
-		free);
+		ofc_parse_free);
 	if (l == 0)
 	{
 		ofc_parse_debug_rewind(debug, dpos);
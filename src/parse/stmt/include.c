@@ -56,8 +56,9 @@ unsigned ofc_parse_stmt_include(
 
 	const char* include_path = ofc_sparse_get_include(src);
 	char* rpath = ofc_sparse_include_path(src, path);
-	stmt->include.file = ofc_file_create_include(
-		rpath, ofc_sparse_lang_opts(src), include_path);
+	stmt->include.include = ofc_parse_file_include(
+		rpath, ofc_sparse_lang_opts(src), include_path,
+		&stmt->include.file, &stmt->include.src);
 
 	if (!stmt->include.file)
 	{
@@ -68,12 +69,8 @@ unsigned ofc_parse_stmt_include(
 	}
 	free(rpath);
 
-	stmt->include.src = ofc_prep(stmt->include.file);
-	stmt->include.include = ofc_parse_file(stmt->include.src);
 	if (!stmt->include.include)
 	{
-		ofc_parse_stmt_list_delete(stmt->include.include);
-		ofc_sparse_delete(stmt->include.src);
 		ofc_file_delete(stmt->include.file);
 		return 0;
 	}
@@ -63,7 +63,7 @@ unsigned ofc_parse_stmt_program__body(
 }
 
 /* This is hacky, but it means we can suppress redeclarations of the same program. */
-static ofc_str_ref_t ofc_parse_stmt_program__current = OFC_STR_REF_EMPTY;
+static __thread ofc_str_ref_t ofc_parse_stmt_program__current = OFC_STR_REF_EMPTY;
 
 unsigned ofc_parse_stmt_program(
 	const ofc_sparse_t* src, const char* ptr,
@@ -105,6 +105,7 @@ unsigned ofc_parse_stmt_program(
 	len = ofc_parse_stmt_program__body(
 		src, &ptr[i], debug,
 		OFC_PARSE_KEYWORD_PROGRAM, stmt);
+	ofc_parse_stmt_program__current = prev_program_name;
 	if (len == 0)
 	{
 		ofc_parse_debug_rewind(debug, dpos);
@@ -112,8 +113,6 @@ unsigned ofc_parse_stmt_program(
 	}
 	i += len;
 
-	ofc_parse_stmt_program__current = prev_program_name;
-
 	stmt->program.type = NULL;
 	stmt->program.args = NULL;
 
@@ -259,7 +258,7 @@ unsigned ofc_parse_stmt_function(
 
 
 /* This is hacky, but it means we can suppress redeclarations of the same block_data. */
-static ofc_str_ref_t ofc_parse_stmt_block_data__current = OFC_STR_REF_EMPTY;
+static __thread ofc_str_ref_t ofc_parse_stmt_block_data__current = OFC_STR_REF_EMPTY;
 
 unsigned ofc_parse_stmt_block_data(
 	const ofc_sparse_t* src, const char* ptr,
@@ -301,6 +300,7 @@ unsigned ofc_parse_stmt_block_data(
 	len = ofc_parse_stmt_program__body(
 		src, &ptr[i], debug,
 		OFC_PARSE_KEYWORD_BLOCK_DATA, stmt);
+	ofc_parse_stmt_block_data__current = prev_block_data_name;
 	if (len == 0)
 	{
 		ofc_parse_debug_rewind(debug, dpos);
@@ -308,8 +308,6 @@ unsigned ofc_parse_stmt_block_data(
 	}
 	i += len;
 
-	ofc_parse_stmt_block_data__current = prev_block_data_name;
-
 	stmt->program.type = NULL;
 	stmt->program.args = NULL;
 
@@ -217,7 +217,7 @@ unsigned ofc_parse_stmt_record(
 	unsigned l;
 	stmt->record = ofc_parse_record_list(
 		src, &ptr[i], debug, &l);
-	if (l == 0)
+	if (!stmt->record)
 	{
 		ofc_parse_debug_rewind(debug, dpos);
 		return 0;
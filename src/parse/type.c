@@ -113,7 +113,7 @@ static unsigned ofc_parse_decl_attr(
 ofc_parse_type_t* ofc_parse_type__alloc(ofc_parse_type_t type)
 {
 	ofc_parse_type_t* atype
-		= (ofc_parse_type_t*)malloc(
+		= (ofc_parse_type_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_type_t));
 	if (!atype) return NULL;
 
@@ -286,7 +286,7 @@ void ofc_parse_type_delete(ofc_parse_type_t* type)
 		return;
 
 	ofc_parse_type__cleanup(*type);
-	free(type);
+	ofc_parse_free(type);
 }
 
 bool ofc_parse_type_print(
@@ -409,3 +409,64 @@ bool ofc_parse_type_print_f77(
 
 	return true;
 }
+
+bool ofc_parse_type_serialize(
+	ofc_serial_t* serial, const ofc_parse_type_t* type)
+{
+	if (!ofc_serial_write_bool(serial, (type != NULL)))
+		return false;
+
+	return (!type
+		|| (ofc_serial_write_str_ref(serial, type->src)
+			&& ofc_serial_write_uint(serial, type->type)
+			&& ofc_serial_write_str_ref(serial, type->type_name)
+			&& ofc_serial_write_bool(serial, type->attr.is_static)
+			&& ofc_serial_write_bool(serial, type->attr.is_volatile)
+			&& ofc_serial_write_bool(serial, type->attr.is_automatic)
+			&& ofc_serial_write_uint(serial, type->kind)
+			&& ofc_parse_expr_serialize(serial, type->count_expr)
+			&& ofc_serial_write_bool(serial, type->count_var)
+			&& ofc_parse_call_arg_list_serialize(serial, type->params)));
+}
+
+bool ofc_parse_type_deserialize(
+	ofc_serial_t* serial, ofc_parse_type_t** type)
+{
+	bool present;
+	if (!type || !ofc_serial_read_bool(serial, &present))
+		return false;
+
+	*type = NULL;
+	if (!present)
+		return true;
+
+	ofc_parse_type_t t;
+	t.count_expr = NULL;
+	t.params     = NULL;
+
+	unsigned ttype;
+	if (!ofc_serial_read_str_ref(serial, &t.src)
+		|| !ofc_serial_read_unsigned(serial, &ttype)
+		|| (ttype >= OFC_PARSE_TYPE_COUNT)
+		|| !ofc_serial_read_str_ref(serial, &t.type_name)
+		|| !ofc_serial_read_bool(serial, &t.attr.is_static)
+		|| !ofc_serial_read_bool(serial, &t.attr.is_volatile)
+		|| !ofc_serial_read_bool(serial, &t.attr.is_automatic)
+		|| !ofc_serial_read_unsigned(serial, &t.kind)
+		|| !ofc_parse_expr_deserialize(serial, &t.count_expr)
+		|| !ofc_serial_read_bool(serial, &t.count_var)
+		|| !ofc_parse_call_arg_list_deserialize(serial, &t.params))
+	{
+		ofc_parse_type__cleanup(t);
+		return false;
+	}
+	t.type = ttype;
+
+	*type = ofc_parse_type__alloc(t);
+	if (!*type)
+	{
+		ofc_parse_type__cleanup(t);
+		return false;
+	}
+	return true;
+}
@@ -16,33 +16,212 @@
 #include <ofc/prep.h>
 #include <ofc/fctype.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
-ofc_sparse_t* ofc_prep_condense(ofc_sparse_t* unformat)
+
+/* Condensing is a pure byte scan, so whitespace is classified a block
+   at a time into a bitmask and runs are found from the mask edges. */
+#if defined(__AVX2__)
+#define OFC_PREP_CONDENSE__BLOCK 32
+#elif defined(__SSE2__)
+#define OFC_PREP_CONDENSE__BLOCK 16
+#else
+#define OFC_PREP_CONDENSE__BLOCK 8
+#endif
+
+static inline uint64_t ofc_prep_condense__mask(const char* ptr)
 {
-	const char* src = ofc_sparse_strz(unformat);
-	if (!src) return NULL;
+#if defined(__AVX2__)
+	__m256i c = _mm256_loadu_si256((const __m256i*)ptr);
+	__m256i m = _mm256_or_si256(
+		_mm256_or_si256(
+			_mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')),
+			_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\t'))),
+		_mm256_or_si256(
+			_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\f')),
+			_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\v'))));
+	return (uint32_t)_mm256_movemask_epi8(m);
+#elif defined(__SSE2__)
+	__m128i c = _mm_loadu_si128((const __m128i*)ptr);
+	__m128i m = _mm_or_si128(
+		_mm_or_si128(
+			_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')),
+			_mm_cmpeq_epi8(c, _mm_set1_epi8('\t'))),
+		_mm_or_si128(
+			_mm_cmpeq_epi8(c, _mm_set1_epi8('\f')),
+			_mm_cmpeq_epi8(c, _mm_set1_epi8('\v'))));
+	return (uint16_t)_mm_movemask_epi8(m);
+#else
+	uint64_t mask = 0;
+	unsigned i;
+	for (i = 0; i < OFC_PREP_CONDENSE__BLOCK; i++)
+	{
+		if (ofc_is_hspace(ptr[i]))
+			mask |= (1ULL << i);
+	}
+	return mask;
+#endif
+}
+
+/* Calls emit with the offset and length of each run of non-whitespace
+   in src, stopping early if emit fails. */
+static bool ofc_prep_condense__scan(
+	const char* src, unsigned len,
+	bool (*emit)(void*, unsigned, unsigned), void* param)
+{
+	const uint64_t full
+		= (OFC_PREP_CONDENSE__BLOCK >= 64 ? ~0ULL
+			: ((1ULL << OFC_PREP_CONDENSE__BLOCK) - 1));
+
+	/* Whether the byte before the current block was part of a run. */
+	uint64_t prev = 0;
+	unsigned start = 0;
+
+	unsigned b;
+	for (b = 0; (b + OFC_PREP_CONDENSE__BLOCK) <= len;
+		b += OFC_PREP_CONDENSE__BLOCK)
+	{
+		uint64_t solid = (~ofc_prep_condense__mask(&src[b]) & full);
+		uint64_t shift = (((solid << 1) | prev) & full);
+
+		uint64_t starts = (solid & ~shift);
+		uint64_t edges  = (starts | (~solid & shift));
+		prev = (solid >> (OFC_PREP_CONDENSE__BLOCK - 1));
+
+		while (edges)
+		{
+			unsigned i = __builtin_ctzll(edges);
+			edges &= (edges - 1);
+
+			if ((starts >> i) & 1)
+				start = (b + i);
+			else if (!emit(param, start, ((b + i) - start)))
+				return false;
+		}
+	}
+
+	for (; b < len; b++)
+	{
+		bool solid = !ofc_is_hspace(src[b]);
+		if (solid && !prev)
+			start = b;
+		else if (!solid && prev
+			&& !emit(param, start, (b - start)))
+			return false;
+		prev = solid;
+	}
+
+	return (!prev || emit(param, start, (len - start)));
+}
+
+
+void ofc_prep_runs_init(ofc_prep_runs_t* runs, unsigned hint)
+{
+	runs->count = 0;
+	runs->max   = 0;
+	runs->run   = NULL;
+
+	if (hint == 0)
+		return;
+
+	runs->run = (ofc_prep_run_t*)malloc(
+		sizeof(ofc_prep_run_t) * hint);
+	if (runs->run) runs->max = hint;
+}
+
+void ofc_prep_runs_cleanup(ofc_prep_runs_t* runs)
+{
+	if (!runs)
+		return;
+
+	free(runs->run);
+	runs->count = 0;
+	runs->max   = 0;
+	runs->run   = NULL;
+}
+
+typedef struct
+{
+	ofc_prep_runs_t* runs;
+	unsigned         off;
+} ofc_prep_runs__scan_t;
+
+static bool ofc_prep_runs__emit(
+	void* param, unsigned off, unsigned len)
+{
+	ofc_prep_runs__scan_t* scan
+		= (ofc_prep_runs__scan_t*)param;
+	ofc_prep_runs_t* runs = scan->runs;
+	off += scan->off;
+
+	/* Runs either side of an append boundary may touch. */
+	if (runs->count > 0)
+	{
+		ofc_prep_run_t* last = &runs->run[runs->count - 1];
+		if ((last->off + last->len) == off)
+		{
+			last->len += len;
+			return true;
+		}
+	}
+
+	if (runs->count >= runs->max)
+	{
+		unsigned nmax = (runs->max << 1);
+		if (nmax == 0) nmax = 256;
+		ofc_prep_run_t* nrun
+			= (ofc_prep_run_t*)realloc(runs->run,
+				(sizeof(ofc_prep_run_t) * nmax));
+		if (!nrun) return false;
+		runs->run = nrun;
+		runs->max = nmax;
+	}
+
+	runs->run[runs->count].off = off;
+	runs->run[runs->count].len = len;
+	runs->count++;
+	return true;
+}
+
+bool ofc_prep_runs_scan(ofc_prep_runs_t* runs,
+	const char* src, unsigned len, unsigned off)
+{
+	if (!runs || (!src && (len > 0)))
+		return false;
+
+	ofc_prep_runs__scan_t scan = { runs, off };
+	return ofc_prep_condense__scan(
+		src, len, ofc_prep_runs__emit, &scan);
+}
+
+
+ofc_sparse_t* ofc_prep_condense_runs(
+	ofc_sparse_t* unformat, const ofc_prep_runs_t* runs)
+{
+	if (!runs)
+		return NULL;
 
 	ofc_sparse_t* condense
 		= ofc_sparse_create_child(unformat);
 	if (!condense) return NULL;
 
-	unsigned i = 0;
-	while (src[i] != '\0')
+	const char* src = ofc_sparse_strz(unformat);
+	if (!src || !ofc_sparse_reserve(condense, runs->count))
 	{
-		/* Skip whitespace. */
-		for (; (src[i] != '\0') && ofc_is_hspace(src[i]); i++);
-
-		if (src[i] == '\0')
-			break;
-
-		/* Parse non-whitespace. */
-		const char* base = &src[i];
-		unsigned size;
-		for(size = 0; (src[i] != '\0') && !ofc_is_hspace(src[i]); size++, i++);
+		ofc_sparse_delete(condense);
+		return NULL;
+	}
 
-		/* Append non-whitespace to condense sparse. */
-		if (!ofc_sparse_append_strn(condense, base, size))
+	unsigned i;
+	for (i = 0; i < runs->count; i++)
+	{
+		if (!ofc_sparse_append_strn(condense,
+			&src[runs->run[i].off], runs->run[i].len))
 		{
 			ofc_sparse_delete(condense);
 			return NULL;
@@ -52,3 +231,27 @@ ofc_sparse_t* ofc_prep_condense(ofc_sparse_t* unformat)
 	ofc_sparse_lock(condense);
 	return condense;
 }
+
+ofc_sparse_t* ofc_prep_condense(ofc_sparse_t* unformat)
+{
+	/* Lock so that we can scan the text. */
+	ofc_sparse_lock(unformat);
+
+	const char* src = ofc_sparse_strz(unformat);
+	if (!src) return NULL;
+
+	unsigned len = strlen(src);
+
+	ofc_prep_runs_t runs;
+	ofc_prep_runs_init(&runs, (len / 4));
+	if (!ofc_prep_runs_scan(&runs, src, len, 0))
+	{
+		ofc_prep_runs_cleanup(&runs);
+		return NULL;
+	}
+
+	ofc_sparse_t* condense
+		= ofc_prep_condense_runs(unformat, &runs);
+	ofc_prep_runs_cleanup(&runs);
+	return condense;
+}
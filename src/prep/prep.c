@@ -19,12 +19,23 @@
 
 ofc_sparse_t* ofc_prep(ofc_file_t* file)
 {
+	/* Runs are found while unformatting, so the unformatted text
+	   is only scanned once. */
+	ofc_prep_runs_t runs;
+	ofc_prep_runs_init(&runs,
+		(ofc_file_get_size(file) / 8));
+
 	ofc_sparse_t* unformat
-		= ofc_prep_unformat(file);
-	if (!unformat) return NULL;
+		= ofc_prep_unformat(file, &runs);
+	if (!unformat)
+	{
+		ofc_prep_runs_cleanup(&runs);
+		return NULL;
+	}
 
 	ofc_sparse_t* condense
-		= ofc_prep_condense(unformat);
+		= ofc_prep_condense_runs(unformat, &runs);
+	ofc_prep_runs_cleanup(&runs);
 	ofc_sparse_delete(unformat);
 	return condense;
 }
@@ -217,10 +217,22 @@ static const pre_state_t PRE_STATE_DEFAULT =
 	.in_number = false,
 };
 
+static bool ofc_prep_unformat__append(
+	ofc_sparse_t* sparse, ofc_prep_runs_t* runs,
+	const char* src, unsigned len)
+{
+	unsigned off = ofc_sparse_len(sparse);
+	if (!ofc_sparse_append_strn(sparse, src, len))
+		return false;
+
+	return (!runs || ofc_prep_runs_scan(
+		runs, src, len, off));
+}
+
 static unsigned ofc_prep_unformat__fixed_form_code(
 	unsigned* col, pre_state_t* state,
 	const ofc_file_t* file, const char* src, ofc_lang_opts_t opts,
-	ofc_sparse_t* sparse)
+	ofc_sparse_t* sparse, ofc_prep_runs_t* runs)
 {
 	if (!src)
 		return 0;
@@ -251,6 +263,12 @@ static unsigned ofc_prep_unformat__fixed_form_code(
 			if (src[i] == '!')
 				break;
 
+			/* Mark where the next statement on this line starts. */
+			if ((src[i] == ';') && sparse
+				&& !ofc_sparse_stmt_add(sparse,
+					(ofc_sparse_len(sparse) + i + 1)))
+				return 0;
+
 			if ((src[i] == '\"')
 				|| (src[i] == '\''))
 			{
@@ -314,8 +332,8 @@ static unsigned ofc_prep_unformat__fixed_form_code(
 		*col += (src[i] == '\t' ? opts.tab_width : 1);
 	}
 
-	if (sparse && !ofc_sparse_append_strn(
-		sparse, src, i))
+	if (sparse && !ofc_prep_unformat__append(
+		sparse, runs, src, i))
 		return 0;
 
 	return i;
@@ -324,7 +342,8 @@ static unsigned ofc_prep_unformat__fixed_form_code(
 static unsigned ofc_prep_unformat__free_form_code(
 	unsigned* col, pre_state_t* state,
 	const ofc_file_t* file, const char* src, ofc_lang_opts_t opts,
-	ofc_sparse_t* sparse, bool* continuation)
+	ofc_sparse_t* sparse, ofc_prep_runs_t* runs,
+	bool* continuation)
 {
 	if (!src)
 		return 0;
@@ -375,6 +394,12 @@ static unsigned ofc_prep_unformat__free_form_code(
 			if (src[i] == '!')
 				break;
 
+			/* Mark where the next statement on this line starts. */
+			if ((src[i] == ';') && sparse
+				&& !ofc_sparse_stmt_add(sparse,
+					(ofc_sparse_len(sparse) + i + 1)))
+				return 0;
+
 			if (src[i] == '&')
 			{
 				last_ampersand = i;
@@ -452,15 +477,61 @@ static unsigned ofc_prep_unformat__free_form_code(
 	if (valid_ampersand)
 		code_len = last_ampersand;
 
-	if (sparse && !ofc_sparse_append_strn(
-		sparse, src, code_len))
+	if (sparse && !ofc_prep_unformat__append(
+		sparse, runs, src, code_len))
 		return 0;
 
 	return i;
 }
 
+bool ofc_prep_unit_end(
+	const char* src, unsigned len)
+{
+	/* Only enough is kept to compare, the rest is just checked. */
+	char code[16];
+	unsigned size = 0;
+
+	unsigned i;
+	for (i = 0; i < len; i++)
+	{
+		if (ofc_is_hspace(src[i]))
+			continue;
+		if (!isalnum(src[i]) && (src[i] != '_'))
+			return false;
+		if (size < sizeof(code))
+			code[size] = toupper(src[i]);
+		size++;
+	}
+
+	if ((size < 3) || (memcmp(code, "END", 3) != 0))
+		return false;
+	if (size == 3)
+		return true;
+
+	static const char* unit[] =
+	{
+		"PROGRAM",
+		"SUBROUTINE",
+		"FUNCTION",
+		"BLOCKDATA",
+		"MODULE",
+		NULL
+	};
+
+	for (i = 0; unit[i]; i++)
+	{
+		unsigned ulen = strlen(unit[i]);
+		if (((size - 3) >= ulen)
+			&& (memcmp(&code[3], unit[i], ulen) == 0))
+			return true;
+	}
+
+	return false;
+}
+
 static bool ofc_prep_unformat__fixed_form(
-	const ofc_file_t* file, ofc_sparse_t* sparse)
+	const ofc_file_t* file, ofc_sparse_t* sparse,
+	ofc_prep_runs_t* runs)
 {
 	const char*     src   = ofc_file_get_strz(file);
 	ofc_lang_opts_t opts  = ofc_file_get_lang_opts(file);
@@ -539,7 +610,7 @@ static bool ofc_prep_unformat__fixed_form(
 		/* Insert single newline character at the end of each line of output. */
 		if ((has_code || has_label)
 			&& !first_code_line && !continuation
-			&& !ofc_sparse_append_strn(sparse, newline, 1))
+			&& !ofc_prep_unformat__append(sparse, runs, newline, 1))
 			return false;
 
 		if (has_code)
@@ -551,9 +622,13 @@ static bool ofc_prep_unformat__fixed_form(
 					return false;
 			}
 
+			if (!continuation && !ofc_sparse_stmt_add(
+				sparse, ofc_sparse_len(sparse)))
+				return false;
+
 			/* Append non-empty line to output. */
 			len = ofc_prep_unformat__fixed_form_code(
-				&col, &state, file, &src[pos], opts, sparse);
+				&col, &state, file, &src[pos], opts, sparse, runs);
 			pos += len;
 			if (len == 0) return false;
 
@@ -581,7 +656,8 @@ static bool ofc_prep_unformat__fixed_form(
 }
 
 static bool ofc_prep_unformat__free_form(
-	const ofc_file_t* file, ofc_sparse_t* sparse)
+	const ofc_file_t* file, ofc_sparse_t* sparse,
+	ofc_prep_runs_t* runs)
 {
 	const char*     src   = ofc_file_get_strz(file);
 	ofc_lang_opts_t opts  = ofc_file_get_lang_opts(file);
@@ -661,12 +737,16 @@ static bool ofc_prep_unformat__free_form(
 			}
 
 			if (!first_code_line && !continuation
-				&& !ofc_sparse_append_strn(sparse, newline, 1))
+				&& !ofc_prep_unformat__append(sparse, runs, newline, 1))
+				return false;
+
+			if (!continuation && !ofc_sparse_stmt_add(
+				sparse, ofc_sparse_len(sparse)))
 				return false;
 
 			len = ofc_prep_unformat__free_form_code(
 				&col, &state, file, &src[pos], opts,
-				sparse, &continuation);
+				sparse, runs, &continuation);
 			pos += len;
 			if (len == 0) return false;
 
@@ -696,7 +776,8 @@ static bool ofc_prep_unformat__free_form(
 	return true;
 }
 
-ofc_sparse_t* ofc_prep_unformat(ofc_file_t* file)
+ofc_sparse_t* ofc_prep_unformat(
+	ofc_file_t* file, ofc_prep_runs_t* runs)
 {
 	ofc_sparse_t* unformat
 		= ofc_sparse_create_file(file);
@@ -707,10 +788,10 @@ ofc_sparse_t* ofc_prep_unformat(ofc_file_t* file)
 	{
 		case OFC_LANG_FORM_FIXED:
 		case OFC_LANG_FORM_TAB:
-			success = ofc_prep_unformat__fixed_form(file, unformat);
+			success = ofc_prep_unformat__fixed_form(file, unformat, runs);
 			break;
 		case OFC_LANG_FORM_FREE:
-			success = ofc_prep_unformat__free_form(file, unformat);
+			success = ofc_prep_unformat__free_form(file, unformat, runs);
 			break;
 		default:
 			break;
@@ -0,0 +1,66 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ofc/sema.h>
+
+
+/* Thread local, since interning types swaps it out for the heap. */
+static __thread ofc_arena_t* ofc_sema_arena__current = NULL;
+
+
+ofc_arena_t* ofc_sema_arena_swap(ofc_arena_t* arena)
+{
+	ofc_arena_t* prev = ofc_sema_arena__current;
+	ofc_sema_arena__current = arena;
+	return prev;
+}
+
+
+void* ofc_sema_alloc(size_t size)
+{
+	return ofc_arena_block_alloc(
+		ofc_sema_arena__current, size);
+}
+
+void* ofc_sema_realloc(void* ptr, size_t size)
+{
+	return ofc_arena_block_realloc(
+		ofc_sema_arena__current, ptr, size);
+}
+
+void ofc_sema_free(void* ptr)
+{
+	ofc_arena_block_free(ptr);
+}
+
+bool ofc_sema_arena_owned(const void* ptr)
+{
+	return ofc_arena_block_owned(ptr);
+}
+
+
+bool ofc_sema_arena_hashmap(
+	const void* owner, ofc_hashmap_t* map)
+{
+	if (!map)
+		return false;
+
+	if (!ofc_sema_arena_owned(owner))
+		return true;
+
+	return ofc_arena_cleanup(
+		ofc_sema_arena__current,
+		(void*)ofc_hashmap_delete, map);
+}
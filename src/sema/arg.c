@@ -18,15 +18,15 @@
 static ofc_sema_arg_list_t* ofc_sema_arg_list__create(unsigned count)
 {
 	ofc_sema_arg_list_t* list
-		= (ofc_sema_arg_list_t*)malloc(
+		= (ofc_sema_arg_list_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_arg_list_t));
 	if (!list) return NULL;
 
-	list->arg = (ofc_sema_arg_t*)malloc(
+	list->arg = (ofc_sema_arg_t*)ofc_sema_alloc(
 		sizeof(ofc_sema_arg_t) * count);
 	if (!list->arg)
 	{
-		free(list);
+		ofc_sema_free(list);
 		return NULL;
 	}
 
@@ -165,9 +165,9 @@ ofc_sema_arg_list_t* ofc_sema_arg_list_stmt_func(
 void ofc_sema_arg_list_delete(
 	ofc_sema_arg_list_t* list)
 {
-	if (!list)
+	if (!list || ofc_sema_arena_owned(list))
 		return;
 
-	free(list->arg);
-	free(list);
+	ofc_sema_free(list->arg);
+	ofc_sema_free(list);
 }
@@ -36,7 +36,7 @@ ofc_sema_array_t* ofc_sema_array(
 	}
 
 	ofc_sema_array_t* array
-		= (ofc_sema_array_t*)malloc(sizeof(ofc_sema_array_t)
+		= (ofc_sema_array_t*)ofc_sema_alloc(sizeof(ofc_sema_array_t)
 			+ (index->count * sizeof(ofc_sema_array_dims_t)));
 	if (!array) return NULL;
 
@@ -172,7 +172,7 @@ ofc_sema_array_t* ofc_sema_array_copy(
 		return NULL;
 
 	ofc_sema_array_t* copy
-		= (ofc_sema_array_t*)malloc(sizeof(ofc_sema_array_t)
+		= (ofc_sema_array_t*)ofc_sema_alloc(sizeof(ofc_sema_array_t)
 			+ (sizeof(ofc_sema_array_dims_t) * array->dimensions));
 	if (!copy) return NULL;
 
@@ -194,20 +194,20 @@ ofc_sema_array_t* ofc_sema_array_copy(
 void ofc_sema_array_delete(
 	ofc_sema_array_t* array)
 {
-	if (!array)
+	if (!array || ofc_sema_arena_owned(array))
 		return;
 
-	free(array);
+	ofc_sema_free(array);
 }
 
 
-uint8_t ofc_sema_array_hash(
+unsigned ofc_sema_array_hash(
 	const ofc_sema_array_t* array)
 {
 	if (!array)
 		return 0;
 
-	uint8_t hash = array->dimensions;
+	unsigned hash = array->dimensions;
 
 	unsigned i;
 	for (i = 0; i < array->dimensions; i++)
@@ -333,7 +333,7 @@ ofc_sema_array_index_t* ofc_sema_array_index(
 	}
 
 	ofc_sema_array_index_t* ai
-		= (ofc_sema_array_index_t*)malloc(sizeof(ofc_sema_array_index_t)
+		= (ofc_sema_array_index_t*)ofc_sema_alloc(sizeof(ofc_sema_array_index_t)
 			+ (index->count * sizeof(ofc_sema_expr_t*)));
 	if (!ai) return NULL;
 
@@ -430,14 +430,14 @@ bool ofc_sema_array_index_print(
 void ofc_sema_array_index_delete(
 	ofc_sema_array_index_t* index)
 {
-	if (!index)
+	if (!index || ofc_sema_arena_owned(index))
 		return;
 
 	unsigned i;
 	for (i = 0; i < index->dimensions; i++)
 		ofc_sema_expr_delete(index->index[i]);
 
-	free(index);
+	ofc_sema_free(index);
 }
 
 
@@ -561,7 +561,7 @@ ofc_sema_array_slice_t* ofc_sema_array_slice(
 void ofc_sema_array_slice_delete(
 	ofc_sema_array_slice_t* slice)
 {
-	if (!slice)
+	if (!slice || ofc_sema_arena_owned(slice))
 		return;
 
 	unsigned i;
@@ -571,7 +571,7 @@ void ofc_sema_array_slice_delete(
 			slice->segment[i].index);
 	}
 
-	free(slice);
+	ofc_sema_free(slice);
 }
 
 bool ofc_sema_array_slice_compare(
@@ -627,7 +627,7 @@ ofc_sema_array_t* ofc_sema_array_slice_dims(
 		return NULL;
 
 	ofc_sema_array_t* array
-		= (ofc_sema_array_t*)malloc(sizeof(ofc_sema_array_t)
+		= (ofc_sema_array_t*)ofc_sema_alloc(sizeof(ofc_sema_array_t)
 			+ (d * sizeof(ofc_sema_array_dims_t)));
 	if (!array) return NULL;
 
@@ -20,7 +20,7 @@ ofc_sema_common_t* ofc_sema_common_create(
 	ofc_str_ref_t name)
 {
 	ofc_sema_common_t* common
-		= (ofc_sema_common_t*)malloc(
+		= (ofc_sema_common_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_common_t));
 	if (!common) return NULL;
 
@@ -36,12 +36,12 @@ ofc_sema_common_t* ofc_sema_common_create(
 void ofc_sema_common_delete(
 	ofc_sema_common_t* common)
 {
-	if (!common)
+	if (!common || ofc_sema_arena_owned(common))
 		return;
 
-	free(common->decl);
-	free(common->spec);
-	free(common);
+	ofc_sema_free(common->decl);
+	ofc_sema_free(common->spec);
+	ofc_sema_free(common);
 }
 
 bool ofc_sema_common_add(
@@ -52,13 +52,13 @@ bool ofc_sema_common_add(
 		return false;
 
 	const ofc_sema_decl_t** ndecl
-		= (const ofc_sema_decl_t**)realloc(common->decl,
+		= (const ofc_sema_decl_t**)ofc_sema_realloc(common->decl,
 			sizeof(const ofc_sema_decl_t*) * (common->count + 1));
 	if (!ndecl) return false;
 	common->decl = ndecl;
 
 	const ofc_sema_spec_t** nspec
-		= (const ofc_sema_spec_t**)realloc(common->spec,
+		= (const ofc_sema_spec_t**)ofc_sema_realloc(common->spec,
 			sizeof(const ofc_sema_spec_t*) * (common->count + 1));
 	if (!nspec) return false;
 	common->spec = nspec;
@@ -118,7 +118,7 @@ ofc_sema_common_map_t* ofc_sema_common_map_create(
 	bool case_sensitive)
 {
 	ofc_sema_common_map_t* map
-		= (ofc_sema_common_map_t*)malloc(
+		= (ofc_sema_common_map_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_common_map_t));
 	if (!map) return NULL;
 
@@ -131,9 +131,10 @@ ofc_sema_common_map_t* ofc_sema_common_map_create(
 			: ofc_str_ref_ptr_equal_ci),
 		(void*)ofc_sema_common__key, NULL);
 
-	if (!map->map)
+	if (!ofc_sema_arena_hashmap(map, map->map))
 	{
-		free(map);
+		ofc_hashmap_delete(map->map);
+		ofc_sema_free(map);
 		return NULL;
 	}
 
@@ -146,16 +147,16 @@ ofc_sema_common_map_t* ofc_sema_common_map_create(
 void ofc_sema_common_map_delete(
 	ofc_sema_common_map_t* map)
 {
-	if (!map)
+	if (!map || ofc_sema_arena_owned(map))
 		return;
 
 	unsigned i;
 	for (i = 0; i < map->count; i++)
 		ofc_sema_common_delete(map->common[i]);
-	free(map->common);
+	ofc_sema_free(map->common);
 
 	ofc_hashmap_delete(map->map);
-	free(map);
+	ofc_sema_free(map);
 }
 
 ofc_sema_common_t* ofc_sema_common_map_find_modify(
@@ -179,7 +180,7 @@ bool ofc_sema_common_map_add(
 		return false;
 
 	ofc_sema_common_t** ncommon
-		= (ofc_sema_common_t**)realloc(map->common,
+		= (ofc_sema_common_t**)ofc_sema_realloc(map->common,
 			(sizeof(ofc_sema_common_t*) * (map->count + 1)));
 	if (!ncommon) return false;
 	map->common = ncommon;
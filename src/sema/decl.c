@@ -21,7 +21,7 @@ ofc_sema_decl_t* ofc_sema_decl_create(
 	ofc_str_ref_t name)
 {
 	ofc_sema_decl_t* decl
-		= (ofc_sema_decl_t*)malloc(
+		= (ofc_sema_decl_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_decl_t));
 	if (!decl) return NULL;
 
@@ -553,7 +553,7 @@ bool ofc_sema_decl(
 void ofc_sema_decl_delete(
 	ofc_sema_decl_t* decl)
 {
-	if (!decl)
+	if (!decl || ofc_sema_arena_owned(decl))
 		return;
 
 	if (ofc_sema_decl_is_composite(decl)
@@ -566,7 +566,7 @@ void ofc_sema_decl_delete(
 		for (i = 0; i < count; i++)
 			ofc_sema_typeval_delete(decl->init_array[i]);
 
-		free(decl->init_array);
+		ofc_sema_free(decl->init_array);
 	}
 	else
 	{
@@ -575,7 +575,7 @@ void ofc_sema_decl_delete(
 
 	ofc_sema_scope_delete(decl->func);
 	ofc_sema_equiv_delete(decl->equiv);
-	free(decl);
+	ofc_sema_free(decl);
 }
 
 
@@ -613,8 +613,8 @@ bool ofc_sema_decl_init(
 	}
 
 	ofc_sema_typeval_t* tv
-		= ofc_sema_typeval_cast(
-			scope, ctv, decl->type);
+		= ofc_sema_expr_cast_constant(
+			scope, init, decl->type);
 	if (!tv) return false;
 
 	if (decl->init)
@@ -696,7 +696,7 @@ bool ofc_sema_decl_init_offset(
 
 	if (!decl->init_array)
 	{
-		decl->init_array = (ofc_sema_typeval_t**)malloc(
+		decl->init_array = (ofc_sema_typeval_t**)ofc_sema_alloc(
 			sizeof(ofc_sema_typeval_t*) * elem_count);
 		if (!decl->init_array) return false;
 
@@ -714,8 +714,8 @@ bool ofc_sema_decl_init_offset(
 		return false;
 	}
 
-	ofc_sema_typeval_t* tv = ofc_sema_typeval_cast(
-		scope, ctv, ofc_sema_type_base(decl->type));
+	ofc_sema_typeval_t* tv = ofc_sema_expr_cast_constant(
+		scope, init, ofc_sema_type_base(decl->type));
 	if (!tv) return false;
 
 	if (decl->init_array[offset])
@@ -793,7 +793,7 @@ bool ofc_sema_decl_init_array(
 
 	if (!decl->init_array)
 	{
-		decl->init_array = (ofc_sema_typeval_t**)malloc(
+		decl->init_array = (ofc_sema_typeval_t**)ofc_sema_alloc(
 			sizeof(ofc_sema_typeval_t*) * elem_count);
 		if (!decl->init_array) return false;
 
@@ -823,8 +823,8 @@ bool ofc_sema_decl_init_array(
 				return false;
 			}
 
-			ofc_sema_typeval_t* tv = ofc_sema_typeval_cast(
-				scope, ctv, ofc_sema_type_base(decl->type));
+			ofc_sema_typeval_t* tv = ofc_sema_expr_cast_constant(
+				scope, init[i], ofc_sema_type_base(decl->type));
 			if (!tv) return false;
 
 			if (decl->init_array[i])
@@ -979,7 +979,7 @@ ofc_sema_decl_list_t* ofc_sema_decl_list__create(
 	bool case_sensitive, bool is_ref)
 {
 	ofc_sema_decl_list_t* list
-		= (ofc_sema_decl_list_t*)malloc(
+		= (ofc_sema_decl_list_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_decl_list_t));
 	if (!list) return NULL;
 
@@ -997,9 +997,10 @@ ofc_sema_decl_list_t* ofc_sema_decl_list__create(
 			? ofc_str_ref_ptr_equal
 			: ofc_str_ref_ptr_equal_ci),
 		(void*)ofc_sema_decl__key, NULL);
-	if (!list->map)
+	if (!ofc_sema_arena_hashmap(list, list->map))
 	{
-		free(list);
+		ofc_hashmap_delete(list->map);
+		ofc_sema_free(list);
 		return NULL;
 	}
 
@@ -1023,7 +1024,7 @@ ofc_sema_decl_list_t* ofc_sema_decl_list_create_ref(
 void ofc_sema_decl_list_delete(
 	ofc_sema_decl_list_t* list)
 {
-	if (!list)
+	if (!list || ofc_sema_arena_owned(list))
 		return;
 
 	ofc_hashmap_delete(list->map);
@@ -1035,9 +1036,9 @@ void ofc_sema_decl_list_delete(
 			ofc_sema_decl_delete(list->decl[i]);
 	}
 
-	free(list->decl);
+	ofc_sema_free(list->decl);
 
-	free(list);
+	ofc_sema_free(list);
 }
 
 bool ofc_sema_decl_list_add(
@@ -1054,7 +1055,7 @@ bool ofc_sema_decl_list_add(
 		return false;
 
 	ofc_sema_decl_t** ndecl
-		= (ofc_sema_decl_t**)realloc(list->decl,
+		= (ofc_sema_decl_t**)ofc_sema_realloc(list->decl,
 			(sizeof(ofc_sema_decl_t*) * (list->count + 1)));
 	if (!ndecl) return false;
 	list->decl = ndecl;
@@ -1081,7 +1082,7 @@ bool ofc_sema_decl_list_add_ref(
 		return false;
 
 	const ofc_sema_decl_t** ndecl
-		= (const ofc_sema_decl_t**)realloc(list->decl_ref,
+		= (const ofc_sema_decl_t**)ofc_sema_realloc(list->decl_ref,
 			(sizeof(const ofc_sema_decl_t*) * (list->count + 1)));
 	if (!ndecl) return false;
 	list->decl_ref = ndecl;
@@ -16,12 +16,11 @@
 #include <ofc/sema.h>
 
 
-static uint8_t ofc_sema_equiv__hash(const ofc_sema_decl_t* decl)
+static unsigned ofc_sema_equiv__hash(const ofc_sema_decl_t* decl)
 {
-	uintptr_t hash = (uintptr_t)decl;
-	hash ^= (hash >> 16);
-	hash ^= (hash >>  8);
-	return (uint8_t)(hash & 0xFF);
+	uint64_t hash = (uintptr_t)decl;
+	hash ^= (hash >> 32);
+	return (unsigned)hash;
 }
 
 static bool ofc_sema_equiv__equal(
@@ -40,7 +39,7 @@ static void* ofc_sema_equiv__key(
 static ofc_sema_equiv_t* ofc_sema_equiv__create(void)
 {
 	ofc_sema_equiv_t* equiv
-		= (ofc_sema_equiv_t*)malloc(
+		= (ofc_sema_equiv_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_equiv_t));
 	if (!equiv) return NULL;
 
@@ -48,7 +47,7 @@ static ofc_sema_equiv_t* ofc_sema_equiv__create(void)
 	equiv->lhs = NULL;
 	if (!equiv->lhs)
 	{
-		free(equiv);
+		ofc_sema_free(equiv);
 		return NULL;
 	}
 
@@ -56,9 +55,10 @@ static ofc_sema_equiv_t* ofc_sema_equiv__create(void)
 		(void*)ofc_sema_equiv__hash,
 		(void*)ofc_sema_equiv__equal,
 		(void*)ofc_sema_equiv__key, NULL);
-	if (!equiv->map)
+	if (!ofc_sema_arena_hashmap(equiv, equiv->map))
 	{
-		free(equiv);
+		ofc_hashmap_delete(equiv->map);
+		ofc_sema_free(equiv);
 		return NULL;
 	}
 
@@ -88,7 +88,7 @@ static bool ofc_sema_equiv__add(
 		return false;
 
 	ofc_sema_lhs_t** nlhs
-		= (ofc_sema_lhs_t**)realloc(equiv->lhs,
+		= (ofc_sema_lhs_t**)ofc_sema_realloc(equiv->lhs,
 			(sizeof(ofc_sema_lhs_t*) * (equiv->count + 1)));
 	if (!nlhs)
 	{
@@ -269,7 +269,7 @@ bool ofc_sema_equiv(
 void ofc_sema_equiv_delete(
 	ofc_sema_equiv_t* equiv)
 {
-	if (!equiv)
+	if (!equiv || ofc_sema_arena_owned(equiv))
 		return;
 
 	if (equiv->refcnt > 0)
@@ -283,7 +283,7 @@ void ofc_sema_equiv_delete(
 	unsigned i;
 	for (i = 0; i < equiv->count; i++)
 		ofc_sema_lhs_delete(equiv->lhs[i]);
-	free(equiv->lhs);
+	ofc_sema_free(equiv->lhs);
 
-	free(equiv);
+	ofc_sema_free(equiv);
 }
@@ -184,7 +184,7 @@ static ofc_sema_expr_t* ofc_sema_expr__create(
 		return NULL;
 
 	ofc_sema_expr_t* expr
-		= (ofc_sema_expr_t*)malloc(
+		= (ofc_sema_expr_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_expr_t));
 	if (!expr) return NULL;
 
@@ -199,6 +199,7 @@ static ofc_sema_expr_t* ofc_sema_expr__create(
 	switch (type)
 	{
 		case OFC_SEMA_EXPR_CONSTANT:
+			expr->literal = NULL;
 			break;
 		case OFC_SEMA_EXPR_LHS:
 			expr->lhs = NULL;
@@ -250,6 +251,37 @@ static ofc_sema_expr_e ofc_sema_expr__binary_map[] =
 	OFC_SEMA_EXPR_NEQV,
 };
 
+/* BOZ literals and Holleriths are the storage of a REAL rather
+   than its value, so they're converted from the literal itself. */
+ofc_sema_typeval_t* ofc_sema_expr_cast_constant(
+	const ofc_sema_scope_t* scope,
+	const ofc_sema_expr_t* expr,
+	const ofc_sema_type_t* type)
+{
+	if (!expr || !type)
+		return NULL;
+
+	if ((expr->type == OFC_SEMA_EXPR_CONSTANT)
+		&& expr->literal
+		&& (type->type == OFC_SEMA_TYPE_REAL))
+	{
+		switch (expr->literal->type)
+		{
+			case OFC_PARSE_LITERAL_BINARY:
+			case OFC_PARSE_LITERAL_OCTAL:
+			case OFC_PARSE_LITERAL_HEX:
+			case OFC_PARSE_LITERAL_HOLLERITH:
+				return ofc_sema_typeval_literal(
+					scope, expr->literal, type);
+			default:
+				break;
+		}
+	}
+
+	return ofc_sema_typeval_cast(
+		scope, expr->constant, type);
+}
+
 ofc_sema_expr_t* ofc_sema_expr_cast(
 	const ofc_sema_scope_t* scope,
 	ofc_sema_expr_t* expr,
@@ -265,8 +297,8 @@ ofc_sema_expr_t* ofc_sema_expr_cast(
 
 	if (ofc_sema_expr_is_constant(expr))
 	{
-		cast->constant = ofc_sema_typeval_cast(
-			scope, expr->constant, type);
+		cast->constant = ofc_sema_expr_cast_constant(
+			scope, expr, type);
 		if (!cast->constant)
 		{
 			ofc_sema_expr_delete(cast);
@@ -519,6 +551,7 @@ static ofc_sema_expr_t* ofc_sema_expr__literal(
 	}
 
 	expr->constant = tv;
+	expr->literal  = literal;
 	expr->src = literal->src;
 	return expr;
 }
@@ -896,7 +929,7 @@ ofc_sema_expr_t* ofc_sema_expr_brackets(
 void ofc_sema_expr_delete(
 	ofc_sema_expr_t* expr)
 {
-	if (!expr)
+	if (!expr || ofc_sema_arena_owned(expr))
 		return;
 
 	ofc_sema_typeval_delete(
@@ -925,7 +958,7 @@ void ofc_sema_expr_delete(
 			break;
 	}
 
-	free(expr);
+	ofc_sema_free(expr);
 }
 
 
@@ -1114,7 +1147,7 @@ ofc_sema_expr_list_t* ofc_sema_expr_list(
 ofc_sema_expr_list_t* ofc_sema_expr_list_create(void)
 {
 	ofc_sema_expr_list_t* list
-		= (ofc_sema_expr_list_t*)malloc(
+		= (ofc_sema_expr_list_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_expr_list_t));
 	if (!list) return NULL;
 
@@ -1126,15 +1159,15 @@ ofc_sema_expr_list_t* ofc_sema_expr_list_create(void)
 void ofc_sema_expr_list_delete(
 	ofc_sema_expr_list_t* list)
 {
-	if (!list)
+	if (!list || ofc_sema_arena_owned(list))
 		return;
 
 	unsigned i;
 	for (i = 0; i < list->count; i++)
 		ofc_sema_expr_delete(list->expr[i]);
-	free(list->expr);
+	ofc_sema_free(list->expr);
 
-	free(list);
+	ofc_sema_free(list);
 }
 
 bool ofc_sema_expr_list_add(
@@ -1145,7 +1178,7 @@ bool ofc_sema_expr_list_add(
 		return false;
 
 	ofc_sema_expr_t** nexpr
-		= (ofc_sema_expr_t**)realloc(list->expr,
+		= (ofc_sema_expr_t**)ofc_sema_realloc(list->expr,
 			(sizeof(ofc_sema_expr_t*) * (list->count + 1)));
 	if (!nexpr) return NULL;
 
@@ -105,7 +105,7 @@ static ofc_sema_format_t* ofc_sema_format__create(
 	const ofc_parse_format_desc_list_t* src)
 {
 	ofc_sema_format_t* format
-		= (ofc_sema_format_t*)malloc(
+		= (ofc_sema_format_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_format_t));
 	if (!format) return NULL;
 
@@ -165,12 +165,12 @@ bool ofc_sema_format_print(ofc_colstr_t* cs,
 void ofc_sema_format_delete(
 	ofc_sema_format_t* format)
 {
-	if (!format)
+	if (!format || ofc_sema_arena_owned(format))
 		return;
 
 	ofc_parse_format_desc_list_delete(
 		format->format);
-	free(format);
+	ofc_sema_free(format);
 }
 
 const ofc_sema_type_t* ofc_sema_format_desc_type(
@@ -25,7 +25,7 @@ struct ofc_sema_implicit_s
 ofc_sema_implicit_t* ofc_sema_implicit_create(void)
 {
 	ofc_sema_implicit_t* implicit
-		= (ofc_sema_implicit_t*)malloc(
+		= (ofc_sema_implicit_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_implicit_t));
 	if (!implicit) return NULL;
 
@@ -60,7 +60,7 @@ ofc_sema_implicit_t* ofc_sema_implicit_copy(
 		return NULL;
 
 	ofc_sema_implicit_t* copy
-		= (ofc_sema_implicit_t*)malloc(
+		= (ofc_sema_implicit_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_implicit_t));
 	if (!copy) return NULL;
 
@@ -146,7 +146,7 @@ ofc_sema_spec_t* ofc_sema_implicit_apply(
 void ofc_sema_implicit_delete(
 	ofc_sema_implicit_t* implicit)
 {
-	free(implicit);
+	ofc_sema_free(implicit);
 }
 
 
@@ -14,6 +14,7 @@
  */
 
 #include <ofc/sema.h>
+#include <pthread.h>
 
 typedef enum
 {
@@ -191,7 +192,8 @@ static ofc_sema_intrinsic_t* ofc_sema_intrinsic__create_op(
 			sizeof(ofc_sema_intrinsic_t));
 	if (!intrinsic) return NULL;
 
-	intrinsic->name = ofc_str_ref_from_strz(op->name);
+	intrinsic->name = ofc_str_ref_intern(
+		op->name, strlen(op->name));
 	intrinsic->is_op = true;
 	intrinsic->op = op;
 
@@ -222,11 +224,8 @@ static void ofc_sema_intrinsic__term(void)
 	ofc_hashmap_delete(ofc_sema_intrinsic__map);
 }
 
-static bool ofc_sema_intrinsic__init(void)
+static void ofc_sema_intrinsic__init_once(void)
 {
-	if (ofc_sema_intrinsic__map)
-		return true;
-
 	/* TODO - Set case sensitivity based on lang_opts? */
 	ofc_sema_intrinsic__map = ofc_hashmap_create(
 		(void*)ofc_str_ref_ptr_hash_ci,
@@ -234,7 +233,7 @@ static bool ofc_sema_intrinsic__init(void)
 		(void*)ofc_sema_intrinsic__key,
 		(void*)ofc_sema_intrinsic__delete);
 	if (!ofc_sema_intrinsic__map)
-		return false;
+		return;
 
 	unsigned i;
 	for (i = 0; ofc_sema_intrinsic__op_list[i].name; i++)
@@ -247,7 +246,7 @@ static bool ofc_sema_intrinsic__init(void)
 			ofc_hashmap_delete(
 				ofc_sema_intrinsic__map);
 			ofc_sema_intrinsic__map = NULL;
-			return false;
+			return;
 		}
 
 		if (!ofc_hashmap_add(
@@ -258,12 +257,20 @@ static bool ofc_sema_intrinsic__init(void)
 			ofc_hashmap_delete(
 				ofc_sema_intrinsic__map);
 			ofc_sema_intrinsic__map = NULL;
-			return false;
+			return;
 		}
 	}
 
 	atexit(ofc_sema_intrinsic__term);
-	return true;
+}
+
+static pthread_once_t ofc_sema_intrinsic__once = PTHREAD_ONCE_INIT;
+
+static bool ofc_sema_intrinsic__init(void)
+{
+	pthread_once(&ofc_sema_intrinsic__once,
+		ofc_sema_intrinsic__init_once);
+	return (ofc_sema_intrinsic__map != NULL);
 }
 
 
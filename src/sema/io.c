@@ -209,7 +209,7 @@ static bool ofc_sema_io__data_format_helper(
 			for (i = 0; i < desc->n; i++)
 			{
 				ofc_parse_format_desc_t** ndesc
-					= (ofc_parse_format_desc_t**)realloc(format_list->desc,
+					= (ofc_parse_format_desc_t**)ofc_parse_realloc(format_list->desc,
 						(sizeof(ofc_parse_format_desc_t*) * (format_list->count + 1)));
 				if (!ndesc) return false;
 
@@ -264,7 +264,7 @@ ofc_parse_format_desc_list_t* ofc_sema_io_data_format(
 	if (!format) return NULL;
 
 	ofc_parse_format_desc_list_t* format_list
-		= (ofc_parse_format_desc_list_t*)malloc(
+		= (ofc_parse_format_desc_list_t*)ofc_parse_alloc(
 			sizeof(ofc_parse_format_desc_list_t));
 	if (!format_list) return NULL;
 
@@ -18,20 +18,20 @@
 static void ofc_sema_label__delete(
 	ofc_sema_label_t* label)
 {
-	if (!label)
+	if (!label || ofc_sema_arena_owned(label))
 		return;
 
 	if (label->type == OFC_SEMA_LABEL_FORMAT)
 		ofc_sema_format_delete(label->format);
 
-	free(label);
+	ofc_sema_free(label);
 }
 
 static ofc_sema_label_t* ofc_sema_label__stmt(
 	unsigned number, unsigned offset)
 {
 	ofc_sema_label_t* label
-		= (ofc_sema_label_t*)malloc(
+		= (ofc_sema_label_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_label_t));
 	if (!label) return NULL;
 
@@ -49,7 +49,7 @@ static ofc_sema_label_t* ofc_sema_label__format(
 		return NULL;
 
 	ofc_sema_label_t* label
-		= (ofc_sema_label_t*)malloc(
+		= (ofc_sema_label_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_label_t));
 	if (!label) return NULL;
 
@@ -80,30 +80,20 @@ static bool ofc_sema_label__compare(
 	return (*a == *b);
 }
 
-static uint8_t ofc_sema_label__hash(const unsigned* label)
+static unsigned ofc_sema_label__hash(const unsigned* label)
 {
-	if (!label)
-		return 0;
-
-	unsigned h = *label;
-	h ^= (h >> (sizeof(h) * 4));
-	h ^= (h >> (sizeof(h) * 2));
-
-	return (h & 0xFF);
+	return (label ? *label : 0);
 }
 
-static uint8_t ofc_sema_label_offset__hash(const unsigned* offset)
+static unsigned ofc_sema_label_offset__hash(const unsigned* offset)
 {
-	if (!offset)
-		return 0;
-
-	return (*offset & 0xFF);
+	return (offset ? *offset : 0);
 }
 
 ofc_sema_label_map_t* ofc_sema_label_map_create()
 {
 	ofc_sema_label_map_t* map
-		= (ofc_sema_label_map_t*)malloc(
+		= (ofc_sema_label_map_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_label_map_t));
 	if (!map) return NULL;
 
@@ -121,8 +111,8 @@ ofc_sema_label_map_t* ofc_sema_label_map_create()
 
 	map->format = ofc_sema_format_label_list_create();
 
-	if (!map->label
-		|| !map->offset
+	if (!ofc_sema_arena_hashmap(map, map->label)
+		|| !ofc_sema_arena_hashmap(map, map->offset)
 		|| !map->format)
 	{
 		ofc_sema_label_map_delete(map);
@@ -135,13 +125,14 @@ ofc_sema_label_map_t* ofc_sema_label_map_create()
 void ofc_sema_label_map_delete(
 	ofc_sema_label_map_t* map)
 {
-	if (!map) return;
+	if (!map || ofc_sema_arena_owned(map))
+		return;
 
 	ofc_sema_format_label_list_delete(map->format);
 	ofc_hashmap_delete(map->offset);
 	ofc_hashmap_delete(map->label);
 
-	free(map);
+	ofc_sema_free(map);
 }
 
 bool ofc_sema_label_map_add_stmt(
@@ -220,7 +211,7 @@ bool ofc_sema_label_map_add_format(
 		map->format, l))
 	{
 		/* Don't delete because we don't yet own format. */
-		free(l);
+		ofc_sema_free(l);
 		return false;
 	}
 
@@ -255,7 +246,7 @@ ofc_sema_format_label_list_t*
 	ofc_sema_format_label_list_create(void)
 {
 	ofc_sema_format_label_list_t* list
-		= (ofc_sema_format_label_list_t*)malloc(
+		= (ofc_sema_format_label_list_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_format_label_list_t));
 	if (!list) return NULL;
 
@@ -268,17 +259,18 @@ ofc_sema_format_label_list_t*
 void ofc_sema_format_label_list_delete(
 	ofc_sema_format_label_list_t* list)
 {
-	if (!list) return;
+	if (!list || ofc_sema_arena_owned(list))
+		return;
 
 	if (list->format)
 	{
 		unsigned i;
 		for (i = 0; i < list->count; i++)
 			ofc_sema_label__delete(list->format[i]);
-		free(list->format);
+		ofc_sema_free(list->format);
 	}
 
-	free(list);
+	ofc_sema_free(list);
 }
 
 bool ofc_sema_format_label_list_add(
@@ -288,7 +280,7 @@ bool ofc_sema_format_label_list_add(
 	if (!list || !format) return false;
 
 	ofc_sema_label_t** nformat
-		= (ofc_sema_label_t**)realloc(list->format,
+		= (ofc_sema_label_t**)ofc_sema_realloc(list->format,
 			(sizeof(ofc_sema_label_t*) * (list->count + 1)));
 	if (!nformat) return false;
 	list->format = nformat;
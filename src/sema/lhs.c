@@ -24,7 +24,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs_index(
 		return NULL;
 
 	ofc_sema_lhs_t* alhs
-		= (ofc_sema_lhs_t*)malloc(
+		= (ofc_sema_lhs_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_lhs_t));
 	if (!alhs) return NULL;
 
@@ -62,7 +62,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs_slice(
 	}
 
 	ofc_sema_lhs_t* alhs
-		= (ofc_sema_lhs_t*)malloc(
+		= (ofc_sema_lhs_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_lhs_t));
 	if (!alhs) return NULL;
 
@@ -199,7 +199,7 @@ static ofc_sema_lhs_t* ofc_sema_lhs_substring(
 	}
 
 	ofc_sema_lhs_t* alhs
-		= (ofc_sema_lhs_t*)malloc(
+		= (ofc_sema_lhs_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_lhs_t));
 	if (!alhs) return NULL;
 
@@ -425,7 +425,7 @@ static ofc_sema_lhs_t* ofc_sema__lhs(
 	}
 
 	ofc_sema_lhs_t* slhs
-		= (ofc_sema_lhs_t*)malloc(
+		= (ofc_sema_lhs_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_lhs_t));
 	if (!slhs) return NULL;
 
@@ -488,7 +488,7 @@ bool ofc_sema_lhs_reference(
 void ofc_sema_lhs_delete(
 	ofc_sema_lhs_t* lhs)
 {
-	if (!lhs)
+	if (!lhs || ofc_sema_arena_owned(lhs))
 		return;
 
 	if (lhs->refcnt > 0)
@@ -530,7 +530,7 @@ void ofc_sema_lhs_delete(
 			break;
 	}
 
-	free(lhs);
+	ofc_sema_free(lhs);
 }
 
 
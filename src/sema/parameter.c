@@ -36,7 +36,7 @@ ofc_sema_parameter_t* ofc_sema_parameter_create(
 	ofc_sema_typeval_t* typeval)
 {
 	ofc_sema_parameter_t* parameter
-		= (ofc_sema_parameter_t*)malloc(
+		= (ofc_sema_parameter_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_parameter_t));
 	if (!parameter) return NULL;
 
@@ -149,11 +149,11 @@ bool ofc_sema_parameter_decl(
 void ofc_sema_parameter_delete(
 	ofc_sema_parameter_t* parameter)
 {
-	if (!parameter)
+	if (!parameter || ofc_sema_arena_owned(parameter))
 		return;
 
 	ofc_sema_typeval_delete(parameter->typeval);
-	free(parameter);
+	ofc_sema_free(parameter);
 }
 
 
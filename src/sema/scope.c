@@ -22,6 +22,20 @@ void ofc_sema_scope_delete(
 	if (!scope)
 		return;
 
+	/* The global scope releases the whole tree at once. */
+	if (scope->arena)
+	{
+		ofc_arena_t* arena = scope->arena;
+		scope->arena = NULL;
+
+		ofc_sema_scope_delete(scope);
+		ofc_arena_delete(arena);
+		return;
+	}
+
+	if (ofc_sema_arena_owned(scope))
+		return;
+
 	ofc_sema_scope_list_delete(
 		scope->child);
 
@@ -51,7 +65,7 @@ void ofc_sema_scope_delete(
 			break;
 	}
 
-	free(scope);
+	ofc_sema_free(scope);
 }
 
 static bool ofc_sema_scope__add_child(
@@ -82,12 +96,13 @@ static ofc_sema_scope_t* ofc_sema_scope__create(
 	ofc_sema_scope_e       type)
 {
 	ofc_sema_scope_t* scope
-		= (ofc_sema_scope_t*)malloc(
+		= (ofc_sema_scope_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_scope_t));
 	if (!scope) return NULL;
 
 	scope->parent = parent;
 	scope->child  = NULL;
+	scope->arena  = NULL;
 
 	scope->lang_opts = lang_opts;
 	if (!scope->lang_opts && parent)
@@ -135,7 +150,8 @@ static ofc_sema_scope_t* ofc_sema_scope__create(
 
 	if (!scope->implicit
 		|| !scope->decl
-		|| !scope->parameter)
+		|| !ofc_sema_arena_hashmap(scope, scope->spec)
+		|| !ofc_sema_arena_hashmap(scope, scope->parameter))
 	{
 		ofc_sema_scope_delete(scope);
 		return NULL;
@@ -560,19 +576,34 @@ ofc_sema_scope_t* ofc_sema_scope_global(
 	if (!list)
 		return NULL;
 
+	ofc_arena_t* arena = ofc_arena_create();
+	if (!arena) return NULL;
+
+	/* Parse nodes copied by sema belong to the tree too. */
+	ofc_arena_t* outer = ofc_sema_arena_swap(arena);
+	ofc_arena_t* parse = ofc_parse_arena_swap(arena);
+
 	ofc_sema_scope_t* scope
 		= ofc_sema_scope__create(
 			NULL, lang_opts, src, OFC_SEMA_SCOPE_GLOBAL);
-	if (!scope) return NULL;
-
-	scope->lang_opts = lang_opts;
+	if (scope)
+	{
+		scope->arena     = arena;
+		scope->lang_opts = lang_opts;
 
-	if (!ofc_sema_scope__body(scope, list))
+		if (!ofc_sema_scope__body(scope, list))
+		{
+			ofc_sema_scope_delete(scope);
+			scope = NULL;
+		}
+	}
+	else
 	{
-		ofc_sema_scope_delete(scope);
-		return NULL;
+		ofc_arena_delete(arena);
 	}
 
+	ofc_parse_arena_swap(parse);
+	ofc_sema_arena_swap(outer);
 	return scope;
 }
 
@@ -1084,7 +1115,7 @@ bool ofc_sema_scope_print(
 ofc_sema_scope_list_t* ofc_sema_scope_list_create()
 {
 	ofc_sema_scope_list_t* list
-		= (ofc_sema_scope_list_t*)malloc(
+		= (ofc_sema_scope_list_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_scope_list_t));
 	if (!list) return NULL;
 
@@ -1101,7 +1132,7 @@ bool ofc_sema_scope_list_add(
 	if (!list || !scope) return false;
 
 	ofc_sema_scope_t** nscope
-		= (ofc_sema_scope_t**)realloc(list->scope,
+		= (ofc_sema_scope_t**)ofc_sema_realloc(list->scope,
 			(sizeof(ofc_sema_scope_t*) * (list->count + 1)));
 	if (!nscope) return false;
 	list->scope = nscope;
@@ -1113,13 +1144,13 @@ bool ofc_sema_scope_list_add(
 void ofc_sema_scope_list_delete(
 	ofc_sema_scope_list_t* list)
 {
-	if (!list)
+	if (!list || ofc_sema_arena_owned(list))
 		return;
 
 	unsigned i;
 	for (i = 0; i < list->count; i++)
 		ofc_sema_scope_delete(list->scope[i]);
 
-	free(list->scope);
-	free(list);
+	ofc_sema_free(list->scope);
+	ofc_sema_free(list);
 }
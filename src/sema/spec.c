@@ -40,7 +40,7 @@ ofc_sema_spec_t* ofc_sema_spec_create(
 	ofc_str_ref_t name)
 {
 	ofc_sema_spec_t* spec
-		= (ofc_sema_spec_t*)malloc(
+		= (ofc_sema_spec_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_spec_t));
 	if (!spec) return NULL;
 
@@ -299,7 +299,7 @@ ofc_sema_spec_t* ofc_sema_spec(
 	s.is_volatile  = ptype->attr.is_volatile;
 
 	ofc_sema_spec_t* spec
-		= (ofc_sema_spec_t*)malloc(
+		= (ofc_sema_spec_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_spec_t));
 	if (!spec) return NULL;
 
@@ -324,7 +324,7 @@ ofc_sema_spec_t* ofc_sema_spec_copy(
 		copy->array = ofc_sema_array_copy(spec->array);
 		if (!copy->array)
 		{
-			free(copy);
+			ofc_sema_free(copy);
 			return NULL;
 		}
 	}
@@ -335,11 +335,11 @@ ofc_sema_spec_t* ofc_sema_spec_copy(
 void ofc_sema_spec_delete(
 	ofc_sema_spec_t* spec)
 {
-	if (!spec)
+	if (!spec || ofc_sema_arena_owned(spec))
 		return;
 
 	ofc_sema_array_delete(spec->array);
-	free(spec);
+	ofc_sema_free(spec);
 }
 
 
@@ -61,7 +61,7 @@ static ofc_sema_stmt_t* ofc_sema_stmt_simple(
 	}
 
 	ofc_sema_stmt_t* stmt
-		= (ofc_sema_stmt_t*)malloc(
+		= (ofc_sema_stmt_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_stmt_t));
 	if (!stmt) return NULL;
 
@@ -232,7 +232,7 @@ bool ofc_sema_stmt_scoped(
 void ofc_sema_stmt_delete(
 	ofc_sema_stmt_t* stmt)
 {
-	if (!stmt)
+	if (!stmt || ofc_sema_arena_owned(stmt))
 		return;
 
 	switch (stmt->type)
@@ -476,7 +476,7 @@ void ofc_sema_stmt_delete(
 			break;
 	}
 
-	free(stmt);
+	ofc_sema_free(stmt);
 }
 
 
@@ -484,7 +484,7 @@ void ofc_sema_stmt_delete(
 ofc_sema_stmt_list_t* ofc_sema_stmt_list_create(void)
 {
 	ofc_sema_stmt_list_t* list
-		= (ofc_sema_stmt_list_t*)malloc(
+		= (ofc_sema_stmt_list_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_stmt_list_t));
 	if (!list) return NULL;
 
@@ -497,7 +497,7 @@ ofc_sema_stmt_t* ofc_sema_stmt_alloc(
 	ofc_sema_stmt_t stmt)
 {
 	ofc_sema_stmt_t* astmt
-		= (ofc_sema_stmt_t*)malloc(
+		= (ofc_sema_stmt_t*)ofc_sema_alloc(
 			sizeof(ofc_sema_stmt_t));
 	if (!astmt) return NULL;
 
@@ -508,15 +508,15 @@ ofc_sema_stmt_t* ofc_sema_stmt_alloc(
 void ofc_sema_stmt_list_delete(
 	ofc_sema_stmt_list_t* list)
 {
-	if (!list)
+	if (!list || ofc_sema_arena_owned(list))
 		return;
 
 	unsigned i;
 	for (i = 0; i < list->count; i++)
 		ofc_sema_stmt_delete(list->stmt[i]);
-	free(list->stmt);
+	ofc_sema_free(list->stmt);
 
-	free(list);
+	ofc_sema_free(list);
 }
 
 bool ofc_sema_stmt_list_add(
@@ -527,7 +527,7 @@ bool ofc_sema_stmt_list_add(
 		return false;
 
 	ofc_sema_stmt_t** nstmt
-		= (ofc_sema_stmt_t**)realloc(list->stmt,
+		= (ofc_sema_stmt_t**)ofc_sema_realloc(list->stmt,
 			(sizeof(ofc_sema_stmt_t*) * (list->count + 1)));
 	if (!nstmt) return NULL;
 
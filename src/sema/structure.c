@@ -15,6 +15,7 @@
 
 #include <ofc/sema.h>
 #include <ofc/hashmap.h>
+#include <pthread.h>
 
 
 void ofc_sema_structure__delete_locked(ofc_sema_structure_t* structure)
@@ -100,6 +101,7 @@ const ofc_sema_structure_t* ofc_sema_structure__key(
 }
 
 ofc_hashmap_t* ofc_sema_structure__map = NULL;
+static pthread_mutex_t ofc_sema_structure__lock = PTHREAD_MUTEX_INITIALIZER;
 
 bool ofc_sema_structure_complete(
 	ofc_sema_structure_t* structure)
@@ -110,6 +112,8 @@ bool ofc_sema_structure_complete(
 	if (structure->locked)
 		return true;
 
+	pthread_mutex_lock(&ofc_sema_structure__lock);
+
 	if (!ofc_sema_structure__map)
 	{
 		ofc_sema_structure__map = ofc_hashmap_create(
@@ -118,12 +122,19 @@ bool ofc_sema_structure_complete(
 			(void*)ofc_sema_structure__key,
 			(void*)ofc_sema_structure__delete_locked);
 		if (!ofc_sema_structure__map)
+		{
+			pthread_mutex_unlock(&ofc_sema_structure__lock);
 			return false;
+		}
 	}
 
-	if (!ofc_hashmap_add(
+	bool added = ofc_hashmap_add(
 		ofc_sema_structure__map,
-		structure))
+		structure);
+
+	pthread_mutex_unlock(&ofc_sema_structure__lock);
+
+	if (!added)
 		return false;
 
 	structure->locked = true;
@@ -131,13 +142,13 @@ bool ofc_sema_structure_complete(
 }
 
 
-uint8_t ofc_sema_structure_hash(
+unsigned ofc_sema_structure_hash(
 	const ofc_sema_structure_t* structure)
 {
 	if (!structure)
 		return 0;
 
-	uint8_t hash = (structure->is_vax
+	unsigned hash = (structure->is_vax
 		+ structure->is_union);
 
 	unsigned i;
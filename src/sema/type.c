@@ -15,8 +15,20 @@
 
 #include <ofc/sema.h>
 #include <string.h>
+#include <pthread.h>
 
-static ofc_hashmap_t* ofc_sema_type__map = NULL;
+/* Types are interned process wide, the table is split into shards
+   each with their own lock so that scopes can be analysed in parallel. */
+#define OFC_SEMA_TYPE__SHARD_COUNT 16
+
+static struct
+{
+	pthread_mutex_t lock;
+	ofc_hashmap_t*  map;
+} ofc_sema_type__shard[OFC_SEMA_TYPE__SHARD_COUNT];
+
+static pthread_once_t ofc_sema_type__shard_once = PTHREAD_ONCE_INIT;
+static bool           ofc_sema_type__shard_ready = false;
 
 static const char* ofc_sema_type__name[] =
 {
@@ -80,13 +92,13 @@ static void ofc_sema_type__delete(ofc_sema_type_t* type)
 	free(type);
 }
 
-uint8_t ofc_sema_type_hash(
+unsigned ofc_sema_type_hash(
 	const ofc_sema_type_t* type)
 {
 	if (!type)
 		return 0;
 
-	uint8_t hash = type->type;
+	unsigned hash = type->type;
 
 	hash += ofc_sema_array_hash(type->array);
 
@@ -125,9 +137,41 @@ static const ofc_sema_type_t* ofc_sema_type__key(
 	return type;
 }
 
-static void ofc_sema_type__map_cleanup(void)
+static void ofc_sema_type__shard_cleanup(void)
 {
-	ofc_hashmap_delete(ofc_sema_type__map);
+	unsigned i;
+	for (i = 0; i < OFC_SEMA_TYPE__SHARD_COUNT; i++)
+	{
+		ofc_hashmap_delete(ofc_sema_type__shard[i].map);
+		pthread_mutex_destroy(&ofc_sema_type__shard[i].lock);
+	}
+}
+
+static void ofc_sema_type__shard_init(void)
+{
+	unsigned i;
+	for (i = 0; i < OFC_SEMA_TYPE__SHARD_COUNT; i++)
+	{
+		ofc_sema_type__shard[i].map = ofc_hashmap_create(
+			(void*)ofc_sema_type_hash,
+			(void*)ofc_sema_type_compare,
+			(void*)ofc_sema_type__key,
+			(void*)ofc_sema_type__delete);
+		if (!ofc_sema_type__shard[i].map
+			|| (pthread_mutex_init(&ofc_sema_type__shard[i].lock, NULL) != 0))
+		{
+			ofc_hashmap_delete(ofc_sema_type__shard[i].map);
+			while (i-- > 0)
+			{
+				ofc_hashmap_delete(ofc_sema_type__shard[i].map);
+				pthread_mutex_destroy(&ofc_sema_type__shard[i].lock);
+			}
+			return;
+		}
+	}
+
+	ofc_sema_type__shard_ready = true;
+	atexit(ofc_sema_type__shard_cleanup);
 }
 
 static const ofc_sema_type_t* ofc_sema_type__create(
@@ -183,18 +227,10 @@ static const ofc_sema_type_t* ofc_sema_type__create(
 			break;
 	}
 
-	if (!ofc_sema_type__map)
-	{
-		ofc_sema_type__map = ofc_hashmap_create(
-			(void*)ofc_sema_type_hash,
-			(void*)ofc_sema_type_compare,
-			(void*)ofc_sema_type__key,
-			(void*)ofc_sema_type__delete);
-		if (!ofc_sema_type__map)
-			return NULL;
-
-		atexit(ofc_sema_type__map_cleanup);
-	}
+	pthread_once(&ofc_sema_type__shard_once,
+		ofc_sema_type__shard_init);
+	if (!ofc_sema_type__shard_ready)
+		return NULL;
 
 	ofc_sema_type_t stype =
 		{
@@ -204,7 +240,10 @@ static const ofc_sema_type_t* ofc_sema_type__create(
 
 	if (array)
 	{
+		/* Types outlive any one scope tree, so can't use its arena. */
+		ofc_arena_t* arena = ofc_sema_arena_swap(NULL);
 		stype.array = ofc_sema_array_copy(array);
+		ofc_sema_arena_swap(arena);
 		if (!stype.array) return NULL;
 	}
 
@@ -228,11 +267,21 @@ static const ofc_sema_type_t* ofc_sema_type__create(
 		&& (stype.kind == 1))
 		stype.type = OFC_SEMA_TYPE_BYTE;
 
+	/* The hash only depends on the type's value, so equal types
+	   always meet in the same shard. */
+	unsigned hash = ofc_sema_type_hash(&stype);
+	pthread_mutex_t* lock = &ofc_sema_type__shard[
+		hash % OFC_SEMA_TYPE__SHARD_COUNT].lock;
+	ofc_hashmap_t* map = ofc_sema_type__shard[
+		hash % OFC_SEMA_TYPE__SHARD_COUNT].map;
+
+	pthread_mutex_lock(lock);
+
 	const ofc_sema_type_t* gtype
-		= ofc_hashmap_find(
-			ofc_sema_type__map, &stype);
+		= ofc_hashmap_find(map, &stype);
 	if (gtype)
 	{
+		pthread_mutex_unlock(lock);
 		ofc_sema_array_delete(stype.array);
 		return gtype;
 	}
@@ -242,18 +291,20 @@ static const ofc_sema_type_t* ofc_sema_type__create(
 			sizeof(ofc_sema_type_t));
 	if (!ntype)
 	{
+		pthread_mutex_unlock(lock);
 		ofc_sema_array_delete(stype.array);
 		return NULL;
 	}
 	*ntype = stype;
 
-	if (!ofc_hashmap_add(
-		ofc_sema_type__map, ntype))
+	if (!ofc_hashmap_add(map, ntype))
 	{
+		pthread_mutex_unlock(lock);
 		ofc_sema_type__delete(ntype);
 		return NULL;
 	}
 
+	pthread_mutex_unlock(lock);
 	return ntype;
 }
 
@@ -380,100 +431,89 @@ const ofc_sema_type_t* ofc_sema_type_star_len(
 }
 
 
-const ofc_sema_type_t* ofc_sema_type_logical_default(void)
+/* The defaults are created together, once, on first use. */
+static struct
 {
-	static const ofc_sema_type_t* logical = NULL;
+	const ofc_sema_type_t* logical;
+	const ofc_sema_type_t* integer;
+	const ofc_sema_type_t* real;
+	const ofc_sema_type_t* dbl;
+	const ofc_sema_type_t* complex;
+	const ofc_sema_type_t* byte;
+	const ofc_sema_type_t* subroutine;
+} ofc_sema_type__default;
 
-	if (!logical)
+static pthread_once_t ofc_sema_type__default_once = PTHREAD_ONCE_INIT;
+
+static void ofc_sema_type__default_init(void)
+{
+	ofc_sema_type__default.logical = ofc_sema_type_create_primitive(
+		OFC_SEMA_TYPE_LOGICAL, 0);
+	ofc_sema_type__default.integer = ofc_sema_type_create_primitive(
+		OFC_SEMA_TYPE_INTEGER, 0);
+	ofc_sema_type__default.real = ofc_sema_type_create_primitive(
+		OFC_SEMA_TYPE_REAL, 0);
+	if (ofc_sema_type__default.real)
 	{
-		logical = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_LOGICAL, 0);
+		ofc_sema_type__default.dbl = ofc_sema_type_create_primitive(
+			OFC_SEMA_TYPE_REAL, (ofc_sema_type__default.real->kind * 2));
 	}
+	ofc_sema_type__default.complex = ofc_sema_type_create_primitive(
+		OFC_SEMA_TYPE_COMPLEX, 0);
+	ofc_sema_type__default.byte = ofc_sema_type_create_primitive(
+		OFC_SEMA_TYPE_BYTE, 1);
+	ofc_sema_type__default.subroutine = ofc_sema_type__create(
+		OFC_SEMA_TYPE_SUBROUTINE, 0, 0,
+		NULL, NULL,NULL);
+}
 
-	return logical;
+const ofc_sema_type_t* ofc_sema_type_logical_default(void)
+{
+	pthread_once(&ofc_sema_type__default_once,
+		ofc_sema_type__default_init);
+	return ofc_sema_type__default.logical;
 }
 
 const ofc_sema_type_t* ofc_sema_type_integer_default(void)
 {
-	static const ofc_sema_type_t* integer = NULL;
-
-	if (!integer)
-	{
-		integer = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_INTEGER, 0);
-	}
-
-	return integer;
+	pthread_once(&ofc_sema_type__default_once,
+		ofc_sema_type__default_init);
+	return ofc_sema_type__default.integer;
 }
 
 const ofc_sema_type_t* ofc_sema_type_real_default(void)
 {
-	static const ofc_sema_type_t* real = NULL;
-
-	if (!real)
-	{
-		real = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_REAL, 0);
-	}
-
-	return real;
+	pthread_once(&ofc_sema_type__default_once,
+		ofc_sema_type__default_init);
+	return ofc_sema_type__default.real;
 }
 
 const ofc_sema_type_t* ofc_sema_type_double_default(void)
 {
-	static const ofc_sema_type_t* dbl = NULL;
-
-	if (!dbl)
-	{
-		const ofc_sema_type_t* real
-			= ofc_sema_type_real_default();
-		if (!real) return NULL;
-
-		dbl = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_REAL, (real->kind * 2));
-	}
-
-	return dbl;
+	pthread_once(&ofc_sema_type__default_once,
+		ofc_sema_type__default_init);
+	return ofc_sema_type__default.dbl;
 }
 
 const ofc_sema_type_t* ofc_sema_type_complex_default(void)
 {
-	static const ofc_sema_type_t* complex = NULL;
-
-	if (!complex)
-	{
-		complex = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_COMPLEX, 0);
-	}
-
-	return complex;
+	pthread_once(&ofc_sema_type__default_once,
+		ofc_sema_type__default_init);
+	return ofc_sema_type__default.complex;
 }
 
 const ofc_sema_type_t* ofc_sema_type_byte_default(void)
 {
-	static const ofc_sema_type_t* byte = NULL;
-
-	if (!byte)
-	{
-		byte = ofc_sema_type_create_primitive(
-			OFC_SEMA_TYPE_BYTE, 1);
-	}
-
-	return byte;
+	pthread_once(&ofc_sema_type__default_once,
+		ofc_sema_type__default_init);
+	return ofc_sema_type__default.byte;
 }
 
 const ofc_sema_type_t* ofc_sema_type_subroutine(void)
 {
-	static const ofc_sema_type_t* subroutine = NULL;
-
-	if (!subroutine)
-	{
-		subroutine = ofc_sema_type__create(
-			OFC_SEMA_TYPE_SUBROUTINE, 0, 0,
-			NULL, NULL,NULL);
-	}
-
-	return subroutine;
+	pthread_once(&ofc_sema_type__default_once,
+		ofc_sema_type__default_init);
+	return ofc_sema_type__default.subroutine;
 }
 
 
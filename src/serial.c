@@ -0,0 +1,401 @@
+/* Copyright 2015 Codethink Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ofc/serial.h>
+#include <ofc/sparse.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+
+struct ofc_serial_s
+{
+	char*       base;
+	size_t      size, max;
+
+	const char* read;
+	size_t      remain;
+
+	const ofc_sparse_t* sparse;
+
+	unsigned objects, max_objects;
+	void**   object;
+};
+
+
+static ofc_serial_t* ofc_serial__create(void)
+{
+	ofc_serial_t* serial
+		= (ofc_serial_t*)malloc(
+			sizeof(ofc_serial_t));
+	if (!serial) return NULL;
+
+	serial->base = NULL;
+	serial->size = 0;
+	serial->max  = 0;
+
+	serial->read   = NULL;
+	serial->remain = 0;
+
+	serial->sparse = NULL;
+
+	serial->objects     = 0;
+	serial->max_objects = 0;
+	serial->object      = NULL;
+	return serial;
+}
+
+ofc_serial_t* ofc_serial_create(void)
+{
+	return ofc_serial__create();
+}
+
+ofc_serial_t* ofc_serial_create_read(const void* data, size_t size)
+{
+	if (!data && (size > 0))
+		return NULL;
+
+	ofc_serial_t* serial = ofc_serial__create();
+	if (!serial) return NULL;
+
+	serial->read   = (const char*)data;
+	serial->remain = size;
+	return serial;
+}
+
+void ofc_serial_delete(ofc_serial_t* serial)
+{
+	if (!serial)
+		return;
+
+	free(serial->object);
+	free(serial->base);
+	free(serial);
+}
+
+
+const void* ofc_serial_data(const ofc_serial_t* serial, size_t* size)
+{
+	if (!serial)
+		return NULL;
+
+	if (size) *size = serial->size;
+	return serial->base;
+}
+
+bool ofc_serial_end(const ofc_serial_t* serial)
+{
+	return (serial && (serial->remain == 0));
+}
+
+
+const ofc_sparse_t* ofc_serial_sparse_swap(
+	ofc_serial_t* serial, const ofc_sparse_t* sparse)
+{
+	if (!serial)
+		return NULL;
+
+	const ofc_sparse_t* prev = serial->sparse;
+	serial->sparse = sparse;
+	return prev;
+}
+
+const ofc_sparse_t* ofc_serial_sparse(const ofc_serial_t* serial)
+{
+	return (serial ? serial->sparse : NULL);
+}
+
+
+bool ofc_serial_object_find(
+	const ofc_serial_t* serial, const void* object, unsigned* index)
+{
+	if (!serial || !object)
+		return false;
+
+	/* Shared objects are rare enough that a scan is fine. */
+	unsigned i;
+	for (i = 0; i < serial->objects; i++)
+	{
+		if (serial->object[i] == object)
+		{
+			if (index) *index = i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ofc_serial_object_add(ofc_serial_t* serial, void* object)
+{
+	if (!serial || !object)
+		return false;
+
+	if (serial->objects >= serial->max_objects)
+	{
+		unsigned max = (serial->max_objects > 0
+			? (serial->max_objects << 1) : 16);
+		if ((max <= serial->max_objects)
+			|| (max > (UINT_MAX / sizeof(void*))))
+			return false;
+
+		void** nobject = (void**)realloc(
+			serial->object, (sizeof(void*) * max));
+		if (!nobject) return false;
+
+		serial->object      = nobject;
+		serial->max_objects = max;
+	}
+
+	serial->object[serial->objects++] = object;
+	return true;
+}
+
+void* ofc_serial_object(const ofc_serial_t* serial, unsigned index)
+{
+	if (!serial || (index >= serial->objects))
+		return NULL;
+	return serial->object[index];
+}
+
+
+bool ofc_serial_write_data(
+	ofc_serial_t* serial, const void* data, size_t size)
+{
+	if (!serial || serial->read)
+		return false;
+
+	if (size == 0)
+		return true;
+	if (!data)
+		return false;
+
+	if ((serial->max - serial->size) < size)
+	{
+		size_t max = (serial->max > 0 ? serial->max : 4096);
+		while ((max - serial->size) < size)
+		{
+			if ((max << 1) <= max)
+				return false;
+			max <<= 1;
+		}
+
+		char* nbase = (char*)realloc(serial->base, max);
+		if (!nbase) return false;
+
+		serial->base = nbase;
+		serial->max  = max;
+	}
+
+	memcpy(&serial->base[serial->size], data, size);
+	serial->size += size;
+	return true;
+}
+
+bool ofc_serial_write_uint(ofc_serial_t* serial, uintmax_t value)
+{
+	/* Seven bits per byte, the top bit marks that more follow. */
+	uint8_t  buff[(sizeof(uintmax_t) * 8 + 6) / 7];
+	unsigned size = 0;
+
+	do
+	{
+		buff[size] = (value & 0x7F);
+		value >>= 7;
+		if (value != 0)
+			buff[size] |= 0x80;
+		size++;
+	} while (value != 0);
+
+	return ofc_serial_write_data(serial, buff, size);
+}
+
+bool ofc_serial_write_bool(ofc_serial_t* serial, bool value)
+{
+	uint8_t b = (value ? 1 : 0);
+	return ofc_serial_write_data(serial, &b, 1);
+}
+
+bool ofc_serial_write_str_ref(ofc_serial_t* serial, ofc_str_ref_t ref)
+{
+	if (!serial)
+		return false;
+
+	if (!ref.base)
+	{
+		return ((ref.size == 0)
+			&& ofc_serial_write_uint(serial, 0));
+	}
+
+	/* Only references into the current sparse can be written. */
+	const char* strz = ofc_sparse_strz(serial->sparse);
+	unsigned    len  = ofc_sparse_len(serial->sparse);
+	if (!strz || (ref.base < strz)
+		|| ((uintptr_t)(ref.base - strz) > len)
+		|| (ref.size > (len - (unsigned)(ref.base - strz))))
+		return false;
+
+	uintmax_t offset = (uintptr_t)(ref.base - strz);
+	bool      atom   = (ref.atom != OFC_ATOM_NONE);
+	return (ofc_serial_write_uint(serial, (((offset + 1) << 1) | atom))
+		&& ofc_serial_write_uint(serial, ref.size));
+}
+
+bool ofc_serial_write_string(
+	ofc_serial_t* serial, const ofc_string_t* string)
+{
+	if (!string)
+		return ofc_serial_write_uint(serial, 0);
+
+	return (ofc_serial_write_uint(serial, ((uintmax_t)string->size + 1))
+		&& ofc_serial_write_data(serial, string->base, string->size));
+}
+
+bool ofc_serial_write_lang_opts(
+	ofc_serial_t* serial, ofc_lang_opts_t opts)
+{
+	return (ofc_serial_write_uint(serial, opts.form)
+		&& ofc_serial_write_uint(serial, opts.tab_width)
+		&& ofc_serial_write_bool(serial, opts.debug)
+		&& ofc_serial_write_uint(serial, opts.columns)
+		&& ofc_serial_write_bool(serial, opts.case_sensitive));
+}
+
+
+const void* ofc_serial_read_data(ofc_serial_t* serial, size_t size)
+{
+	if (!serial || !serial->read
+		|| (serial->remain < size))
+		return NULL;
+
+	const void* data = serial->read;
+	serial->read   += size;
+	serial->remain -= size;
+	return data;
+}
+
+bool ofc_serial_read_uint(ofc_serial_t* serial, uintmax_t* value)
+{
+	uintmax_t v = 0;
+	unsigned shift;
+	for (shift = 0; shift < (sizeof(uintmax_t) * 8); shift += 7)
+	{
+		const uint8_t* b = ofc_serial_read_data(serial, 1);
+		if (!b) return false;
+
+		v |= ((uintmax_t)(*b & 0x7F) << shift);
+		if ((*b & 0x80) == 0)
+		{
+			if (value) *value = v;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ofc_serial_read_unsigned(ofc_serial_t* serial, unsigned* value)
+{
+	uintmax_t v;
+	if (!ofc_serial_read_uint(serial, &v)
+		|| (v > UINT_MAX))
+		return false;
+
+	if (value) *value = v;
+	return true;
+}
+
+bool ofc_serial_read_bool(ofc_serial_t* serial, bool* value)
+{
+	const uint8_t* b = ofc_serial_read_data(serial, 1);
+	if (!b || (*b > 1)) return false;
+
+	if (value) *value = (*b != 0);
+	return true;
+}
+
+bool ofc_serial_read_str_ref(ofc_serial_t* serial, ofc_str_ref_t* ref)
+{
+	uintmax_t tag;
+	if (!ofc_serial_read_uint(serial, &tag))
+		return false;
+
+	if (tag == 0)
+	{
+		if (ref) *ref = OFC_STR_REF_EMPTY;
+		return true;
+	}
+
+	unsigned size;
+	if (!ofc_serial_read_unsigned(serial, &size))
+		return false;
+
+	const char* strz = ofc_sparse_strz(serial->sparse);
+	unsigned    len  = ofc_sparse_len(serial->sparse);
+
+	uintmax_t offset = ((tag >> 1) - 1);
+	if (!strz || (offset > len)
+		|| (size > (len - offset)))
+		return false;
+
+	if (ref)
+	{
+		*ref = ((tag & 1)
+			? ofc_str_ref_intern(&strz[offset], size)
+			: ofc_str_ref(&strz[offset], size));
+	}
+	return true;
+}
+
+bool ofc_serial_read_lang_opts(
+	ofc_serial_t* serial, ofc_lang_opts_t* opts)
+{
+	unsigned form;
+	ofc_lang_opts_t o;
+	if (!ofc_serial_read_unsigned(serial, &form)
+		|| (form > OFC_LANG_FORM_TAB)
+		|| !ofc_serial_read_unsigned(serial, &o.tab_width)
+		|| !ofc_serial_read_bool(serial, &o.debug)
+		|| !ofc_serial_read_unsigned(serial, &o.columns)
+		|| !ofc_serial_read_bool(serial, &o.case_sensitive))
+		return false;
+	o.form = form;
+
+	if (opts) *opts = o;
+	return true;
+}
+
+bool ofc_serial_read_string(
+	ofc_serial_t* serial, const char** base, unsigned* size)
+{
+	unsigned s;
+	if (!ofc_serial_read_unsigned(serial, &s))
+		return false;
+
+	if (s == 0)
+	{
+		if (base) *base = NULL;
+		if (size) *size = 0;
+		return true;
+	}
+	s -= 1;
+
+	const char* data = ofc_serial_read_data(serial, s);
+	if (!data) return false;
+
+	if (base) *base = data;
+	if (size) *size = s;
+	return true;
+}
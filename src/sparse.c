@@ -27,6 +27,20 @@ typedef struct
 	unsigned    off;
 } ofc_sparse_entry_t;
 
+typedef struct
+{
+	unsigned off, len;
+} ofc_sparse_stmt_t;
+
+/* Maps a range of a child sparse straight to the root sparse, which owns
+   the file, and to the file itself. */
+typedef struct
+{
+	unsigned    off, len;
+	const char* rptr;
+	const char* fptr;
+} ofc_sparse_map_t;
+
 struct ofc_sparse_s
 {
 	ofc_file_t*   file;
@@ -37,8 +51,21 @@ struct ofc_sparse_s
 
 	char* strz;
 
+	/* Composed from every parent when a child sparse is locked. */
+	unsigned          map_count;
+	ofc_sparse_map_t* map;
+
+	/* Offset of the start of each line, only kept by the root. */
+	unsigned  line_count;
+	unsigned* line;
+
 	ofc_label_table_t* labels;
 
+	/* Prep marks where each statement starts in the root, when locked
+	   these become the range of each statement in this sparse. */
+	unsigned           stmt_count, stmt_max;
+	ofc_sparse_stmt_t* stmt;
+
 	unsigned ref;
 };
 
@@ -70,6 +97,16 @@ ofc_sparse_t* ofc_sparse__create(
 
 	sparse->strz = NULL;
 
+	sparse->map_count = 0;
+	sparse->map       = NULL;
+
+	sparse->line_count = 0;
+	sparse->line       = NULL;
+
+	sparse->stmt_count = 0;
+	sparse->stmt_max   = 0;
+	sparse->stmt       = NULL;
+
 	sparse->ref = 0;
 
 	return sparse;
@@ -109,10 +146,12 @@ bool ofc_sparse_reference(ofc_sparse_t* sparse)
 	if (!sparse)
 		return false;
 
-	unsigned nref = sparse->ref + 1;
-	if (nref == 0) return false;
-
-	sparse->ref += 1;
+	/* References may be taken and released from any thread. */
+	if (__atomic_add_fetch(&sparse->ref, 1, __ATOMIC_RELAXED) == 0)
+	{
+		__atomic_sub_fetch(&sparse->ref, 1, __ATOMIC_RELAXED);
+		return false;
+	}
 	return true;
 }
 
@@ -121,17 +160,18 @@ void ofc_sparse_delete(ofc_sparse_t* sparse)
 	if (!sparse)
 		return;
 
-	if (sparse->ref > 0)
-	{
-		sparse->ref -= 1;
+	/* Only the last release sees the count already at zero. */
+	if (__atomic_fetch_sub(&sparse->ref, 1, __ATOMIC_ACQ_REL) > 0)
 		return;
-	}
 
 	ofc_sparse_delete(sparse->parent);
 	ofc_file_delete(sparse->file);
 
 	ofc_label_table_delete(sparse->labels);
 
+	free(sparse->stmt);
+	free(sparse->line);
+	free(sparse->map);
 	free(sparse->strz);
 	free(sparse->entry);
 	free(sparse);
@@ -182,6 +222,49 @@ bool ofc_sparse_append_strn(
 	return true;
 }
 
+bool ofc_sparse_reserve(ofc_sparse_t* sparse, unsigned count)
+{
+	if (!sparse || sparse->strz)
+		return false;
+
+	if (count <= sparse->max_count)
+		return true;
+
+	ofc_sparse_entry_t* nentry = (ofc_sparse_entry_t*)realloc(sparse->entry,
+			(sizeof(ofc_sparse_entry_t) * count));
+	if (!nentry) return false;
+	sparse->entry = nentry;
+	sparse->max_count = count;
+	return true;
+}
+
+static bool ofc_sparse__compose(ofc_sparse_t* sparse);
+static void ofc_sparse__stmts(ofc_sparse_t* sparse);
+
+static void ofc_sparse__lines(ofc_sparse_t* sparse)
+{
+	unsigned count = 1;
+	unsigned i;
+	for (i = 0; i < sparse->len; i++)
+	{
+		if (ofc_is_vspace(sparse->strz[i]))
+			count++;
+	}
+
+	sparse->line = (unsigned*)malloc(
+		sizeof(unsigned) * count);
+	if (!sparse->line) return;
+
+	sparse->line[0] = 0;
+	unsigned l;
+	for (i = 0, l = 1; i < sparse->len; i++)
+	{
+		if (ofc_is_vspace(sparse->strz[i]))
+			sparse->line[l++] = (i + 1);
+	}
+	sparse->line_count = count;
+}
+
 void ofc_sparse_lock(ofc_sparse_t* sparse)
 {
 	if (!sparse || sparse->strz)
@@ -194,6 +277,16 @@ void ofc_sparse_lock(ofc_sparse_t* sparse)
 	for (i = 0, j = 0; i < sparse->count; j += sparse->entry[i++].len)
 		memcpy(&sparse->strz[j], sparse->entry[i].ptr, sparse->entry[i].len);
 	sparse->strz[j] = '\0';
+
+	/* Diagnostics find the start of line in the root, which is
+	   the only sparse which still has line breaks. */
+	if (!sparse->parent)
+		ofc_sparse__lines(sparse);
+
+	/* Lookups fall back to walking the parents if this fails. */
+	ofc_sparse__compose(sparse);
+
+	ofc_sparse__stmts(sparse);
 }
 
 const char* ofc_sparse_strz(const ofc_sparse_t* sparse)
@@ -247,6 +340,154 @@ static bool ofc_sparse__ptr(
 	return true;
 }
 
+static bool ofc_sparse__map(
+	const ofc_sparse_t* sparse, const char* ptr,
+	ofc_sparse_map_t* map, unsigned* offset,
+	const ofc_sparse_map_t** prev)
+{
+	if (!sparse || !sparse->strz
+		|| !sparse->map || !ptr)
+		return false;
+
+	uintptr_t off = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
+	if (off > sparse->len)
+		return false;
+
+	unsigned lo = 0, hi = sparse->map_count;
+	if (off == sparse->len)
+	{
+		/* Pointing at end of sparse. */
+		lo = (sparse->map_count - 1);
+	}
+	else
+	{
+		while ((hi - lo) > 1)
+		{
+			unsigned mid = lo + ((hi - lo) / 2);
+			if (sparse->map[mid].off <= off)
+				lo = mid;
+			else
+				hi = mid;
+		}
+	}
+
+	off -= sparse->map[lo].off;
+
+	if (prev  ) *prev   = ((off == 0) && (lo > 0) ? &sparse->map[lo - 1] : NULL);
+	if (map   ) *map    = sparse->map[lo];
+	if (offset) *offset = off;
+	return true;
+}
+
+static bool ofc_sparse__compose(ofc_sparse_t* sparse)
+{
+	const ofc_sparse_t* parent = sparse->parent;
+	if (!parent || (sparse->count == 0))
+		return false;
+
+	/* Without a map the parent must be the root,
+	   whose entries already point into the file. */
+	if (!parent->map && parent->parent)
+		return false;
+
+	unsigned size = sparse->count + (parent->map
+		? parent->map_count : parent->count);
+	ofc_sparse_map_t* map = (ofc_sparse_map_t*)malloc(
+		sizeof(ofc_sparse_map_t) * size);
+	if (!map) return false;
+
+	unsigned count = 0;
+	unsigned i;
+	for (i = 0; i < sparse->count; i++)
+	{
+		const char* ptr  = sparse->entry[i].ptr;
+		unsigned    off  = sparse->entry[i].off;
+		unsigned    left = sparse->entry[i].len;
+
+		/* An entry may span several ranges of the parent,
+		   so it's split wherever they end. */
+		while (left > 0)
+		{
+			unsigned    avail;
+			const char* rptr;
+			const char* fptr;
+
+			unsigned poff;
+			if (parent->map)
+			{
+				ofc_sparse_map_t pmap;
+				if (!ofc_sparse__map(parent, ptr,
+					&pmap, &poff, NULL))
+					break;
+
+				avail = pmap.len - poff;
+				rptr  = &pmap.rptr[poff];
+				fptr  = &pmap.fptr[poff];
+			}
+			else
+			{
+				ofc_sparse_entry_t pentry;
+				if (!ofc_sparse__ptr(parent, ptr,
+					&pentry, &poff, NULL))
+					break;
+
+				avail = pentry.len - poff;
+				rptr  = ptr;
+				fptr  = &pentry.ptr[poff];
+			}
+
+			if (avail == 0)
+				break;
+
+			if (count >= size)
+			{
+				unsigned nsize = (size << 1);
+				ofc_sparse_map_t* nmap = (ofc_sparse_map_t*)realloc(
+					map, (sizeof(ofc_sparse_map_t) * nsize));
+				if (!nmap)
+				{
+					free(map);
+					return false;
+				}
+				map  = nmap;
+				size = nsize;
+			}
+
+			unsigned len = (left < avail ? left : avail);
+			map[count].off  = off;
+			map[count].len  = len;
+			map[count].rptr = rptr;
+			map[count].fptr = fptr;
+			count++;
+
+			ptr  += len;
+			off  += len;
+			left -= len;
+		}
+
+		if (left > 0)
+		{
+			free(map);
+			return false;
+		}
+	}
+
+	sparse->map       = map;
+	sparse->map_count = count;
+	return true;
+}
+
+static const ofc_sparse_t* ofc_sparse__root(
+	const ofc_sparse_t* sparse)
+{
+	if (!sparse)
+		return NULL;
+
+	while (sparse->parent)
+		sparse = sparse->parent;
+	return sparse;
+}
+
 static const ofc_file_t* ofc_sparse__file(
 	const ofc_sparse_t* sparse)
 {
@@ -285,6 +526,26 @@ bool ofc_sparse_label_find(
 	if (!sparse->parent)
 		return false;
 
+	if (sparse->map)
+	{
+		/* Labels only exist in the root, which the map points into. */
+		ofc_sparse_map_t map;
+		const ofc_sparse_map_t* mprev = NULL;
+		if (!ofc_sparse__map(sparse, ptr,
+			&map, &offset, &mprev))
+			return false;
+
+		const ofc_sparse_t* root
+			= ofc_sparse__root(sparse);
+
+		if (mprev && ofc_sparse_label_find(
+			root, &mprev->rptr[mprev->len], number))
+			return true;
+
+		return ofc_sparse_label_find(
+			root, &map.rptr[offset], number);
+	}
+
 	ofc_sparse_entry_t entry;
 	ofc_sparse_entry_t* prev = NULL;
 
@@ -303,6 +564,193 @@ bool ofc_sparse_label_find(
 }
 
 
+bool ofc_sparse_stmt_add(
+	ofc_sparse_t* sparse, unsigned offset)
+{
+	if (!sparse || sparse->strz || sparse->parent)
+		return false;
+
+	if ((sparse->stmt_count > 0)
+		&& (offset < sparse->stmt[sparse->stmt_count - 1].off))
+		return false;
+
+	if (sparse->stmt_count >= sparse->stmt_max)
+	{
+		unsigned nmax = (sparse->stmt_max << 1);
+		if (nmax == 0) nmax = 64;
+		if (nmax <= sparse->stmt_max)
+			return false;
+
+		ofc_sparse_stmt_t* nstmt
+			= (ofc_sparse_stmt_t*)realloc(sparse->stmt,
+				(sizeof(ofc_sparse_stmt_t) * nmax));
+		if (!nstmt) return false;
+		sparse->stmt     = nstmt;
+		sparse->stmt_max = nmax;
+	}
+
+	sparse->stmt[sparse->stmt_count].off = offset;
+	sparse->stmt[sparse->stmt_count].len = 0;
+	sparse->stmt_count++;
+	return true;
+}
+
+static bool ofc_sparse__stmts_space(char c)
+{
+	return (ofc_is_hspace(c) || ofc_is_vspace(c));
+}
+
+/* Each mark runs up to the terminator before the next one, spaces are
+   trimmed since a label on a blank line leaves an extra line break,
+   and empty statements are dropped. */
+static void ofc_sparse__stmts_root(ofc_sparse_t* sparse)
+{
+	unsigned count = 0;
+	unsigned i;
+	for (i = 0; i < sparse->stmt_count; i++)
+	{
+		unsigned start = sparse->stmt[i].off;
+		unsigned end   = sparse->len;
+		if ((i + 1) < sparse->stmt_count)
+		{
+			unsigned next = sparse->stmt[i + 1].off;
+			if (next > start) end = (next - 1);
+			else end = start;
+		}
+
+		if (start > sparse->len)
+			break;
+		if (end > sparse->len)
+			end = sparse->len;
+
+		for (; (start < end) && ofc_sparse__stmts_space(sparse->strz[start]); start++);
+		for (; (end > start) && ofc_sparse__stmts_space(sparse->strz[end - 1]); end--);
+		if (start >= end)
+			continue;
+
+		sparse->stmt[count].off = start;
+		sparse->stmt[count].len = (end - start);
+		count++;
+	}
+	sparse->stmt_count = count;
+}
+
+/* Returns the offset in sparse of the first character which came from
+   at or after offset x of the parent, calls must be in order of x. */
+static unsigned ofc_sparse__stmts_offset(
+	const ofc_sparse_t* sparse, unsigned x, unsigned* e)
+{
+	const char* base = sparse->parent->strz;
+	for (; *e < sparse->count; (*e)++)
+	{
+		const ofc_sparse_entry_t* entry = &sparse->entry[*e];
+		unsigned p = (entry->ptr - base);
+		if (x < p)
+			return entry->off;
+		if ((x - p) < entry->len)
+			return (entry->off + (x - p));
+	}
+	return sparse->len;
+}
+
+static void ofc_sparse__stmts_child(ofc_sparse_t* sparse)
+{
+	const ofc_sparse_t* parent = sparse->parent;
+	if (!parent->strz || (parent->stmt_count == 0))
+		return;
+
+	/* A child is built in order from its parent's text. */
+	unsigned i;
+	for (i = 0; i < sparse->count; i++)
+	{
+		const char* ptr = sparse->entry[i].ptr;
+		if ((ptr < parent->strz)
+			|| ((unsigned)(ptr - parent->strz) > parent->len)
+			|| ((i > 0) && (ptr < sparse->entry[i - 1].ptr)))
+			return;
+	}
+
+	sparse->stmt = (ofc_sparse_stmt_t*)malloc(
+		sizeof(ofc_sparse_stmt_t) * parent->stmt_count);
+	if (!sparse->stmt) return;
+	sparse->stmt_max = parent->stmt_count;
+
+	unsigned e = 0;
+	unsigned count = 0;
+	for (i = 0; i < parent->stmt_count; i++)
+	{
+		const ofc_sparse_stmt_t* pstmt = &parent->stmt[i];
+		unsigned start = ofc_sparse__stmts_offset(
+			sparse, pstmt->off, &e);
+		unsigned end = ofc_sparse__stmts_offset(
+			sparse, (pstmt->off + pstmt->len), &e);
+		if (end <= start)
+			continue;
+
+		sparse->stmt[count].off = start;
+		sparse->stmt[count].len = (end - start);
+		count++;
+	}
+	sparse->stmt_count = count;
+}
+
+static void ofc_sparse__stmts(ofc_sparse_t* sparse)
+{
+	if (sparse->parent)
+		ofc_sparse__stmts_child(sparse);
+	else
+		ofc_sparse__stmts_root(sparse);
+}
+
+unsigned ofc_sparse_stmt_count(const ofc_sparse_t* sparse)
+{
+	if (!sparse || !sparse->strz)
+		return 0;
+	return sparse->stmt_count;
+}
+
+bool ofc_sparse_stmt(
+	const ofc_sparse_t* sparse, unsigned index,
+	unsigned* offset, unsigned* len)
+{
+	if (!sparse || !sparse->strz
+		|| (index >= sparse->stmt_count))
+		return false;
+
+	if (offset) *offset = sparse->stmt[index].off;
+	if (len   ) *len    = sparse->stmt[index].len;
+	return true;
+}
+
+bool ofc_sparse_stmt_find(
+	const ofc_sparse_t* sparse, const char* ptr, unsigned* index)
+{
+	if (!sparse || !sparse->strz || !ptr
+		|| (ptr < sparse->strz))
+		return false;
+
+	uintptr_t off = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
+	if (off > sparse->len)
+		return false;
+
+	/* Find the first statement which ends after ptr. */
+	unsigned lo = 0;
+	unsigned hi = sparse->stmt_count;
+	while (lo < hi)
+	{
+		unsigned mid = lo + ((hi - lo) / 2);
+		const ofc_sparse_stmt_t* stmt = &sparse->stmt[mid];
+		if ((stmt->off + stmt->len) <= off)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (index) *index = lo;
+	return true;
+}
+
+
 bool ofc_sparse_sequential(
 	const ofc_sparse_t* sparse, const char* ptr, unsigned size)
 {
@@ -320,6 +768,23 @@ bool ofc_sparse_sequential(
 	return ((offset + size) <= entry.len);
 }
 
+unsigned ofc_sparse_sequential_len(
+	const ofc_sparse_t* sparse, const char* ptr)
+{
+	if (!sparse || !ptr)
+		return 0;
+
+	ofc_sparse_entry_t entry;
+	unsigned offset;
+
+	if (!ofc_sparse__ptr(
+		sparse, ptr,
+		&entry, &offset, NULL))
+		return 0;
+
+	return (offset < entry.len ? (entry.len - offset) : 0);
+}
+
 const char* ofc_sparse_parent_pointer(
 	const ofc_sparse_t* sparse, const char* ptr)
 {
@@ -355,6 +820,14 @@ const char* ofc_sparse_get_include(
 		ofc_sparse__file(sparse));
 }
 
+ofc_file_t* ofc_sparse_get_file(
+	const ofc_sparse_t* sparse)
+{
+	while (sparse && !sparse->file)
+		sparse = sparse->parent;
+	return (sparse ? sparse->file : NULL);
+}
+
 char* ofc_sparse_include_path(
 	const ofc_sparse_t* sparse, const char* path)
 {
@@ -367,6 +840,177 @@ char* ofc_sparse_include_path(
 
 
 
+bool ofc_sparse_serialize(
+	ofc_serial_t* serial, const ofc_sparse_t* sparse)
+{
+	if (!sparse || !sparse->strz)
+		return false;
+
+	/* Parents are written first, as they're rebuilt first. */
+	if (!ofc_serial_write_bool(serial, (sparse->parent != NULL))
+		|| (sparse->parent && !ofc_sparse_serialize(
+			serial, sparse->parent)))
+		return false;
+
+	const char* base;
+	unsigned    size;
+	if (sparse->parent)
+	{
+		base = sparse->parent->strz;
+		size = sparse->parent->len;
+	}
+	else
+	{
+		base = ofc_file_get_strz(sparse->file);
+		size = ofc_file_get_size(sparse->file);
+	}
+
+	if (!ofc_serial_write_uint(serial, sparse->count))
+		return false;
+
+	unsigned i;
+	for (i = 0; i < sparse->count; i++)
+	{
+		const ofc_sparse_entry_t* entry
+			= &sparse->entry[i];
+		if (!base || (entry->ptr < base)
+			|| ((uintptr_t)(entry->ptr - base) > size)
+			|| (entry->len > (size - (unsigned)(entry->ptr - base))))
+			return false;
+
+		if (!ofc_serial_write_uint(serial, (entry->ptr - base))
+			|| !ofc_serial_write_uint(serial, entry->len))
+			return false;
+	}
+
+	if (!ofc_label_table_serialize(
+		serial, sparse->labels))
+		return false;
+
+	/* Only the root's index is kept, children derive theirs on lock. */
+	unsigned stmt_count = (sparse->parent ? 0 : sparse->stmt_count);
+	if (!ofc_serial_write_uint(serial, stmt_count))
+		return false;
+	for (i = 0; i < stmt_count; i++)
+	{
+		if (!ofc_serial_write_uint(serial, sparse->stmt[i].off)
+			|| !ofc_serial_write_uint(serial, sparse->stmt[i].len))
+			return false;
+	}
+	return true;
+}
+
+ofc_sparse_t* ofc_sparse_deserialize(
+	ofc_serial_t* serial, ofc_file_t* file)
+{
+	bool has_parent;
+	if (!ofc_serial_read_bool(serial, &has_parent))
+		return NULL;
+
+	ofc_sparse_t* sparse;
+	const char*   base;
+	unsigned      size;
+	if (has_parent)
+	{
+		ofc_sparse_t* parent
+			= ofc_sparse_deserialize(serial, file);
+		sparse = ofc_sparse_create_child(parent);
+		if (sparse)
+		{
+			base = parent->strz;
+			size = parent->len;
+		}
+		ofc_sparse_delete(parent);
+		if (!sparse) return NULL;
+	}
+	else
+	{
+		sparse = ofc_sparse_create_file(file);
+		if (!sparse) return NULL;
+
+		base = ofc_file_get_strz(file);
+		size = ofc_file_get_size(file);
+	}
+
+	unsigned count;
+	if (!base || !ofc_serial_read_unsigned(serial, &count)
+		|| (count > size) || !ofc_sparse_reserve(sparse, count))
+	{
+		ofc_sparse_delete(sparse);
+		return NULL;
+	}
+
+	unsigned i;
+	for (i = 0; i < count; i++)
+	{
+		unsigned off, len;
+		if (!ofc_serial_read_unsigned(serial, &off)
+			|| !ofc_serial_read_unsigned(serial, &len)
+			|| (off > size) || (len > (size - off))
+			|| !ofc_sparse_append_strn(sparse, &base[off], len))
+		{
+			ofc_sparse_delete(sparse);
+			return NULL;
+		}
+	}
+
+	if (!ofc_label_table_deserialize(
+		serial, sparse->labels))
+	{
+		ofc_sparse_delete(sparse);
+		return NULL;
+	}
+
+	ofc_sparse_lock(sparse);
+	if (!sparse->strz)
+	{
+		ofc_sparse_delete(sparse);
+		return NULL;
+	}
+
+	unsigned stmt_count;
+	if (!ofc_serial_read_unsigned(serial, &stmt_count)
+		|| (stmt_count > sparse->len)
+		|| (has_parent && (stmt_count > 0)))
+	{
+		ofc_sparse_delete(sparse);
+		return NULL;
+	}
+
+	if (stmt_count > 0)
+	{
+		sparse->stmt = (ofc_sparse_stmt_t*)malloc(
+			sizeof(ofc_sparse_stmt_t) * stmt_count);
+		if (!sparse->stmt)
+		{
+			ofc_sparse_delete(sparse);
+			return NULL;
+		}
+		sparse->stmt_max = stmt_count;
+	}
+
+	unsigned end = 0;
+	for (i = 0; i < stmt_count; i++)
+	{
+		ofc_sparse_stmt_t stmt;
+		if (!ofc_serial_read_unsigned(serial, &stmt.off)
+			|| !ofc_serial_read_unsigned(serial, &stmt.len)
+			|| (stmt.off < end) || (stmt.len == 0)
+			|| (stmt.off > sparse->len)
+			|| (stmt.len > (sparse->len - stmt.off)))
+		{
+			ofc_sparse_delete(sparse);
+			return NULL;
+		}
+		sparse->stmt[sparse->stmt_count++] = stmt;
+		end = (stmt.off + stmt.len);
+	}
+
+	return sparse;
+}
+
+
+
 static const char* ofc_sparse__file_pointer(
 	const ofc_sparse_t* sparse, const char* ptr,
 	const char** sol)
@@ -374,6 +1018,25 @@ static const char* ofc_sparse__file_pointer(
 	ofc_sparse_entry_t entry;
 	unsigned offset;
 
+	if (sparse && sparse->map)
+	{
+		ofc_sparse_map_t map;
+		if (!ofc_sparse__map(
+			sparse, ptr, &map, &offset, NULL))
+			return NULL;
+
+		/* The end of the sparse and the start of line are
+		   resolved by the root, as they would be by walking. */
+		if (sol || (offset >= map.len))
+		{
+			return ofc_sparse__file_pointer(
+				ofc_sparse__root(sparse),
+				&map.rptr[offset], sol);
+		}
+
+		return &map.fptr[offset];
+	}
+
 	if (!ofc_sparse__ptr(
 		sparse, ptr,
 		&entry, &offset, NULL))
@@ -394,11 +1057,28 @@ static const char* ofc_sparse__file_pointer(
 	if (sol)
 	{
 		const char* s = sparse->strz;
-		const char* p;
-		for (p = sparse->strz; p < ptr; p++)
+		if (sparse->line)
+		{
+			unsigned off = ((uintptr_t)ptr - (uintptr_t)sparse->strz);
+			unsigned lo = 0, hi = sparse->line_count;
+			while ((hi - lo) > 1)
+			{
+				unsigned mid = lo + ((hi - lo) / 2);
+				if (sparse->line[mid] <= off)
+					lo = mid;
+				else
+					hi = mid;
+			}
+			s = &sparse->strz[sparse->line[lo]];
+		}
+		else
 		{
-			if (ofc_is_vspace(*p))
-				s = &p[1];
+			const char* p;
+			for (p = sparse->strz; p < ptr; p++)
+			{
+				if (ofc_is_vspace(*p))
+					s = &p[1];
+			}
 		}
 
 		ofc_sparse_entry_t sol_entry;
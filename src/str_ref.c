@@ -24,27 +24,44 @@ bool ofc_str_ref_empty(const ofc_str_ref_t ref)
 	return (ref.size == 0);
 }
 
-uint8_t ofc_str_ref_hash(const ofc_str_ref_t ref)
+/* FNV-1a, the case insensitive variant folds to upper case as it goes
+   so that it agrees with ofc_str_ref_equal_ci. */
+#define OFC_STR_REF__FNV_BASIS 2166136261U
+#define OFC_STR_REF__FNV_PRIME 16777619U
+
+unsigned ofc_str_ref_hash(const ofc_str_ref_t ref)
 {
+	if (ref.atom != OFC_ATOM_NONE)
+		return ofc_atom_hash(ref.atom);
+
 	if (!ref.base)
 		return 0;
 
-	uint8_t hash;
+	unsigned hash = OFC_STR_REF__FNV_BASIS;
 	unsigned i;
-	for (i = 0, hash = 0; i < ref.size; i++)
-		hash += ref.base[i];
+	for (i = 0; i < ref.size; i++)
+	{
+		hash ^= (unsigned char)ref.base[i];
+		hash *= OFC_STR_REF__FNV_PRIME;
+	}
 	return hash;
 }
 
-uint8_t ofc_str_ref_hash_ci(const ofc_str_ref_t ref)
+unsigned ofc_str_ref_hash_ci(const ofc_str_ref_t ref)
 {
+	if (ref.atom != OFC_ATOM_NONE)
+		return ofc_atom_hash_ci(ref.atom);
+
 	if (!ref.base)
 		return 0;
 
-	uint8_t hash;
+	unsigned hash = OFC_STR_REF__FNV_BASIS;
 	unsigned i;
-	for (i = 0, hash = 0; i < ref.size; i++)
-		hash += toupper(ref.base[i]);
+	for (i = 0; i < ref.size; i++)
+	{
+		hash ^= (unsigned char)toupper(ref.base[i]);
+		hash *= OFC_STR_REF__FNV_PRIME;
+	}
 	return hash;
 }
 
@@ -69,6 +86,10 @@ ofc_str_ref_t ofc_str_ref_bridge(
 
 bool ofc_str_ref_equal(const ofc_str_ref_t a, const ofc_str_ref_t b)
 {
+	if ((a.atom != OFC_ATOM_NONE)
+		&& (b.atom != OFC_ATOM_NONE))
+		return (a.atom == b.atom);
+
 	if (a.size != b.size)
 		return false;
 
@@ -80,6 +101,10 @@ bool ofc_str_ref_equal(const ofc_str_ref_t a, const ofc_str_ref_t b)
 
 bool ofc_str_ref_equal_ci(const ofc_str_ref_t a, const ofc_str_ref_t b)
 {
+	if ((a.atom != OFC_ATOM_NONE)
+		&& (b.atom != OFC_ATOM_NONE))
+		return (ofc_atom_fold(a.atom) == ofc_atom_fold(b.atom));
+
 	if (a.size != b.size)
 		return false;
 